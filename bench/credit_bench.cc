@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "credit_calc.h"
+#include "credit_portfolio.h"
+
+using namespace s21;
+
+namespace {
+/**
+ * @brief Measures a credit payment plan.
+ *
+ * The first argument selects the credit type and the second one is the term
+ * in months.
+ */
+void BM_CreditCalculate(benchmark::State& state) {
+  CreditCalc::CreditInfo info{
+      1000000.0, 12.5, static_cast<int>(state.range(1)),
+      state.range(0) ? CreditCalc::CreditType::kDifferentiated
+                     : CreditCalc::CreditType::kAnnuity};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CreditCalc::Calculate(info));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/**
+ * @brief Measures the totals of a credit without its payment plan.
+ *
+ * The arguments are the same as for BM_CreditCalculate.
+ */
+void BM_CreditSummarize(benchmark::State& state) {
+  CreditCalc::CreditInfo info{
+      1000000.0, 12.5, static_cast<int>(state.range(1)),
+      state.range(0) ? CreditCalc::CreditType::kDifferentiated
+                     : CreditCalc::CreditType::kAnnuity};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CreditCalc::Summarize(info));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/**
+ * @brief Columns of a random portfolio of both credit types.
+ */
+struct Portfolio {
+  std::vector<double> sums;
+  std::vector<double> rates;
+  std::vector<int> terms;
+  std::vector<CreditCalc::CreditType> types;
+
+  explicit Portfolio(std::size_t size) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> sum(1000.0, 5000000.0);
+    std::uniform_real_distribution<double> rate(1.0, 30.0);
+    std::uniform_int_distribution<int> term(12, 360);
+    std::bernoulli_distribution differentiated(0.3);
+    for (std::size_t i = 0; i < size; ++i) {
+      sums.push_back(std::round(sum(generator) * 100.0) / 100.0);
+      rates.push_back(std::round(rate(generator) * 100.0) / 100.0);
+      terms.push_back(term(generator));
+      types.push_back(differentiated(generator)
+                          ? CreditCalc::CreditType::kDifferentiated
+                          : CreditCalc::CreditType::kAnnuity);
+    }
+  }
+
+  CreditPortfolio::Loans GetLoans() const {
+    return {sums.data(), rates.data(), terms.data(), types.data(),
+            sums.size()};
+  }
+};
+
+/**
+ * @brief Measures the totals of a portfolio of loans.
+ *
+ * The first argument is the number of loans and the second one the number of
+ * threads, 0 for all hardware threads.
+ */
+void BM_PortfolioAggregate(benchmark::State& state) {
+  Portfolio portfolio(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CreditPortfolio::Aggregate(
+        portfolio.GetLoans(), static_cast<std::size_t>(state.range(1))));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Measures the payment plans of a portfolio with one PaymentPlan per
+ * loan, as a baseline for BM_PortfolioCalculate.
+ */
+void BM_PortfolioCalculateLoop(benchmark::State& state) {
+  Portfolio portfolio(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < portfolio.sums.size(); ++i) {
+      benchmark::DoNotOptimize(
+          CreditCalc::Calculate({portfolio.sums[i], portfolio.rates[i],
+                                 portfolio.terms[i], portfolio.types[i]}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Measures the payment plans of a portfolio written to flat columns.
+ *
+ * The arguments are the same as for BM_PortfolioAggregate.
+ */
+void BM_PortfolioCalculate(benchmark::State& state) {
+  Portfolio portfolio(static_cast<std::size_t>(state.range(0)));
+  CreditPortfolio::Loans loans = portfolio.GetLoans();
+  std::vector<std::size_t> offsets = CreditPortfolio::GetOffsets(loans);
+  std::vector<double> payments(offsets.back()), principals(offsets.back()),
+      interests(offsets.back()), balances(offsets.back());
+  for (auto _ : state) {
+    CreditPortfolio::Calculate(loans, offsets.data(),
+                               {payments.data(), principals.data(),
+                                interests.data(), balances.data()},
+                               static_cast<std::size_t>(state.range(1)));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_CreditCalculate)
+    ->ArgNames({"differentiated", "term"})
+    ->ArgsProduct({{0, 1}, {12, 60, 120, 360, 600}});
+BENCHMARK(BM_CreditSummarize)
+    ->ArgNames({"differentiated", "term"})
+    ->ArgsProduct({{0, 1}, {12, 60, 120, 360, 600}});
+BENCHMARK(BM_PortfolioAggregate)
+    ->ArgNames({"loans", "threads"})
+    ->ArgsProduct({{1000000, 10000000}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PortfolioCalculateLoop)
+    ->ArgNames({"loans"})
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PortfolioCalculate)
+    ->ArgNames({"loans", "threads"})
+    ->ArgsProduct({{10000}, {1, 0}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+
+#include "deposit_calc.h"
+
+using namespace s21;
+
+namespace {
+constexpr int kTerm = 24;
+
+/**
+ * @brief Generates transactions spread over the two years of the deposit.
+ *
+ * The transactions cycle through all regularities, so recurring ones are
+ * expanded by the calculator as well.
+ */
+std::vector<DepositCalc::Transaction> GenerateTransactions(int count,
+                                                           double sum) {
+  std::vector<DepositCalc::Transaction> transactions;
+  transactions.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    Date date(2024 + i / 336 % 2, 1 + i / 28 % 12, 1 + i % 28);
+    transactions.push_back(
+        {static_cast<DepositCalc::Regularity>(i % 6), date, sum});
+  }
+  return transactions;
+}
+
+/**
+ * @brief Measures a deposit payment plan.
+ *
+ * The first argument selects the payment period and the second one is the
+ * number of replenishments and of withdrawals.
+ */
+void BM_DepositCalculate(benchmark::State& state) {
+  DepositCalc::DepositInfo info;
+  info.sum = 1000000.0;
+  info.term = kTerm;
+  info.date = Date(2024, 1, 1);
+  info.rate = 8.5;
+  info.period = static_cast<DepositCalc::PaymentPeriod>(state.range(0));
+  info.capitalize = true;
+  info.replenishments =
+      GenerateTransactions(static_cast<int>(state.range(1)), 1000.0);
+  info.withdrawals =
+      GenerateTransactions(static_cast<int>(state.range(1)), 100.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DepositCalc::Calculate(info));
+  }
+}
+
+/**
+ * @brief Measures the total interest of a daily deposit.
+ *
+ * The argument is the term in years. With the first argument 0 the plan is
+ * built by Calculate, and with 1 its rows are summed from a PlanGenerator.
+ */
+void BM_DepositTotalInterest(benchmark::State& state) {
+  DepositCalc::DepositInfo info;
+  info.sum = 1000000.0;
+  info.term = static_cast<int>(state.range(1)) * 12;
+  info.date = Date(2024, 1, 1);
+  info.rate = 8.5;
+  info.period = DepositCalc::PaymentPeriod::kDaily;
+  info.capitalize = true;
+  for (auto _ : state) {
+    double interest = 0.0;
+    if (state.range(0)) {
+      DepositCalc::PlanGenerator generator(info);
+      DepositCalc::Row row;
+      while (generator.Next(row)) {
+        interest += row.interest;
+      }
+    } else {
+      DepositCalc::PaymentPlan plan = DepositCalc::Calculate(info);
+      interest = std::accumulate(plan.interests.begin(),
+                                 plan.interests.end(), 0.0);
+    }
+    benchmark::DoNotOptimize(interest);
+  }
+}
+}  // namespace
+
+BENCHMARK(BM_DepositCalculate)
+    ->ArgNames({"period", "transactions"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, 6, 1), {0, 16, 256}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DepositTotalInterest)
+    ->ArgNames({"stream", "years"})
+    ->ArgsProduct({{0, 1}, {30}})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "jit_program.h"
+#include "math_calc.h"
+
+using namespace s21;
+
+namespace {
+const char* const kExpressions[] = {
+    "x",
+    "x ^ 2 + 3x - 1",
+    "(x - 1) / (x + 1) * (x - 2) / (x + 2) - x * x * x",
+    "2xcos(3x) + -x ^ 2 mod 7",
+    "sqrt(x) + sin(x) * cos(x) - ln(x + 1)",
+};
+
+constexpr int kExpressionCount =
+    static_cast<int>(sizeof(kExpressions) / sizeof(kExpressions[0]));
+
+constexpr std::size_t kPoints = 1 << 16;
+
+/**
+ * @brief Returns the points of [0, 1) the calculations are measured on.
+ */
+std::vector<double> Points() {
+  std::vector<double> x(kPoints);
+  for (std::size_t i = 0; i < kPoints; ++i) {
+    x[i] = static_cast<double>(i) / kPoints;
+  }
+  return x;
+}
+
+/**
+ * @brief Measures evaluation of an expression by an instance of MathCalc,
+ * point by point.
+ */
+void BM_InterpreterCalculate(benchmark::State& state) {
+  const char* expression = kExpressions[state.range(0)];
+  state.SetLabel(expression);
+  MathCalc interpreter(expression);
+  std::vector<double> x = Points();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (double point : x) {
+      sum += interpreter.Calculate(point);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+
+/**
+ * @brief Measures evaluation of an expression by a JitProgram, point by
+ * point.
+ *
+ * The label tells if the program falls back to the interpreter.
+ */
+void BM_JitCalculate(benchmark::State& state) {
+  const char* expression = kExpressions[state.range(0)];
+  JitProgram jit(MathCalc::Compile(expression));
+  state.SetLabel(std::string(expression) +
+                 (jit.IsNative() ? "" : " (interpreter fallback)"));
+  std::vector<double> x = Points();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (double point : x) {
+      sum += jit.Calculate(point);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+
+/**
+ * @brief Measures evaluation of an expression by a JitProgram over an array
+ * of points.
+ */
+void BM_JitCalculateArray(benchmark::State& state) {
+  const char* expression = kExpressions[state.range(0)];
+  JitProgram jit(MathCalc::Compile(expression));
+  state.SetLabel(std::string(expression) +
+                 (jit.IsNative() ? "" : " (interpreter fallback)"));
+  std::vector<double> x = Points();
+  std::vector<double> y(kPoints);
+  for (auto _ : state) {
+    jit.Calculate(x.data(), y.data(), kPoints);
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+}  // namespace
+
+BENCHMARK(BM_InterpreterCalculate)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_JitCalculate)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_JitCalculateArray)->DenseRange(0, kExpressionCount - 1);
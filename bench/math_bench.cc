@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#include "math_calc.h"
+#include "program_library.h"
+
+using namespace s21;
+
+namespace {
+const char* const kExpressions[] = {
+    "x",
+    "x ^ 2 + 3x - 1",
+    "(x - 1) / (x + 1) * (x - 2) / (x + 2) - x * x * x",
+    "2xcos(3x) + -x ^ 2 mod 7",
+    "sqrt(x) + sin(x) * cos(x) - ln(x + 1)",
+    "sin(x) ^ 2 + 2sin(x)cos(x) + cos(x) ^ 2",
+    "3x ^ 4 - 2x ^ 3 + x - 7",
+    "(x ^ 3 - 2x + 1) / (x ^ 2 + 1)",
+};
+
+constexpr int kExpressionCount =
+    static_cast<int>(sizeof(kExpressions) / sizeof(kExpressions[0]));
+
+/**
+ * @brief Returns the expression selected by the first argument of a run.
+ */
+const char* SelectExpression(benchmark::State& state) {
+  const char* expression = kExpressions[state.range(0)];
+  state.SetLabel(expression);
+  return expression;
+}
+
+/**
+ * @brief Measures tokenization and validation of an expression.
+ */
+void BM_Canonicalize(benchmark::State& state) {
+  std::string expression = SelectExpression(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MathCalc::Canonicalize(expression));
+  }
+}
+
+/**
+ * @brief Measures compilation of an expression to an optimized Program.
+ */
+void BM_Compile(benchmark::State& state) {
+  std::string expression = SelectExpression(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MathCalc::Compile(expression));
+  }
+}
+
+/**
+ * @brief Measures a single evaluation that includes parsing the expression.
+ */
+void BM_CalculateExpression(benchmark::State& state) {
+  std::string expression = SelectExpression(state);
+  double x = 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MathCalc::Calculate(expression, x));
+  }
+}
+
+/**
+ * @brief Measures a single evaluation of a compiled Program.
+ */
+void BM_CalculateProgram(benchmark::State& state) {
+  Program program = MathCalc::Compile(SelectExpression(state));
+  double x = 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x);
+    benchmark::DoNotOptimize(MathCalc::Calculate(program, x));
+  }
+}
+
+/**
+ * @brief Measures evaluation of a compiled Program over a range of points.
+ *
+ * The second argument is the number of points and the third one the number
+ * of threads.
+ */
+void BM_CalculateRange(benchmark::State& state) {
+  Program program = MathCalc::Compile(SelectExpression(state));
+  auto size = static_cast<std::size_t>(state.range(1));
+  auto threads = static_cast<std::size_t>(state.range(2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        MathCalc::Calculate(program, -10.0, 10.0, size, threads));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/**
+ * @brief Measures evaluation of a compiled Program over a range of points in
+ * each precision.
+ *
+ * The second argument is the number of points and the third one the
+ * MathCalc::Precision the points are evaluated in.
+ */
+void BM_CalculateRangePrecision(benchmark::State& state) {
+  Program program = MathCalc::Compile(SelectExpression(state));
+  auto size = static_cast<std::size_t>(state.range(1));
+  auto precision = static_cast<MathCalc::Precision>(state.range(2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        MathCalc::Calculate(program, -10.0, 10.0, size, precision));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+/**
+ * @brief Returns the text of the i-th formula of a synthetic library.
+ */
+std::string LibraryFormula(std::size_t i) {
+  std::string n = std::to_string(i % 997 + 1);
+  return kExpressions[i % kExpressionCount] + std::string(" + ") + n + "x";
+}
+
+/**
+ * @brief Measures compiling a library of formulas from their text.
+ *
+ * The argument is the number of formulas.
+ */
+void BM_CompileLibrary(benchmark::State& state) {
+  auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<std::string> formulas;
+  for (std::size_t i = 0; i < size; ++i) {
+    formulas.push_back(LibraryFormula(i));
+  }
+  for (auto _ : state) {
+    std::vector<Program> programs;
+    programs.reserve(size);
+    for (const std::string& formula : formulas) {
+      programs.push_back(MathCalc::Compile(formula));
+    }
+    benchmark::DoNotOptimize(programs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * @brief Measures opening a library of compiled formulas and evaluating one
+ * of them.
+ *
+ * The argument is the number of formulas.
+ */
+void BM_LoadLibrary(benchmark::State& state) {
+  auto size = static_cast<std::size_t>(state.range(0));
+  std::string path = "model_bench_library.bin";
+  ProgramLibrary::Builder builder;
+  for (std::size_t i = 0; i < size; ++i) {
+    builder.Add("f" + std::to_string(i), LibraryFormula(i));
+  }
+  builder.Write(path);
+  for (auto _ : state) {
+    ProgramLibrary library(path);
+    benchmark::DoNotOptimize(
+        MathCalc::Calculate(library.GetProgram(library.Find("f0")), 0.5));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  std::remove(path.c_str());
+}
+}  // namespace
+
+BENCHMARK(BM_Canonicalize)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_Compile)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_CalculateExpression)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_CalculateProgram)->DenseRange(0, kExpressionCount - 1);
+BENCHMARK(BM_CalculateRange)
+    ->ArgNames({"expression", "points", "threads"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, kExpressionCount - 1, 1),
+                   benchmark::CreateRange(1 << 8, 1 << 20, 16), {1, 4}})
+    ->UseRealTime();
+BENCHMARK(BM_CalculateRangePrecision)
+    ->ArgNames({"expression", "points", "precision"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, kExpressionCount - 1, 1),
+                   {1 << 12, 1 << 16}, {0, 1, 2}});
+BENCHMARK(BM_CompileLibrary)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadLibrary)->Arg(50000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "batch_evaluator.h"
+using namespace s21;
+
+namespace {
+
+void PrintUsage(const char *program) {
+  std::cerr
+      << "Usage: " << program
+      << " [-t threads] [-b batch] [-v names] [-d separator] [file]\n"
+         "\n"
+         "Evaluates one record per line of the file or of the standard input\n"
+         "and prints one result or error per line in the same order. A record\n"
+         "is an expression optionally followed by one value per variable:\n"
+         "\n"
+         "  x^2 + 1,3.5\n"
+         "\n"
+         "  -t threads    threads per stage, 0 for one per hardware thread\n"
+         "  -b batch      records per batch (default 4096)\n"
+         "  -v names      comma separated variable names (default x)\n"
+         "  -d separator  field separator (default ,)\n"
+         "\n"
+         "Exits with status 3 if any record could not be evaluated.\n";
+}
+
+bool ParseSize(const char *text, std::size_t &value) {
+  char *end = nullptr;
+  unsigned long long parsed = std::strtoull(text, &end, 10);
+  if (!*text || *end || text[0] == '-') {
+    return false;
+  }
+  value = static_cast<std::size_t>(parsed);
+  return true;
+}
+
+VariableTable ParseVariables(const std::string &text) {
+  std::vector<std::string> names;
+  std::stringstream stream(text);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    names.push_back(name);
+  }
+  return VariableTable(names);
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  BatchEvaluator::Options options;
+  const char *path = nullptr;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      bool has_value = i + 1 < argc;
+      if (!std::strcmp(argv[i], "-t") && has_value) {
+        if (!ParseSize(argv[++i], options.threads)) {
+          throw std::logic_error("Invalid number of threads");
+        }
+      } else if (!std::strcmp(argv[i], "-b") && has_value) {
+        if (!ParseSize(argv[++i], options.batch_size)) {
+          throw std::logic_error("Invalid batch size");
+        }
+      } else if (!std::strcmp(argv[i], "-v") && has_value) {
+        options.variables = ParseVariables(argv[++i]);
+      } else if (!std::strcmp(argv[i], "-d") && has_value &&
+                 std::strlen(argv[i + 1]) == 1) {
+        options.separator = argv[++i][0];
+      } else if (argv[i][0] != '-' && !path) {
+        path = argv[i];
+      } else {
+        throw std::logic_error(std::string("Invalid argument: ") + argv[i]);
+      }
+    }
+  } catch (const std::exception &err) {
+    std::cerr << err.what() << "\n";
+    PrintUsage(argv[0]);
+    return 2;
+  }
+
+  std::ios::sync_with_stdio(false);
+  std::ifstream file;
+  if (path) {
+    file.open(path);
+    if (!file) {
+      std::cerr << "Cannot open " << path << "\n";
+      return 1;
+    }
+  }
+
+  BatchEvaluator evaluator(options);
+  BatchEvaluator::Statistics statistics =
+      evaluator.Run(path ? file : std::cin, std::cout);
+  if (!std::cout) {
+    std::cerr << "Cannot write the results\n";
+    return 1;
+  }
+  return statistics.errors ? 3 : 0;
+}
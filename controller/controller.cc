@@ -3,13 +3,57 @@
 namespace s21 {
 
 double Controller::Calculate(const std::string& expression, double x) {
-  return MathCalc::Calculate(expression, x);
+  return MathCalc::Calculate(*Cache().Get(expression), x);
+}
+
+double Controller::Preview(IncrementalParser& parser,
+                           const std::string& expression, double x,
+                           Error& error) {
+  return parser.Update(expression, x, error);
 }
 
 std::pair<std::vector<double>, std::vector<double>> Controller::Calculate(
+    const std::string& expression, double x_min, double x_max,
+    std::size_t size, std::size_t threads) {
+  return MathCalc::Calculate(*Cache().Get(expression), x_min, x_max, size,
+                             threads);
+}
+
+std::pair<std::vector<double>, std::vector<double>> Controller::Calculate(
+    const std::string& expression, double x_min, double x_max,
+    std::size_t size, MathCalc::Precision precision, std::size_t threads) {
+  return MathCalc::Calculate(*Cache().Get(expression), x_min, x_max, size,
+                             precision, threads);
+}
+
+void Controller::Calculate(const std::string& expression,
+                           const VariableTable& variables,
+                           const double* const* columns, double* y,
+                           std::size_t size, std::size_t threads) {
+  MathCalc::Calculate(*Cache().Get(expression, variables), columns, y, size,
+                      threads);
+}
+
+AdaptiveSampler::Result Controller::Sample(
+    const std::string& expression, const AdaptiveSampler::Options& options) {
+  return AdaptiveSampler::Sample(*Cache().Get(expression), options);
+}
+
+DualEvaluator::Dual Controller::Differentiate(const std::string& expression,
+                                              double x) {
+  return DualEvaluator::Evaluate(*Cache().Get(expression), x);
+}
+
+std::pair<std::vector<double>, std::vector<double>> Controller::Differentiate(
     const std::string& expression, double x_min, double x_max,
     std::size_t size) {
-  return MathCalc::Calculate(expression, x_min, x_max, size);
+  return DualEvaluator::Differentiate(*Cache().Get(expression), x_min, x_max,
+                                      size);
+}
+
+Solver::Result Controller::Solve(const std::string& expression,
+                                 const Solver::Options& options) {
+  return Solver::Solve(*Cache().Get(expression), options);
 }
 
 CreditCalc::PaymentPlan Controller::Calculate(
@@ -17,9 +61,26 @@ CreditCalc::PaymentPlan Controller::Calculate(
   return CreditCalc::Calculate(info);
 }
 
+CreditCalc::Summary Controller::Summarize(const CreditCalc::CreditInfo& info) {
+  return CreditCalc::Summarize(info);
+}
+
 DepositCalc::PaymentPlan Controller::Calculate(
     const DepositCalc::DepositInfo& info) {
   return DepositCalc::Calculate(info);
 }
 
+void Controller::SetCacheCapacity(std::size_t capacity) {
+  Cache().SetCapacity(capacity);
+}
+
+ProgramCache::Statistics Controller::GetCacheStatistics() {
+  return Cache().GetStatistics();
+}
+
+ProgramCache& Controller::Cache() {
+  static ProgramCache cache;
+  return cache;
+}
+
 }  // namespace s21
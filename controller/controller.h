@@ -1,21 +1,52 @@
 #ifndef SMARTCALC_CONTROLLER_CONTROLLER_H_
 #define SMARTCALC_CONTROLLER_CONTROLLER_H_
 
+#include "adaptive_sampler.h"
 #include "credit_calc.h"
 #include "deposit_calc.h"
+#include "dual_evaluator.h"
+#include "incremental_parser.h"
 #include "math_calc.h"
+#include "program_cache.h"
+#include "solver.h"
 
 namespace s21 {
 
 class Controller {
  public:
   static double Calculate(const std::string& expression, double x = 0.0);
+  static double Preview(IncrementalParser& parser,
+                        const std::string& expression, double x,
+                        Error& error);
   static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const std::string& expression, double x_min, double x_max,
+      std::size_t size, std::size_t threads = 1);
+  static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const std::string& expression, double x_min, double x_max,
+      std::size_t size, MathCalc::Precision precision,
+      std::size_t threads = 1);
+  static void Calculate(const std::string& expression,
+                        const VariableTable& variables,
+                        const double* const* columns, double* y,
+                        std::size_t size, std::size_t threads = 1);
+  static AdaptiveSampler::Result Sample(
+      const std::string& expression, const AdaptiveSampler::Options& options);
+  static DualEvaluator::Dual Differentiate(const std::string& expression,
+                                           double x);
+  static std::pair<std::vector<double>, std::vector<double>> Differentiate(
       const std::string& expression, double x_min, double x_max,
       std::size_t size);
+  static Solver::Result Solve(const std::string& expression,
+                              const Solver::Options& options);
   static CreditCalc::PaymentPlan Calculate(const CreditCalc::CreditInfo& info);
+  static CreditCalc::Summary Summarize(const CreditCalc::CreditInfo& info);
   static DepositCalc::PaymentPlan Calculate(
       const DepositCalc::DepositInfo& info);
+  static void SetCacheCapacity(std::size_t capacity);
+  static ProgramCache::Statistics GetCacheStatistics();
+
+ private:
+  static ProgramCache& Cache();
 };
 }  // namespace s21
 
@@ -0,0 +1,251 @@
+#include "adaptive_sampler.h"
+
+namespace s21 {
+
+/**
+ * @brief Samples a compiled expression for a plot.
+ *
+ * The expression is first evaluated at the ends and midpoints of a uniform grid
+ * of options.initial intervals. Every interval whose midpoint deviates from the
+ * chord by more than options.tolerance pixels is then bisected at its midpoint,
+ * and the quarter points are evaluated as the midpoints of the two halves, so
+ * each interval always knows its own deviation. The intervals of a round are
+ * evaluated together with the VectorEvaluator. An interval is resolved when its
+ * deviation is within the tolerance; intervals narrower than options.resolution
+ * pixels are not bisected any further. Samples that are all undefined or all on
+ * the same side outside the visible range say nothing about the curve between
+ * them, so such an interval gets twice the tolerance as its deviation: it is
+ * bisected like the others, but after the visible features when the budget is
+ * short. With options.cull an interval is resolved instead of bisected when its
+ * interval bound shows that the curve is hidden on all of it, which saves the
+ * evaluations spent on locating domain boundaries and poles outside the view.
+ * If the remaining budget does not cover all unresolved intervals, the ones
+ * with the largest deviation are bisected first.
+ *
+ * @param program A valid compiled expression.
+ * @param options The parameters of the plot.
+ * @return The continuous parts of the curve and the number of evaluations,
+ * which does not exceed options.budget unless it is less than 3.
+ * @throws std::logic_error if the plot range is empty.
+ */
+AdaptiveSampler::Result AdaptiveSampler::Sample(const Program& program,
+                                                const Options& options) {
+  if (!(options.x_min < options.x_max) || !(options.y_min < options.y_max) ||
+      !(options.width > 0.0) || !(options.height > 0.0)) {
+    throw std::logic_error("Invalid plot range");
+  }
+
+  std::size_t budget = std::max<std::size_t>(options.budget, 3);
+  std::size_t initial =
+      std::clamp<std::size_t>(options.initial, 1, (budget - 1) / 2);
+  double scale_x = options.width / (options.x_max - options.x_min);
+  double step = (options.x_max - options.x_min) / initial;
+
+  std::vector<double> x(2 * initial + 1), y(2 * initial + 1);
+  for (std::size_t i = 0; i < initial; ++i) {
+    x[2 * i] = options.x_min + static_cast<double>(i) * step;
+  }
+  x.back() = options.x_max;
+  for (std::size_t i = 0; i < initial; ++i) {
+    x[2 * i + 1] = Middle(x[2 * i], x[2 * i + 2]);
+  }
+  VectorEvaluator::Evaluate(program, x.data(), y.data(), x.size());
+  std::size_t evaluations = x.size();
+
+  std::vector<double> deviations(initial);
+  for (std::size_t i = 0; i < initial; ++i) {
+    deviations[i] = Deviation(y[2 * i], y[2 * i + 1], y[2 * i + 2], options);
+  }
+
+  std::vector<std::size_t> candidates;
+  std::vector<double> quarter_x, quarter_y;
+  while (budget - evaluations >= 2) {
+    candidates.clear();
+    for (std::size_t i = 0; i < deviations.size(); ++i) {
+      if (deviations[i] > options.tolerance &&
+          (x[2 * i + 2] - x[2 * i]) * scale_x > options.resolution) {
+        if (options.cull &&
+            IsHidden(program, x[2 * i], x[2 * i + 2], options)) {
+          deviations[i] = kResolved;
+        } else {
+          candidates.push_back(i);
+        }
+      }
+    }
+    if (candidates.empty()) {
+      break;
+    }
+    std::size_t affordable = (budget - evaluations) / 2;
+    if (candidates.size() > affordable) {
+      auto last = candidates.begin() + affordable;
+      std::nth_element(candidates.begin(), last, candidates.end(),
+                       [&deviations](std::size_t lhs, std::size_t rhs) {
+                         return deviations[lhs] > deviations[rhs];
+                       });
+      candidates.erase(last, candidates.end());
+      std::sort(candidates.begin(), candidates.end());
+    }
+
+    quarter_x.resize(2 * candidates.size());
+    quarter_y.resize(2 * candidates.size());
+    for (std::size_t k = 0; k < candidates.size(); ++k) {
+      std::size_t i = 2 * candidates[k];
+      quarter_x[2 * k] = Middle(x[i], x[i + 1]);
+      quarter_x[2 * k + 1] = Middle(x[i + 1], x[i + 2]);
+    }
+    VectorEvaluator::Evaluate(program, quarter_x.data(), quarter_y.data(),
+                              quarter_x.size());
+    evaluations += quarter_x.size();
+
+    std::vector<double> refined_x, refined_y, refined_deviations;
+    refined_x.reserve(x.size() + quarter_x.size());
+    refined_y.reserve(x.size() + quarter_x.size());
+    refined_deviations.reserve(deviations.size() + candidates.size());
+    for (std::size_t i = 0, k = 0; i < deviations.size(); ++i) {
+      const double* ends_x = &x[2 * i];
+      const double* ends_y = &y[2 * i];
+      if (k < candidates.size() && candidates[k] == i) {
+        const double* middle_x = &quarter_x[2 * k];
+        const double* middle_y = &quarter_y[2 * k];
+        refined_x.insert(refined_x.end(), {ends_x[0], middle_x[0], ends_x[1],
+                                           middle_x[1]});
+        refined_y.insert(refined_y.end(), {ends_y[0], middle_y[0], ends_y[1],
+                                           middle_y[1]});
+        refined_deviations.push_back(
+            Deviation(ends_y[0], middle_y[0], ends_y[1], options));
+        refined_deviations.push_back(
+            Deviation(ends_y[1], middle_y[1], ends_y[2], options));
+        ++k;
+      } else {
+        refined_x.insert(refined_x.end(), {ends_x[0], ends_x[1]});
+        refined_y.insert(refined_y.end(), {ends_y[0], ends_y[1]});
+        refined_deviations.push_back(deviations[i]);
+      }
+    }
+    refined_x.push_back(x.back());
+    refined_y.push_back(y.back());
+    x.swap(refined_x);
+    y.swap(refined_y);
+    deviations.swap(refined_deviations);
+  }
+
+  return {Split(x, y, deviations, options), evaluations};
+}
+
+/**
+ * @brief Returns the midpoint of an interval.
+ */
+double AdaptiveSampler::Middle(double a, double b) { return a + (b - a) / 2; }
+
+/**
+ * @brief Checks if the curve is invisible on a whole interval.
+ *
+ * @return True if the expression is undefined on the interval or its interval
+ * bound lies entirely above or below the visible range.
+ */
+bool AdaptiveSampler::IsHidden(const Program& program, double a, double b,
+                               const Options& options) {
+  IntervalEvaluator::Interval bound =
+      IntervalEvaluator::Evaluate(program, {a, b, true});
+  return bound.IsEmpty() || bound.lower > options.y_max ||
+         bound.upper < options.y_min;
+}
+
+/**
+ * @brief Measures how far the midpoint of an interval is from the chord.
+ *
+ * @param a The value at the start of the interval.
+ * @param m The value at the midpoint.
+ * @param b The value at the end of the interval.
+ * @param options The parameters of the plot.
+ * @return The deviation in pixels, infinity if the expression is defined on
+ * only a part of the interval, or twice the tolerance if no sample is
+ * visible.
+ */
+double AdaptiveSampler::Deviation(double a, double m, double b,
+                                  const Options& options) {
+  bool finite_a = std::isfinite(a);
+  bool finite_m = std::isfinite(m);
+  bool finite_b = std::isfinite(b);
+
+  if (!finite_a && !finite_m && !finite_b) {
+    return 2 * options.tolerance;
+  }
+  if (!finite_a || !finite_m || !finite_b) {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (IsOffScreen(a, m, b, options)) {
+    return 2 * options.tolerance;
+  }
+
+  double scale_y = options.height / (options.y_max - options.y_min);
+  return std::abs(m - (a / 2 + b / 2)) * scale_y;
+}
+
+/**
+ * @brief Checks if the samples of an interval are all above or all below the
+ * visible range.
+ */
+bool AdaptiveSampler::IsOffScreen(double a, double m, double b,
+                                  const Options& options) {
+  return (a > options.y_max && m > options.y_max && b > options.y_max) ||
+         (a < options.y_min && m < options.y_min && b < options.y_min);
+}
+
+/**
+ * @brief Splits the sampled curve into continuous series.
+ *
+ * The curve is split at every point where the expression is undefined and in
+ * every interval that could not be resolved down to the resolution of the
+ * plot, which is where the function jumps, unless the interval is outside
+ * the visible range, where no line is seen. The split is made in the half of
+ * the interval with the larger change, provided that the change exceeds twice
+ * the tolerance.
+ *
+ * @param x The sampled values of the variable: the ends of the intervals
+ * interleaved with their midpoints.
+ * @param y The values of the expression.
+ * @param deviations The deviations of the intervals.
+ * @param options The parameters of the plot.
+ * @return The continuous parts of the curve.
+ */
+std::vector<AdaptiveSampler::Series> AdaptiveSampler::Split(
+    const std::vector<double>& x, const std::vector<double>& y,
+    const std::vector<double>& deviations, const Options& options) {
+  double scale_x = options.width / (options.x_max - options.x_min);
+  double scale_y = options.height / (options.y_max - options.y_min);
+  std::vector<bool> jumps(x.size(), false);
+  for (std::size_t i = 0; i < deviations.size(); ++i) {
+    const double* ends_x = &x[2 * i];
+    const double* ends_y = &y[2 * i];
+    if (deviations[i] > options.tolerance &&
+        (ends_x[2] - ends_x[0]) * scale_x <= options.resolution &&
+        !IsOffScreen(ends_y[0], ends_y[1], ends_y[2], options)) {
+      double left = std::abs(ends_y[1] - ends_y[0]);
+      double right = std::abs(ends_y[2] - ends_y[1]);
+      if (std::max(left, right) * scale_y > 2 * options.tolerance) {
+        jumps[left > right ? 2 * i + 1 : 2 * i + 2] = true;
+      }
+    }
+  }
+
+  std::vector<Series> series;
+  Series current;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    if ((!std::isfinite(y[i]) || jumps[i]) && !current.x.empty()) {
+      series.push_back(std::move(current));
+      current = Series();
+    }
+    if (std::isfinite(y[i])) {
+      current.x.push_back(x[i]);
+      current.y.push_back(y[i]);
+    }
+  }
+  if (!current.x.empty()) {
+    series.push_back(std::move(current));
+  }
+
+  return series;
+}
+
+}  // namespace s21
@@ -0,0 +1,95 @@
+#ifndef SMARTCALC_MODEL_ADAPTIVE_SAMPLER_H_
+#define SMARTCALC_MODEL_ADAPTIVE_SAMPLER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "interval_evaluator.h"
+#include "program.h"
+#include "vector_evaluator.h"
+
+namespace s21 {
+
+/**
+ * @class AdaptiveSampler
+ * @brief A class for sampling expressions for plotting.
+ *
+ * AdaptiveSampler chooses the points at which a compiled expression is
+ * evaluated for a plot. Starting from a coarse uniform grid it repeatedly
+ * bisects the intervals where the curve deviates from a straight line by more
+ * than a fraction of a pixel, so flat stretches get few points and sharp
+ * features get many, until the deviation is below the tolerance, the
+ * intervals are narrower than the resolution of the plot, or the evaluation
+ * budget is spent. The boundaries of regions where the expression is not
+ * defined are located in the same way, and the resulting curve is split into
+ * separate series there and at jumps of the function, so that no line is
+ * drawn across an asymptote or a discontinuity. Before an interval is bisected
+ * its values are bounded with the IntervalEvaluator, and intervals on which
+ * the curve provably stays outside the visible range or is nowhere defined
+ * are not refined at all.
+ */
+class AdaptiveSampler {
+ public:
+  /**
+   * @struct Options
+   * @brief Structure for holding the parameters of a plot.
+   *
+   * The visible range and the size of the plot in pixels determine the
+   * accuracy required from the samples. Culling with interval bounds can be
+   * turned off to refine every interval by its samples alone.
+   */
+  struct Options {
+    double x_min = -10.0;
+    double x_max = 10.0;
+    double y_min = -10.0;
+    double y_max = 10.0;
+    double width = 1000.0;
+    double height = 1000.0;
+    std::size_t initial = 128;
+    std::size_t budget = 10000;
+    double tolerance = 0.25;
+    double resolution = 1.0 / 64;
+    bool cull = true;
+  };
+
+  /**
+   * @struct Series
+   * @brief A continuous part of the plotted curve.
+   */
+  struct Series {
+    std::vector<double> x;
+    std::vector<double> y;
+  };
+
+  /**
+   * @struct Result
+   * @brief Structure for holding the sampled curve.
+   */
+  struct Result {
+    std::vector<Series> series;
+    std::size_t evaluations = 0;
+  };
+
+  static Result Sample(const Program& program, const Options& options);
+
+ private:
+  static constexpr double kResolved = -1.0;
+
+  static double Middle(double a, double b);
+  static bool IsHidden(const Program& program, double a, double b,
+                       const Options& options);
+  static double Deviation(double a, double m, double b,
+                          const Options& options);
+  static bool IsOffScreen(double a, double m, double b,
+                          const Options& options);
+  static std::vector<Series> Split(const std::vector<double>& x,
+                                   const std::vector<double>& y,
+                                   const std::vector<double>& deviations,
+                                   const Options& options);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_ADAPTIVE_SAMPLER_H_
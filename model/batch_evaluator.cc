@@ -0,0 +1,334 @@
+#include "batch_evaluator.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructs a BatchEvaluator with the default options.
+ */
+BatchEvaluator::BatchEvaluator() : BatchEvaluator(Options()) {}
+
+/**
+ * @brief Constructor of the BatchEvaluator class.
+ *
+ * @param options The parameters of the pipeline.
+ */
+BatchEvaluator::BatchEvaluator(const Options& options)
+    : options_(options),
+      threads_(options.threads
+                   ? options.threads
+                   : std::max(1u, std::thread::hardware_concurrency())),
+      max_in_flight_(kBatchesPerThread * 2 * threads_) {
+  options_.batch_size = std::max<std::size_t>(options_.batch_size, 1);
+}
+
+/**
+ * @brief Evaluates all records of a stream.
+ *
+ * The reader runs in its own thread, followed by the compile and evaluation
+ * workers and the writer. The calling thread waits for the stages to finish
+ * one after another and closes the channel behind every finished stage, which
+ * lets the next stage drain its input and stop. A record that cannot be
+ * evaluated produces a line "error: " followed by the reason, and does not
+ * affect the other records.
+ *
+ * @param input The records, one per line.
+ * @param output The stream that receives one line per record.
+ * @return The number of records and the number of errors.
+ */
+BatchEvaluator::Statistics BatchEvaluator::Run(std::istream& input,
+                                               std::ostream& output) {
+  Statistics statistics;
+  Channel compile_queue, evaluate_queue, write_queue;
+  in_flight_ = 0;
+
+  std::thread reader([&] {
+    Read(input, compile_queue);
+    compile_queue.Close();
+  });
+  std::vector<std::thread> compilers, evaluators;
+  for (std::size_t i = 0; i < threads_; ++i) {
+    compilers.emplace_back(
+        [&] { CompileStage(compile_queue, evaluate_queue); });
+    evaluators.emplace_back(
+        [&] { EvaluateStage(evaluate_queue, write_queue); });
+  }
+  std::thread writer([&] { Write(write_queue, output, statistics); });
+
+  reader.join();
+  for (std::thread& compiler : compilers) {
+    compiler.join();
+  }
+  evaluate_queue.Close();
+  for (std::thread& evaluator : evaluators) {
+    evaluator.join();
+  }
+  write_queue.Close();
+  writer.join();
+
+  output.flush();
+  return statistics;
+}
+
+/**
+ * @brief Splits the input into batches of options.batch_size lines.
+ *
+ * The reader waits while the maximum number of batches is in flight, so a
+ * slow consumer stops the reader instead of accumulating the input in
+ * memory. Carriage returns at the ends of lines are removed.
+ */
+void BatchEvaluator::Read(std::istream& input, Channel& output) {
+  for (std::size_t sequence = 0; input; ++sequence) {
+    {
+      std::unique_lock<std::mutex> lock(flight_mutex_);
+      flight_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+    }
+
+    auto batch = std::make_unique<Batch>();
+    batch->sequence = sequence;
+    batch->lines.reserve(options_.batch_size);
+    std::string line;
+    while (batch->lines.size() < options_.batch_size &&
+           std::getline(input, line)) {
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+      }
+      batch->lines.push_back(std::move(line));
+    }
+    if (batch->lines.empty()) {
+      break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(flight_mutex_);
+      ++in_flight_;
+    }
+    output.Push(std::move(batch));
+  }
+}
+
+/**
+ * @brief Runs the compile stage until its input channel is closed.
+ */
+void BatchEvaluator::CompileStage(Channel& input, Channel& output) {
+  while (std::unique_ptr<Batch> batch = input.Pop()) {
+    Compile(*batch);
+    output.Push(std::move(batch));
+  }
+}
+
+/**
+ * @brief Runs the evaluation stage until its input channel is closed.
+ */
+void BatchEvaluator::EvaluateStage(Channel& input, Channel& output) const {
+  while (std::unique_ptr<Batch> batch = input.Pop()) {
+    Evaluate(*batch);
+    Format(*batch);
+    output.Push(std::move(batch));
+  }
+}
+
+/**
+ * @brief Writes the formatted batches in the order of the input.
+ *
+ * Batches that arrive before their predecessors are held back until all
+ * preceding batches are written.
+ */
+void BatchEvaluator::Write(Channel& input, std::ostream& output,
+                           Statistics& statistics) {
+  std::map<std::size_t, std::unique_ptr<Batch>> pending;
+  std::size_t next = 0;
+
+  while (std::unique_ptr<Batch> batch = input.Pop()) {
+    pending.emplace(batch->sequence, std::move(batch));
+    for (auto it = pending.find(next); it != pending.end();
+         it = pending.find(++next)) {
+      const Batch& ready = *it->second;
+      output.write(ready.text.data(),
+                   static_cast<std::streamsize>(ready.text.size()));
+      statistics.records += ready.lines.size();
+      statistics.errors += ready.error_count;
+      pending.erase(it);
+      {
+        std::lock_guard<std::mutex> lock(flight_mutex_);
+        --in_flight_;
+      }
+      flight_.notify_one();
+    }
+  }
+}
+
+/**
+ * @brief Compiles the expressions and decodes the values of a batch.
+ *
+ * The text of a record up to the first separator is the expression and is
+ * compiled with options.variables through the cache, so repeated expressions
+ * are compiled once. Invalid expressions are rejected without throwing, so a
+ * batch with many of them costs about as much as a valid one. The expression
+ * is followed either by nothing, in which case all variables are 0, or by
+ * exactly one value per variable.
+ */
+void BatchEvaluator::Compile(Batch& batch) {
+  std::size_t count = batch.lines.size();
+  std::size_t slots = options_.variables.GetSize();
+  batch.programs.assign(count, nullptr);
+  batch.values.assign(count * slots, 0.0);
+  batch.errors.assign(count, std::string());
+  Error error;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::string& line = batch.lines[i];
+    std::size_t pos = line.find(options_.separator);
+    batch.programs[i] =
+        cache_.Get(line.substr(0, pos), error, options_.variables);
+    if (!error.IsOk()) {
+      batch.errors[i] = std::move(error.message);
+      continue;
+    }
+    if (pos != std::string::npos &&
+        !ParseValues(line, pos + 1, &batch.values[i * slots])) {
+      batch.programs[i] = nullptr;
+      batch.errors[i] = "Invalid variable values";
+    }
+  }
+}
+
+/**
+ * @brief Evaluates the compiled records of a batch.
+ *
+ * Records with the same Program are gathered into one column per variable and
+ * evaluated together, so a batch of records of a few expressions runs almost
+ * entirely in the vector kernel.
+ */
+void BatchEvaluator::Evaluate(Batch& batch) const {
+  std::size_t count = batch.lines.size();
+  std::size_t slots = options_.variables.GetSize();
+  batch.results.assign(count, 0.0);
+
+  std::unordered_map<const Program*, std::vector<std::size_t>> groups;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (batch.programs[i]) {
+      groups[batch.programs[i].get()].push_back(i);
+    }
+  }
+
+  std::vector<std::vector<double>> columns(slots);
+  std::vector<const double*> pointers(slots);
+  std::vector<double> y;
+  for (const auto& [program, records] : groups) {
+    for (std::size_t slot = 0; slot < slots; ++slot) {
+      columns[slot].resize(records.size());
+      for (std::size_t k = 0; k < records.size(); ++k) {
+        columns[slot][k] = batch.values[records[k] * slots + slot];
+      }
+      pointers[slot] = columns[slot].data();
+    }
+    y.resize(records.size());
+    MathCalc::Calculate(*program, pointers.data(), y.data(), records.size());
+    for (std::size_t k = 0; k < records.size(); ++k) {
+      batch.results[records[k]] = y[k];
+    }
+  }
+}
+
+/**
+ * @brief Formats the output lines of a batch.
+ *
+ * Results are written in the shortest form that reads back to the same
+ * double.
+ */
+void BatchEvaluator::Format(Batch& batch) {
+  batch.text.clear();
+  batch.error_count = 0;
+  for (std::size_t i = 0; i < batch.lines.size(); ++i) {
+    if (batch.programs[i]) {
+      char buffer[32];
+      auto result =
+          std::to_chars(buffer, buffer + sizeof(buffer), batch.results[i]);
+      batch.text.append(buffer, result.ptr);
+    } else {
+      batch.text += "error: " + batch.errors[i];
+      ++batch.error_count;
+    }
+    batch.text += '\n';
+  }
+}
+
+/**
+ * @brief Decodes the values of the variables of a record.
+ *
+ * @param line The record.
+ * @param pos The position after the separator following the expression.
+ * @param values The row that receives one value per variable.
+ * @return True if the record holds exactly one valid number per variable.
+ */
+bool BatchEvaluator::ParseValues(const std::string& line, std::size_t pos,
+                                 double* values) const {
+  std::size_t slots = options_.variables.GetSize();
+  if (slots == 0) {
+    return false;
+  }
+  for (std::size_t slot = 0; slot < slots; ++slot) {
+    std::size_t separator = line.find(options_.separator, pos);
+    if ((separator == std::string::npos) != (slot + 1 == slots)) {
+      return false;
+    }
+    std::size_t end = std::min(separator, line.length());
+    while (pos < end && std::isspace(static_cast<unsigned char>(line[pos]))) {
+      ++pos;
+    }
+    while (end > pos &&
+           std::isspace(static_cast<unsigned char>(line[end - 1]))) {
+      --end;
+    }
+    if (pos < end && line[pos] == '+') {
+      ++pos;
+    }
+    const char* last = line.data() + end;
+    if (std::from_chars(line.data() + pos, last, values[slot]).ptr != last ||
+        pos == end) {
+      return false;
+    }
+    pos = separator + 1;
+  }
+  return true;
+}
+
+/**
+ * @brief Passes a batch to the next stage.
+ */
+void BatchEvaluator::Channel::Push(std::unique_ptr<Batch> batch) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.push_back(std::move(batch));
+  }
+  ready_.notify_one();
+}
+
+/**
+ * @brief Takes the next batch, waiting until one is available.
+ *
+ * @return The batch, or nullptr once the channel is closed and empty.
+ */
+std::unique_ptr<BatchEvaluator::Batch> BatchEvaluator::Channel::Pop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ready_.wait(lock, [this] { return closed_ || !batches_.empty(); });
+  if (batches_.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<Batch> batch = std::move(batches_.front());
+  batches_.pop_front();
+  return batch;
+}
+
+/**
+ * @brief Signals that no more batches will be pushed.
+ */
+void BatchEvaluator::Channel::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  ready_.notify_all();
+}
+
+}  // namespace s21
@@ -0,0 +1,130 @@
+#ifndef SMARTCALC_MODEL_BATCH_EVALUATOR_H_
+#define SMARTCALC_MODEL_BATCH_EVALUATOR_H_
+
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "math_calc.h"
+#include "program_cache.h"
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @class BatchEvaluator
+ * @brief A pipelined evaluator for streams of expression records.
+ *
+ * BatchEvaluator reads records from a text stream, one per line, and writes
+ * one line with the result or the error of every record to an output stream
+ * in the order of the input. A record is an expression optionally followed by
+ * the values of its variables, separated by commas, such as "x^2 + 1,3.5".
+ *
+ * The records are processed in batches by a pipeline of four stages running
+ * concurrently: a reader that splits the input into batches, compile workers
+ * that look the expressions up in a ProgramCache and decode the values,
+ * evaluation workers that group the records of a batch by expression and
+ * evaluate every group as columns with the VectorEvaluator, and a writer that
+ * restores the order of the batches. The number of batches in flight is
+ * bounded, so memory use does not depend on the length of the input.
+ */
+class BatchEvaluator {
+ public:
+  /**
+   * @struct Options
+   * @brief Structure for holding the parameters of the pipeline.
+   *
+   * The compile and evaluation stages each use the given number of threads,
+   * or one per hardware thread if it is 0.
+   */
+  struct Options {
+    VariableTable variables;
+    std::size_t threads = 0;
+    std::size_t batch_size = 4096;
+    char separator = ',';
+  };
+
+  /**
+   * @struct Statistics
+   * @brief The number of processed and failed records.
+   */
+  struct Statistics {
+    std::size_t records = 0;
+    std::size_t errors = 0;
+  };
+
+  BatchEvaluator();
+  explicit BatchEvaluator(const Options& options);
+
+  Statistics Run(std::istream& input, std::ostream& output);
+
+ private:
+  /**
+   * @struct Batch
+   * @brief A group of consecutive records passed between the stages.
+   *
+   * The values of the variables of every record occupy one row of
+   * variables.GetSize() entries. A record with an error has no Program.
+   */
+  struct Batch {
+    std::size_t sequence = 0;
+    std::vector<std::string> lines;
+    std::vector<std::shared_ptr<const Program>> programs;
+    std::vector<double> values;
+    std::vector<std::string> errors;
+    std::vector<double> results;
+    std::string text;
+    std::size_t error_count = 0;
+  };
+
+  /**
+   * @class Channel
+   * @brief A blocking queue connecting two stages of the pipeline.
+   */
+  class Channel {
+   public:
+    void Push(std::unique_ptr<Batch> batch);
+    std::unique_ptr<Batch> Pop();
+    void Close();
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::unique_ptr<Batch>> batches_;
+    bool closed_ = false;
+  };
+
+  static constexpr std::size_t kBatchesPerThread = 2;
+
+  void Read(std::istream& input, Channel& output);
+  void CompileStage(Channel& input, Channel& output);
+  void EvaluateStage(Channel& input, Channel& output) const;
+  void Write(Channel& input, std::ostream& output, Statistics& statistics);
+  void Compile(Batch& batch);
+  void Evaluate(Batch& batch) const;
+  static void Format(Batch& batch);
+  bool ParseValues(const std::string& line, std::size_t pos,
+                   double* values) const;
+
+  Options options_;
+  std::size_t threads_;
+  ProgramCache cache_;
+  std::mutex flight_mutex_;
+  std::condition_variable flight_;
+  std::size_t in_flight_ = 0;
+  std::size_t max_in_flight_ = 0;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_BATCH_EVALUATOR_H_
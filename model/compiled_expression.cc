@@ -0,0 +1,145 @@
+#include "compiled_expression.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructor of the CompiledExpression class.
+ *
+ * @param expression The text the Program was compiled from.
+ * @param program A valid compiled expression, as returned by
+ * MathCalc::Compile.
+ */
+CompiledExpression::CompiledExpression(std::string expression,
+                                       Program program)
+    : expression_(std::move(expression)), program_(std::move(program)) {}
+
+/**
+ * @brief Compiles an expression into a shareable object.
+ *
+ * @param expression The mathematical expression.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled expression.
+ * @throws std::logic_error if the expression is invalid.
+ */
+std::shared_ptr<const CompiledExpression> CompiledExpression::Create(
+    const std::string& expression, const VariableTable& variables) {
+  return std::make_shared<const CompiledExpression>(
+      expression, MathCalc::Compile(expression, variables));
+}
+
+/**
+ * @brief Compiles an expression into a shareable object without throwing.
+ *
+ * @param expression The mathematical expression.
+ * @param error Receives the reason if the expression is invalid.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled expression, or nullptr on error.
+ */
+std::shared_ptr<const CompiledExpression> CompiledExpression::Create(
+    const std::string& expression, Error& error,
+    const VariableTable& variables) {
+  Program program = MathCalc::Compile(expression, error, variables);
+  if (!error.IsOk()) {
+    return nullptr;
+  }
+  return std::make_shared<const CompiledExpression>(expression,
+                                                    std::move(program));
+}
+
+/**
+ * @brief Returns the text the expression was compiled from.
+ */
+const std::string& CompiledExpression::GetExpression() const {
+  return expression_;
+}
+
+/**
+ * @brief Returns the compiled Program.
+ */
+const Program& CompiledExpression::GetProgram() const { return program_; }
+
+/**
+ * @brief Returns the names of the variables in the order of their slots.
+ */
+const std::vector<std::string>& CompiledExpression::GetVariables() const {
+  return program_.variables;
+}
+
+/**
+ * @brief Calculate the result of the expression with a given variable value.
+ *
+ * @param x The value of the variable in the expression.
+ * @return The result of evaluating the expression.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+double CompiledExpression::Calculate(double x) const {
+  return MathCalc::Calculate(program_, x);
+}
+
+/**
+ * @brief Calculate the result of the expression with given values of its
+ * variables.
+ *
+ * @param values The values of the variables in the order of their slots.
+ * @return The result of evaluating the expression.
+ * @throws std::logic_error if the number of values does not match the number
+ * of variables.
+ */
+double CompiledExpression::Calculate(const std::vector<double>& values) const {
+  return MathCalc::Calculate(program_, values);
+}
+
+/**
+ * @brief Calculate the results of the expression for a range of variable
+ * values.
+ *
+ * See MathCalc::Calculate for the distribution of the range over threads.
+ *
+ * @param x_min The minimum value of the variable.
+ * @param x_max The maximum value of the variable.
+ * @param size The number of points between x_min and x_max (inclusive).
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>>
+CompiledExpression::Calculate(double x_min, double x_max, std::size_t size,
+                              std::size_t threads) const {
+  return MathCalc::Calculate(program_, x_min, x_max, size, threads);
+}
+
+/**
+ * @brief Calculate the results of the expression for a range of variable
+ * values in a given precision.
+ *
+ * @param x_min The minimum value of the variable.
+ * @param x_max The maximum value of the variable.
+ * @param size The number of points between x_min and x_max (inclusive).
+ * @param precision The scalar type the expression is evaluated in.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>>
+CompiledExpression::Calculate(double x_min, double x_max, std::size_t size,
+                              MathCalc::Precision precision,
+                              std::size_t threads) const {
+  return MathCalc::Calculate(program_, x_min, x_max, size, precision, threads);
+}
+
+/**
+ * @brief Calculate the results of the expression for columns of variable
+ * values.
+ *
+ * @param columns One column of size values per variable, in slot order.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of rows.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ */
+void CompiledExpression::Calculate(const double* const* columns, double* y,
+                                   std::size_t size,
+                                   std::size_t threads) const {
+  MathCalc::Calculate(program_, columns, y, size, threads);
+}
+}  // namespace s21
@@ -0,0 +1,65 @@
+#ifndef SMARTCALC_MODEL_COMPILED_EXPRESSION_H_
+#define SMARTCALC_MODEL_COMPILED_EXPRESSION_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "error.h"
+#include "math_calc.h"
+#include "program.h"
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @class CompiledExpression
+ * @brief An immutable compiled expression that can be shared by threads.
+ *
+ * CompiledExpression owns a Program and the text it was compiled from, and
+ * never changes them after construction. Every member function is const and
+ * reentrant: the operand buffers used during evaluation are not part of the
+ * object but are kept per thread by MathCalc and VectorEvaluator, and grown
+ * to the depth of the deepest expression a thread has evaluated. A single
+ * instance can therefore be handed to any number of threads through a
+ * shared pointer and evaluated concurrently without synchronization.
+ *
+ * Instances are created with Create, which compiles the expression once.
+ */
+class CompiledExpression {
+ public:
+  CompiledExpression(std::string expression, Program program);
+
+  CompiledExpression(const CompiledExpression&) = delete;
+  CompiledExpression& operator=(const CompiledExpression&) = delete;
+
+  static std::shared_ptr<const CompiledExpression> Create(
+      const std::string& expression,
+      const VariableTable& variables = VariableTable());
+  static std::shared_ptr<const CompiledExpression> Create(
+      const std::string& expression, Error& error,
+      const VariableTable& variables = VariableTable());
+
+  const std::string& GetExpression() const;
+  const Program& GetProgram() const;
+  const std::vector<std::string>& GetVariables() const;
+
+  double Calculate(double x) const;
+  double Calculate(const std::vector<double>& values) const;
+  std::pair<std::vector<double>, std::vector<double>> Calculate(
+      double x_min, double x_max, std::size_t size,
+      std::size_t threads = 1) const;
+  std::pair<std::vector<double>, std::vector<double>> Calculate(
+      double x_min, double x_max, std::size_t size,
+      MathCalc::Precision precision, std::size_t threads = 1) const;
+  void Calculate(const double* const* columns, double* y, std::size_t size,
+                 std::size_t threads = 1) const;
+
+ private:
+  const std::string expression_;
+  const Program program_;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_COMPILED_EXPRESSION_H_
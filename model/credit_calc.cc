@@ -6,118 +6,254 @@ namespace s21 {
  * @brief Calculate credit payment details based on the provided parameters.
  *
  * This method calculates either annuity or differentiated credit payments
- * based on the provided credit parameters.
+ * based on the provided credit parameters. The balance of an annuity credit
+ * grows by the monthly interest and falls by the payment, which is rounded
+ * to a cent, so a few cents may remain after the last payment. A
+ * differentiated credit repays the same part of the sum every month and the
+ * rounding of its payments goes to the interest, so its balance reaches
+ * zero.
  *
  * @param info The credit parameters including sum, rate, term, and type.
  * @return A PaymentPlan structure containing payment details.
  * @throws std::invalid_argument if any of the input parameters are invalid.
  */
 CreditCalc::PaymentPlan CreditCalc::Calculate(const CreditInfo& info) {
-  if (info.sum <= 0.0 || info.rate <= 0.0 || info.term <= 0) {
-    throw std::invalid_argument("Invalid credit parameters");
-  }
+  Validate(info);
 
   PaymentPlan plan;
   double monthly_rate = info.rate / 12.0 / 100.0;
   plan.dates = GenerateDates(info.term);
+  plan.payments.reserve(info.term);
+  plan.principals.reserve(info.term);
+  plan.interests.reserve(info.term);
+  plan.balances.reserve(info.term);
 
   if (info.type == CreditType::kAnnuity) {
-    plan.payments = CalculateAnnuity(info);
+    double payment = CalculateAnnuity(info);
+    double balance = info.sum;
+    for (int month = 1; month <= info.term; ++month) {
+      double interest = balance * monthly_rate;
+      balance = CalculateAnnuityBalance(info, payment, month);
+      plan.payments.push_back(payment);
+      plan.principals.push_back(payment - interest);
+      plan.interests.push_back(interest);
+      plan.balances.push_back(balance);
+    }
   } else {
-    plan.payments = CalculateDifferentiated(info);
+    Schedule schedule = CalculateDifferentiated(info);
+    double principal = info.sum / info.term;
+    for (int month = 1; month <= info.term; ++month) {
+      double payment = GetPayment(schedule, info.term - month + 1);
+      plan.payments.push_back(payment);
+      plan.principals.push_back(principal);
+      plan.interests.push_back(payment - principal);
+      plan.balances.push_back(info.sum * (info.term - month) / info.term);
+    }
   }
 
-  double balance = info.sum;
-  for (int i = 0; i < info.term; ++i) {
-    double interest = balance * monthly_rate;
-    double principal = plan.payments[i] - interest;
-    plan.interests.push_back(interest);
-    plan.principals.push_back(principal);
-    plan.balances.push_back(balance -= principal);
+  return plan;
+}
+
+/**
+ * @brief Calculate the totals of a credit without building its plan.
+ *
+ * An annuity credit takes constant time. The payments of a differentiated
+ * credit are summed in O(log term) as a sum of floors of a linear function,
+ * so the total includes the rounding of every payment to a cent.
+ *
+ * @param info The credit parameters including sum, rate, term, and type.
+ * @return The total payment and interest and the first and last payment,
+ * equal to those of the PaymentPlan.
+ * @throws std::invalid_argument if any of the input parameters are invalid.
+ */
+CreditCalc::Summary CreditCalc::Summarize(const CreditInfo& info) {
+  Validate(info);
+
+  Summary summary;
+  if (info.type == CreditType::kAnnuity) {
+    double payment = CalculateAnnuity(info);
+    double balance = CalculateAnnuityBalance(info, payment, info.term);
+    summary.total_payment = payment * info.term;
+    summary.total_interest = summary.total_payment - (info.sum - balance);
+    summary.first_payment = summary.last_payment = payment;
+  } else {
+    Schedule schedule = CalculateDifferentiated(info);
+    Wide term = static_cast<Wide>(info.term);
+    Wide cents = FloorSum(term + 1, schedule.c, schedule.a, schedule.b) -
+                 schedule.b / schedule.c;
+    summary.total_payment = static_cast<double>(cents) / 100.0;
+    summary.total_interest = summary.total_payment - info.sum;
+    summary.first_payment = GetPayment(schedule, info.term);
+    summary.last_payment = GetPayment(schedule, 1);
   }
+  return summary;
+}
 
-  return plan;
+/**
+ * @brief Calculate a single payment of a credit.
+ *
+ * @param info The credit parameters including sum, rate, term, and type.
+ * @param month The number of the payment, from 1 to the term.
+ * @return The payment, equal to the one of the PaymentPlan.
+ * @throws std::invalid_argument if any of the input parameters are invalid.
+ * @throws std::out_of_range if the month is not within the term.
+ */
+double CreditCalc::GetPayment(const CreditInfo& info, int month) {
+  Validate(info);
+  if (month < 1 || month > info.term) {
+    throw std::out_of_range("Month out of the credit term");
+  }
+  if (info.type == CreditType::kAnnuity) {
+    return CalculateAnnuity(info);
+  }
+  return GetPayment(CalculateDifferentiated(info), info.term - month + 1);
 }
 
 /**
- * @brief Calculate annuity credit payments.
+ * @brief Calculate the balance of a credit after a number of payments.
  *
- * This method calculates annuity credit payments based on the provided credit
- * parameters.
+ * @param info The credit parameters including sum, rate, term, and type.
+ * @param month The number of payments made, from 0 to the term.
+ * @return The remaining balance, equal to the one of the PaymentPlan.
+ * @throws std::invalid_argument if any of the input parameters are invalid.
+ * @throws std::out_of_range if the month is not within the term.
+ */
+double CreditCalc::GetBalance(const CreditInfo& info, int month) {
+  Validate(info);
+  if (month < 0 || month > info.term) {
+    throw std::out_of_range("Month out of the credit term");
+  }
+  if (info.type == CreditType::kAnnuity) {
+    return CalculateAnnuityBalance(info, CalculateAnnuity(info), month);
+  }
+  return info.sum * (info.term - month) / info.term;
+}
+
+/**
+ * @brief Check the credit parameters.
+ *
+ * @throws std::invalid_argument if any of the input parameters are invalid.
+ */
+void CreditCalc::Validate(const CreditInfo& info) {
+  if (info.sum <= 0.0 || info.rate <= 0.0 || info.term <= 0) {
+    throw std::invalid_argument("Invalid credit parameters");
+  }
+}
+
+/**
+ * @brief Calculate the monthly payment of an annuity credit.
  *
  * @param info The credit parameters including sum, rate, and term.
- * @return A vector of monthly payments.
+ * @return The monthly payment rounded to a cent.
  */
-std::vector<double> CreditCalc::CalculateAnnuity(const CreditInfo& info) {
-  std::vector<double> payments;
+double CreditCalc::CalculateAnnuity(const CreditInfo& info) {
   double monthly_payment =
       info.sum *
       (info.rate / 12.0 / 100.0 *
        std::pow(1 + info.rate / 12.0 / 100.0, info.term)) /
       (std::pow(1 + info.rate / 12.0 / 100.0, info.term) - 1);
-  monthly_payment = std::round(monthly_payment * 100.0) / 100.0;
-  payments.resize(info.term, monthly_payment);
-  return payments;
+  return std::round(monthly_payment * 100.0) / 100.0;
 }
 
 /**
- * @brief Calculate differentiated credit payments.
+ * @brief Calculate the balance of an annuity credit after a number of
+ * payments.
  *
- * This method calculates differentiated credit payments based on the provided
- * credit parameters.
+ * The balance grows by the monthly rate and falls by the payment every
+ * month, which sums up to a geometric series.
  *
  * @param info The credit parameters including sum, rate, and term.
- * @return A vector of monthly payments.
+ * @param payment The monthly payment.
+ * @param month The number of payments made.
+ * @return The remaining balance.
  */
-std::vector<double> CreditCalc::CalculateDifferentiated(
+double CreditCalc::CalculateAnnuityBalance(const CreditInfo& info,
+                                           double payment, int month) {
+  double monthly_rate = info.rate / 12.0 / 100.0;
+  double growth = std::pow(1 + monthly_rate, month);
+  return info.sum * growth - payment * (growth - 1) / monthly_rate;
+}
+
+/**
+ * @brief Calculate the payment schedule of a differentiated credit.
+ *
+ * The payment of a month with j months left is sum / term * (1 + rate * j),
+ * with the monthly rate. The schedule is computed exactly in integers from
+ * the sum in cents and the annual rate in units of 1 / kRateScale percent,
+ * so that a single payment and the sum of all of them are rounded
+ * identically.
+ *
+ * @param info The credit parameters including sum, rate, and term.
+ * @return The coefficients of the payments in cents.
+ */
+CreditCalc::Schedule CreditCalc::CalculateDifferentiated(
     const CreditInfo& info) {
-  std::vector<double> payments;
-  double principal = info.sum / info.term;
-  double balance = info.sum;
-
-  for (int i = 0; i < info.term; ++i) {
-    double interest = balance * info.rate / 12.0 / 100.0;
-    double monthly_payment = std::round((principal + interest) * 100.0) / 100.0;
-    payments.push_back(monthly_payment);
-    balance -= principal;
-  }
+  Wide sum = static_cast<Wide>(std::llround(info.sum * 100.0));
+  Wide rate = static_cast<Wide>(std::llround(info.rate * kRateScale));
+  Wide term = static_cast<Wide>(info.term);
+  Wide scale = static_cast<Wide>(1200.0 * kRateScale);
+  return {2 * sum * rate, 2 * sum * scale + term * scale, 2 * term * scale};
+}
 
-  return payments;
+/**
+ * @brief Calculate a payment of a differentiated credit.
+ *
+ * @param schedule The payment schedule of the credit.
+ * @param left The number of months left, including the current one.
+ * @return The payment rounded to a cent.
+ */
+double CreditCalc::GetPayment(const Schedule& schedule, int left) {
+  Wide cents = (schedule.a * static_cast<Wide>(left) + schedule.b) / schedule.c;
+  return static_cast<double>(cents) / 100.0;
+}
+
+/**
+ * @brief Sum floor((a * i + b) / m) over i from 0 to n - 1.
+ *
+ * The quotients of a and b by m are summed directly, and the rest of the sum
+ * counts the lattice points below a line, which is the same sum with the
+ * roles of a and m swapped. Like the Euclidean algorithm this takes
+ * O(log m) steps.
+ */
+CreditCalc::Wide CreditCalc::FloorSum(Wide n, Wide m, Wide a, Wide b) {
+  Wide sum = 0;
+  while (true) {
+    if (a >= m) {
+      sum += n * (n - 1) / 2 * (a / m);
+      a %= m;
+    }
+    if (b >= m) {
+      sum += n * (b / m);
+      b %= m;
+    }
+    Wide y_max = a * n + b;
+    if (y_max < m) {
+      break;
+    }
+    n = y_max / m;
+    b = y_max % m;
+    std::swap(m, a);
+  }
+  return sum;
 }
 
 /**
  * @brief Generate dates for the credit payment plan.
  *
  * This method generates dates for each payment in the credit payment plan.
+ * The first payment is due today and the next ones on the same day of the
+ * following months, or on the last day of shorter months.
  *
  * @param term The loan term in months.
- * @return A vector of strings representing dates in the format "Month Year".
+ * @return A vector of the payment dates.
  */
-std::vector<std::string> CreditCalc::GenerateDates(int term) {
-  std::vector<std::string> dates;
-  auto time =
-      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  std::tm* date = std::localtime(&time);
-  int month = date->tm_mon;
-  int year = date->tm_year + 1900;
-
+std::vector<Date> CreditCalc::GenerateDates(int term) {
+  std::vector<Date> dates;
+  dates.reserve(term);
+  Date today = Date::Today();
   for (int i = 0; i < term; ++i) {
-    std::stringstream ss;
-    ss << std::put_time(date, "%B %Y");
-    dates.push_back(ss.str());
-
-    ++month;
-    if (month >= 12) {
-      month = 0;
-      ++year;
-    }
-
-    date->tm_mon = month;
-    date->tm_year = year - 1900;
-    time = std::mktime(date);
-    date = std::localtime(&time);
+    dates.push_back(today.AddMonths(i, today.GetDay()));
   }
-
   return dates;
 }
 
@@ -1,13 +1,13 @@
 #ifndef SMARTCALC_MODEL_CREDIT_CALC_H_
 #define SMARTCALC_MODEL_CREDIT_CALC_H_
 
-#include <chrono>
 #include <cmath>
-#include <iomanip>
-#include <sstream>
-#include <string>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include "date.h"
+
 namespace s21 {
 
 /**
@@ -18,6 +18,11 @@ namespace s21 {
  * payments, including annuity and differentiated payments, based on the
  * provided credit parameters. It supports both annuity and differentiated
  * repayment methods.
+ *
+ * Every month of a credit is given by a closed formula, so the totals, single
+ * payments and balances are available through Summarize, GetPayment and
+ * GetBalance without building the PaymentPlan, which is only needed to
+ * display the whole plan. Both produce exactly the same values.
  */
 class CreditCalc {
  public:
@@ -47,19 +52,61 @@ class CreditCalc {
    * balances.
    */
   struct PaymentPlan {
-    std::vector<std::string> dates;
+    std::vector<Date> dates;
     std::vector<double> payments;
     std::vector<double> principals;
     std::vector<double> interests;
     std::vector<double> balances;
   };
 
+  /**
+   * @struct Summary
+   * @brief Structure for holding the totals of a credit.
+   *
+   * The total interest is the overpayment, the total payment minus the part
+   * of the sum that was repaid.
+   */
+  struct Summary {
+    double total_payment;
+    double total_interest;
+    double first_payment;
+    double last_payment;
+  };
+
   static PaymentPlan Calculate(const CreditInfo& info);
+  static Summary Summarize(const CreditInfo& info);
+  static double GetPayment(const CreditInfo& info, int month);
+  static double GetBalance(const CreditInfo& info, int month);
 
  private:
-  static std::vector<double> CalculateAnnuity(const CreditInfo& info);
-  static std::vector<double> CalculateDifferentiated(const CreditInfo& info);
-  static std::vector<std::string> GenerateDates(int term);
+  friend class CreditPortfolio;
+
+  __extension__ typedef unsigned __int128 Wide;
+
+  /**
+   * @struct Schedule
+   * @brief The payments of a differentiated credit in cents.
+   *
+   * The payment of a month with j months left, including the current one,
+   * is floor((a * j + b) / c) cents, which is the exact payment rounded half
+   * up to a cent.
+   */
+  struct Schedule {
+    Wide a;
+    Wide b;
+    Wide c;
+  };
+
+  static constexpr double kRateScale = 1e9;
+
+  static void Validate(const CreditInfo& info);
+  static double CalculateAnnuity(const CreditInfo& info);
+  static double CalculateAnnuityBalance(const CreditInfo& info, double payment,
+                                        int month);
+  static Schedule CalculateDifferentiated(const CreditInfo& info);
+  static double GetPayment(const Schedule& schedule, int left);
+  static Wide FloorSum(Wide n, Wide m, Wide a, Wide b);
+  static std::vector<Date> GenerateDates(int term);
 };
 }  // namespace s21
 
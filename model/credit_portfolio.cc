@@ -0,0 +1,282 @@
+#include "credit_portfolio.h"
+
+namespace s21 {
+
+/**
+ * @brief Calculate the positions of the payment plans in the flat columns.
+ *
+ * @param loans The parameters of the portfolio.
+ * @return size + 1 offsets, where the plan of the i-th loan occupies the
+ * entries from offsets[i] to offsets[i + 1] and the last offset is the total
+ * number of payments.
+ * @throws std::invalid_argument if the parameters of any loan are invalid.
+ */
+std::vector<std::size_t> CreditPortfolio::GetOffsets(const Loans& loans) {
+  Validate(loans);
+  std::vector<std::size_t> offsets(loans.size + 1, 0);
+  for (std::size_t i = 0; i < loans.size; ++i) {
+    offsets[i + 1] = offsets[i] + static_cast<std::size_t>(loans.terms[i]);
+  }
+  return offsets;
+}
+
+/**
+ * @brief Calculate the totals of every loan without their payment plans.
+ *
+ * All loans are checked before anything is written, so the output columns
+ * are left untouched if any of them is invalid.
+ *
+ * @param loans The parameters of the portfolio.
+ * @param summaries The output columns, equal to CreditCalc::Summarize for
+ * every loan.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @throws std::invalid_argument if the parameters of any loan are invalid.
+ */
+void CreditPortfolio::Summarize(const Loans& loans, const Summaries& summaries,
+                                std::size_t threads) {
+  Validate(loans);
+  ForEachChunk(loans.size, threads, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      CreditCalc::Summary summary = CreditCalc::Summarize(GetInfo(loans, i));
+      if (summaries.total_payments) {
+        summaries.total_payments[i] = summary.total_payment;
+      }
+      if (summaries.total_interests) {
+        summaries.total_interests[i] = summary.total_interest;
+      }
+      if (summaries.first_payments) {
+        summaries.first_payments[i] = summary.first_payment;
+      }
+      if (summaries.last_payments) {
+        summaries.last_payments[i] = summary.last_payment;
+      }
+    }
+  });
+}
+
+/**
+ * @brief Calculate the totals of a whole portfolio.
+ *
+ * The totals of every chunk are accumulated separately and added up in the
+ * order of the chunks, so the result does not depend on the number of
+ * threads.
+ *
+ * @param loans The parameters of the portfolio.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return The number of loans and payments, the sum of all loans and the sum
+ * of their total payments and interests.
+ * @throws std::invalid_argument if the parameters of any loan are invalid.
+ */
+CreditPortfolio::Totals CreditPortfolio::Aggregate(const Loans& loans,
+                                                   std::size_t threads) {
+  Validate(loans);
+  std::vector<Totals> partial((loans.size + kChunkSize - 1) / kChunkSize);
+  ForEachChunk(loans.size, threads, [&](std::size_t begin, std::size_t end) {
+    Totals& totals = partial[begin / kChunkSize];
+    for (std::size_t i = begin; i < end; ++i) {
+      CreditCalc::Summary summary = CreditCalc::Summarize(GetInfo(loans, i));
+      totals.payments += static_cast<std::size_t>(loans.terms[i]);
+      totals.sum += loans.sums[i];
+      totals.total_payment += summary.total_payment;
+      totals.total_interest += summary.total_interest;
+    }
+    totals.loans = end - begin;
+  });
+
+  Totals totals;
+  for (const Totals& chunk : partial) {
+    totals.loans += chunk.loans;
+    totals.payments += chunk.payments;
+    totals.sum += chunk.sum;
+    totals.total_payment += chunk.total_payment;
+    totals.total_interest += chunk.total_interest;
+  }
+  return totals;
+}
+
+/**
+ * @brief Calculate the payment plans of all loans into flat columns.
+ *
+ * Within a chunk the annuity credits are collected into groups of kGroupSize
+ * and amortized together, while the differentiated ones are written as they
+ * come. The last incomplete group is padded with its last loan, which is
+ * simply written twice. All loans are checked before anything is written.
+ *
+ * @param loans The parameters of the portfolio.
+ * @param offsets The positions of the plans, as returned by GetOffsets.
+ * @param schedules The output columns, with offsets[loans.size] entries each.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @throws std::invalid_argument if the parameters of any loan are invalid.
+ */
+void CreditPortfolio::Calculate(const Loans& loans, const std::size_t* offsets,
+                                const Schedules& schedules,
+                                std::size_t threads) {
+  Validate(loans);
+  ForEachChunk(loans.size, threads, [&](std::size_t begin, std::size_t end) {
+    std::size_t group[kGroupSize];
+    std::size_t count = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+      if (loans.types[i] == CreditCalc::CreditType::kDifferentiated) {
+        CalculateDifferentiated(loans, i, offsets, schedules);
+        continue;
+      }
+      group[count++] = i;
+      if (count == kGroupSize) {
+        CalculateAnnuities(loans, group, offsets, schedules);
+        count = 0;
+      }
+    }
+    if (count) {
+      std::fill(group + count, group + kGroupSize, group[count - 1]);
+      CalculateAnnuities(loans, group, offsets, schedules);
+    }
+  });
+}
+
+/**
+ * @brief Check the parameters of every loan.
+ *
+ * @throws std::invalid_argument if the parameters of any loan are invalid.
+ */
+void CreditPortfolio::Validate(const Loans& loans) {
+  for (std::size_t i = 0; i < loans.size; ++i) {
+    CreditCalc::Validate(GetInfo(loans, i));
+  }
+}
+
+/**
+ * @brief Gather the parameters of a loan from the columns.
+ */
+CreditCalc::CreditInfo CreditPortfolio::GetInfo(const Loans& loans,
+                                                std::size_t i) {
+  return {loans.sums[i], loans.rates[i], loans.terms[i], loans.types[i]};
+}
+
+/**
+ * @brief Runs a task for every chunk of kChunkSize loans.
+ *
+ * @param size The number of loans.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @param task The function called with the first and the past-the-end loan
+ * of every chunk.
+ */
+void CreditPortfolio::ForEachChunk(
+    std::size_t size, std::size_t threads,
+    const std::function<void(std::size_t, std::size_t)>& task) {
+  std::size_t chunks = (size + kChunkSize - 1) / kChunkSize;
+  auto run_chunk = [&](std::size_t chunk) {
+    std::size_t begin = chunk * kChunkSize;
+    task(begin, std::min(begin + kChunkSize, size));
+  };
+
+  if (threads == 1 || chunks <= 1) {
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+      run_chunk(chunk);
+    }
+  } else {
+    ThreadPool::Shared().ParallelFor(chunks, run_chunk, threads);
+  }
+}
+
+/**
+ * @brief Calculate the payment plans of a group of annuity credits.
+ *
+ * Every lane holds one loan, and the group runs for the longest term in it;
+ * the months past the term of a loan are computed but not written. The
+ * payments are rounded by CreditCalc, and the balance of every month is
+ * given by the same geometric series. The growth of the balance is
+ * multiplied by one plus the monthly rate every month instead of being
+ * raised to the power of the month, so after k months its relative error is
+ * at most k rounding errors.
+ *
+ * @param group The indices of kGroupSize annuity credits.
+ */
+void CreditPortfolio::CalculateAnnuities(const Loans& loans,
+                                         const std::size_t* group,
+                                         const std::size_t* offsets,
+                                         const Schedules& schedules) {
+  Double2 sum[kWidth], rate[kWidth], base[kWidth], payment[kWidth];
+  Double2 growth[kWidth], previous[kWidth], interest[kWidth], balance[kWidth];
+  int term = 0;
+
+  for (std::size_t j = 0; j < kGroupSize; ++j) {
+    CreditCalc::CreditInfo info = GetInfo(loans, group[j]);
+    std::size_t w = j / Math::kLanes, lane = j % Math::kLanes;
+    double monthly_rate = info.rate / 12.0 / 100.0;
+    sum[w][lane] = info.sum;
+    rate[w][lane] = monthly_rate;
+    base[w][lane] = 1 + monthly_rate;
+    payment[w][lane] = CreditCalc::CalculateAnnuity(info);
+    term = std::max(term, info.term);
+  }
+  std::copy(sum, sum + kWidth, previous);
+  std::fill(growth, growth + kWidth, Math::Broadcast(1.0));
+
+  for (int month = 1; month <= term; ++month) {
+    for (std::size_t w = 0; w < kWidth; ++w) {
+      growth[w] *= base[w];
+      interest[w] = previous[w] * rate[w];
+      balance[w] =
+          sum[w] * growth[w] - payment[w] * (growth[w] - 1.0) / rate[w];
+      previous[w] = balance[w];
+    }
+
+    for (std::size_t j = 0; j < kGroupSize; ++j) {
+      if (month > loans.terms[group[j]]) {
+        continue;
+      }
+      std::size_t w = j / Math::kLanes, lane = j % Math::kLanes;
+      std::size_t k = offsets[group[j]] + static_cast<std::size_t>(month) - 1;
+      if (schedules.payments) {
+        schedules.payments[k] = payment[w][lane];
+      }
+      if (schedules.principals) {
+        schedules.principals[k] = payment[w][lane] - interest[w][lane];
+      }
+      if (schedules.interests) {
+        schedules.interests[k] = interest[w][lane];
+      }
+      if (schedules.balances) {
+        schedules.balances[k] = balance[w][lane];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Calculate the payment plan of a differentiated credit.
+ *
+ * The payments come from the same integer schedule as in CreditCalc, so the
+ * plan is identical to its PaymentPlan.
+ */
+void CreditPortfolio::CalculateDifferentiated(const Loans& loans,
+                                              std::size_t i,
+                                              const std::size_t* offsets,
+                                              const Schedules& schedules) {
+  CreditCalc::CreditInfo info = GetInfo(loans, i);
+  CreditCalc::Schedule schedule = CreditCalc::CalculateDifferentiated(info);
+  double principal = info.sum / info.term;
+
+  for (int month = 1; month <= info.term; ++month) {
+    std::size_t k = offsets[i] + static_cast<std::size_t>(month) - 1;
+    double payment = CreditCalc::GetPayment(schedule, info.term - month + 1);
+    if (schedules.payments) {
+      schedules.payments[k] = payment;
+    }
+    if (schedules.principals) {
+      schedules.principals[k] = principal;
+    }
+    if (schedules.interests) {
+      schedules.interests[k] = payment - principal;
+    }
+    if (schedules.balances) {
+      schedules.balances[k] = info.sum * (info.term - month) / info.term;
+    }
+  }
+}
+
+}  // namespace s21
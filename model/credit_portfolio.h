@@ -0,0 +1,122 @@
+#ifndef SMARTCALC_MODEL_CREDIT_PORTFOLIO_H_
+#define SMARTCALC_MODEL_CREDIT_PORTFOLIO_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "credit_calc.h"
+#include "thread_pool.h"
+#include "vector_math.h"
+
+namespace s21 {
+
+/**
+ * @class CreditPortfolio
+ * @brief Calculates credits in bulk, for portfolios of millions of loans.
+ *
+ * The loans are passed as columns, one array per parameter, and the results
+ * are written to columns preallocated by the caller, so no memory is
+ * allocated per loan. The loans are processed in chunks of kChunkSize,
+ * distributed over the shared ThreadPool.
+ *
+ * Summarize and Aggregate use the closed formulas of CreditCalc and give
+ * exactly the same totals as CreditCalc::Summarize, regardless of the number
+ * of threads. Calculate writes the payment plans of all loans into flat
+ * columns, one after another. The annuity credits of a chunk are amortized
+ * side by side, kGroupSize loans per group of vectors, so every month of the
+ * group takes a few vector instructions. Their payments are those of
+ * CreditCalc, while their interests and balances may differ from it by a
+ * rounding error per month, as the growth of the balance is accumulated
+ * month by month. Differentiated credits are computed in integers and are
+ * identical to their PaymentPlan.
+ */
+class CreditPortfolio {
+ public:
+  /**
+   * @struct Loans
+   * @brief The columns of the parameters of a portfolio.
+   *
+   * The parameters of the i-th loan are the i-th entries of the columns,
+   * which each hold size values.
+   */
+  struct Loans {
+    const double* sums;
+    const double* rates;
+    const int* terms;
+    const CreditCalc::CreditType* types;
+    std::size_t size;
+  };
+
+  /**
+   * @struct Summaries
+   * @brief The output columns for the totals of every loan.
+   *
+   * Every column receives one value per loan and may be nullptr if it is not
+   * needed.
+   */
+  struct Summaries {
+    double* total_payments = nullptr;
+    double* total_interests = nullptr;
+    double* first_payments = nullptr;
+    double* last_payments = nullptr;
+  };
+
+  /**
+   * @struct Schedules
+   * @brief The output columns for the payment plans of all loans.
+   *
+   * The plan of the i-th loan occupies the entries from offsets[i] to
+   * offsets[i + 1] of every column, as returned by GetOffsets. Every column
+   * may be nullptr if it is not needed.
+   */
+  struct Schedules {
+    double* payments = nullptr;
+    double* principals = nullptr;
+    double* interests = nullptr;
+    double* balances = nullptr;
+  };
+
+  /**
+   * @struct Totals
+   * @brief The totals of a whole portfolio.
+   */
+  struct Totals {
+    std::size_t loans = 0;
+    std::size_t payments = 0;
+    double sum = 0.0;
+    double total_payment = 0.0;
+    double total_interest = 0.0;
+  };
+
+  static std::vector<std::size_t> GetOffsets(const Loans& loans);
+  static void Summarize(const Loans& loans, const Summaries& summaries,
+                        std::size_t threads = 0);
+  static Totals Aggregate(const Loans& loans, std::size_t threads = 0);
+  static void Calculate(const Loans& loans, const std::size_t* offsets,
+                        const Schedules& schedules, std::size_t threads = 0);
+
+ private:
+  using Math = VectorMath<Double2>;
+
+  static constexpr std::size_t kChunkSize = 1024;
+  static constexpr std::size_t kWidth = 4;
+  static constexpr std::size_t kGroupSize = Math::kLanes * kWidth;
+
+  static void Validate(const Loans& loans);
+  static CreditCalc::CreditInfo GetInfo(const Loans& loans, std::size_t i);
+  static void ForEachChunk(
+      std::size_t size, std::size_t threads,
+      const std::function<void(std::size_t, std::size_t)>& task);
+  static void CalculateAnnuities(const Loans& loans, const std::size_t* group,
+                                 const std::size_t* offsets,
+                                 const Schedules& schedules);
+  static void CalculateDifferentiated(const Loans& loans, std::size_t i,
+                                      const std::size_t* offsets,
+                                      const Schedules& schedules);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_CREDIT_PORTFOLIO_H_
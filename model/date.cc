@@ -0,0 +1,91 @@
+#include "date.h"
+
+namespace s21 {
+
+/**
+ * @brief Parses a date in the format "%d-%m-%Y", such as "02-10-2023".
+ *
+ * The day and the month may have one or two digits and the year up to four.
+ *
+ * @param text The date.
+ * @return The parsed date.
+ * @throws std::runtime_error If the text is not a valid date in this format.
+ */
+Date Date::Parse(const std::string& text) {
+  int fields[3] = {};
+  const int max_digits[3] = {2, 2, 4};
+  std::size_t pos = 0;
+
+  for (int i = 0; i < 3; ++i) {
+    if (i > 0 && (pos >= text.size() || text[pos++] != '-')) {
+      throw std::runtime_error("Invalid date format");
+    }
+    int digits = 0;
+    for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9' &&
+           digits < max_digits[i];
+         ++pos, ++digits) {
+      fields[i] = fields[i] * 10 + (text[pos] - '0');
+    }
+    if (digits == 0) {
+      throw std::runtime_error("Invalid date format");
+    }
+  }
+
+  int day = fields[0], month = fields[1], year = fields[2];
+  if (pos != text.size() || month < 1 || month > 12 || day < 1 ||
+      day > DaysInMonth(year, month)) {
+    throw std::runtime_error("Invalid date format");
+  }
+  return Date(year, month, day);
+}
+
+/**
+ * @brief Returns the current date in the local time zone.
+ *
+ * This is the only function of Date that depends on the time zone. It uses
+ * the reentrant localtime_r, so it may be called by several threads at once.
+ */
+Date Date::Today() {
+  std::time_t time = std::time(nullptr);
+  std::tm local = {};
+  localtime_r(&time, &local);
+  return Date(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+/**
+ * @brief Formats the date as "%d-%m-%Y", the format read by Parse.
+ */
+std::string Date::ToString() const {
+  Civil civil = ToCivil();
+  char text[48];
+  std::snprintf(text, sizeof(text), "%02d-%02d-%04d", civil.day, civil.month,
+                civil.year);
+  return text;
+}
+
+/**
+ * @brief Formats the date with the conversion specifiers of std::put_time.
+ *
+ * The names of months and days are those of the classic locale, so
+ * Format("%B %Y") gives "October 2023". Specifiers of the time of day
+ * format midnight.
+ *
+ * @param format The format, such as "%d %B %Y".
+ * @return The formatted date.
+ */
+std::string Date::Format(const char* format) const {
+  Civil civil = ToCivil();
+  std::tm time = {};
+  time.tm_year = civil.year - 1900;
+  time.tm_mon = civil.month - 1;
+  time.tm_mday = civil.day;
+  time.tm_wday = (days_ % 7 + 11) % 7;
+  time.tm_yday = days_ - Date(civil.year, 1, 1).days_;
+
+  std::ostringstream oss;
+  oss.imbue(std::locale::classic());
+  oss << std::put_time(&time, format);
+  return oss.str();
+}
+
+}  // namespace s21
@@ -0,0 +1,257 @@
+#ifndef SMARTCALC_MODEL_DATE_H_
+#define SMARTCALC_MODEL_DATE_H_
+
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace s21 {
+
+/**
+ * @class Date
+ * @brief A calendar date in the proleptic Gregorian calendar.
+ *
+ * A Date is the number of days since 1 January 1970, so comparing two dates
+ * or counting the days between them is a single integer operation. The year,
+ * month and day are converted to and from the number of days with the
+ * closed formulas of the civil calendar, which count whole eras of 400
+ * years and take constant time. Dates have no time of day and no time zone,
+ * so they do not depend on daylight saving time or on the environment, and
+ * every operation is constexpr and thread-safe.
+ *
+ * Text is only involved when a date is parsed with Parse or formatted with
+ * ToString and Format.
+ */
+class Date {
+ public:
+  constexpr Date() = default;
+  constexpr Date(int year, int month, int day);
+
+  static constexpr Date FromDays(int days);
+  static Date Parse(const std::string& text);
+  static Date Today();
+
+  constexpr int GetDays() const { return days_; }
+  constexpr int GetYear() const;
+  constexpr int GetMonth() const;
+  constexpr int GetDay() const;
+  constexpr int DaysInMonth() const;
+  constexpr int DaysInYear() const;
+  constexpr Date AddDays(int days) const;
+  constexpr Date AddMonths(int months) const;
+  constexpr Date AddMonths(int months, int day) const;
+
+  static constexpr bool IsLeapYear(int year);
+  static constexpr int DaysInMonth(int year, int month);
+
+  std::string ToString() const;
+  std::string Format(const char* format) const;
+
+  constexpr int operator-(const Date& other) const {
+    return days_ - other.days_;
+  }
+  constexpr bool operator==(const Date& other) const {
+    return days_ == other.days_;
+  }
+  constexpr bool operator!=(const Date& other) const {
+    return days_ != other.days_;
+  }
+  constexpr bool operator<(const Date& other) const {
+    return days_ < other.days_;
+  }
+  constexpr bool operator<=(const Date& other) const {
+    return days_ <= other.days_;
+  }
+  constexpr bool operator>(const Date& other) const {
+    return days_ > other.days_;
+  }
+  constexpr bool operator>=(const Date& other) const {
+    return days_ >= other.days_;
+  }
+
+ private:
+  /**
+   * @struct Civil
+   * @brief The year, month from 1 to 12 and day of a date.
+   */
+  struct Civil {
+    int year;
+    int month;
+    int day;
+  };
+
+  static constexpr int kDaysPerEra = 146097;
+  static constexpr int kEpochShift = 719468;
+
+  static constexpr int FloorDivide(int a, int b);
+  static constexpr int DaysFromCivil(int year, int month, int day);
+  constexpr Civil ToCivil() const;
+
+  int days_ = 0;
+};
+
+/**
+ * @brief Constructs the date of a year, month and day.
+ *
+ * The month and the day are normalized like std::mktime does: months outside
+ * 1 to 12 move to other years and days past the end of the month continue
+ * into the following months, so 31 November is 1 December.
+ *
+ * @param year The year.
+ * @param month The month, 1 for January.
+ * @param day The day of the month, starting at 1.
+ */
+constexpr Date::Date(int year, int month, int day)
+    : days_(DaysFromCivil(year + FloorDivide(month - 1, 12),
+                          month - 1 - FloorDivide(month - 1, 12) * 12 + 1,
+                          1) +
+            day - 1) {}
+
+/**
+ * @brief Constructs a date from the number of days since 1 January 1970.
+ */
+constexpr Date Date::FromDays(int days) {
+  Date date;
+  date.days_ = days;
+  return date;
+}
+
+/**
+ * @brief Returns the year of the date.
+ */
+constexpr int Date::GetYear() const { return ToCivil().year; }
+
+/**
+ * @brief Returns the month of the date, 1 for January.
+ */
+constexpr int Date::GetMonth() const { return ToCivil().month; }
+
+/**
+ * @brief Returns the day of the month of the date, starting at 1.
+ */
+constexpr int Date::GetDay() const { return ToCivil().day; }
+
+/**
+ * @brief Returns the number of days in the month of the date.
+ */
+constexpr int Date::DaysInMonth() const {
+  Civil civil = ToCivil();
+  return DaysInMonth(civil.year, civil.month);
+}
+
+/**
+ * @brief Returns the number of days in the year of the date.
+ */
+constexpr int Date::DaysInYear() const {
+  return IsLeapYear(GetYear()) ? 366 : 365;
+}
+
+/**
+ * @brief Returns the date a number of days later, or earlier if negative.
+ */
+constexpr Date Date::AddDays(int days) const {
+  return FromDays(days_ + days);
+}
+
+/**
+ * @brief Returns the same day a number of months later.
+ *
+ * A day that does not exist in the resulting month continues into the next
+ * one, like in the constructor, so one month after 31 October is 1 December.
+ *
+ * @param months The number of months, which may be negative.
+ */
+constexpr Date Date::AddMonths(int months) const {
+  Civil civil = ToCivil();
+  return Date(civil.year, civil.month + months, civil.day);
+}
+
+/**
+ * @brief Returns a given day of the month a number of months later.
+ *
+ * The day is limited to the length of the resulting month, so a monthly
+ * schedule on the 31st falls on the last day of shorter months.
+ *
+ * @param months The number of months, which may be negative.
+ * @param day The day of the month, starting at 1.
+ */
+constexpr Date Date::AddMonths(int months, int day) const {
+  Civil civil = Date(GetYear(), GetMonth() + months, 1).ToCivil();
+  int last = DaysInMonth(civil.year, civil.month);
+  return Date(civil.year, civil.month, day < last ? day : last);
+}
+
+/**
+ * @brief Checks if a year is a leap year in the Gregorian calendar.
+ */
+constexpr bool Date::IsLeapYear(int year) {
+  return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+/**
+ * @brief Returns the number of days in a month.
+ *
+ * @param year The year, which decides the length of February.
+ * @param month The month, 1 for January.
+ */
+constexpr int Date::DaysInMonth(int year, int month) {
+  constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && IsLeapYear(year) ? 29 : kDays[month - 1];
+}
+
+/**
+ * @brief Divides two integers, rounding the quotient toward negative
+ * infinity.
+ */
+constexpr int Date::FloorDivide(int a, int b) {
+  return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+/**
+ * @brief Converts a year, month and day to the number of days since
+ * 1 January 1970.
+ *
+ * The year is shifted to start in March, so that the leap day is the last
+ * day of the year and the days before a month of the shifted year are the
+ * linear function (153 * month + 2) / 5.
+ */
+constexpr int Date::DaysFromCivil(int year, int month, int day) {
+  year -= month <= 2;
+  int era = FloorDivide(year, 400);
+  int year_of_era = year - era * 400;
+  int shifted_month = month > 2 ? month - 3 : month + 9;
+  int day_of_year = (153 * shifted_month + 2) / 5 + day - 1;
+  int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 +
+                   day_of_year;
+  return era * kDaysPerEra + day_of_era - kEpochShift;
+}
+
+/**
+ * @brief Converts the date to its year, month and day.
+ *
+ * This is the inverse of DaysFromCivil: the era and the day within it give
+ * the year of the era, counting the leap days of the 4, 100 and 400 year
+ * cycles, and the day of the shifted year gives the month.
+ */
+constexpr Date::Civil Date::ToCivil() const {
+  int days = days_ + kEpochShift;
+  int era = FloorDivide(days, kDaysPerEra);
+  int day_of_era = days - era * kDaysPerEra;
+  int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+                     day_of_era / (kDaysPerEra - 1)) /
+                    365;
+  int day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  int shifted_month = (5 * day_of_year + 2) / 153;
+  int month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  return {year_of_era + era * 400 + (month <= 2),
+          month, day_of_year - (153 * shifted_month + 2) / 5 + 1};
+}
+
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_DATE_H_
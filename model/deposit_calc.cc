@@ -5,9 +5,8 @@ namespace s21 {
 /**
  * @brief Calculates the payment plan for a given deposit information.
  *
- * This method calculates the payment plan based on the provided DepositInfo.
- * It generates interest dates and transactions, processes them, and calculates
- * the balance, interest, and transactions for each date.
+ * This method collects the rows of a PlanGenerator into a PaymentPlan and
+ * passes them to a TaxCalculator for the taxes of every year.
  *
  * @param info The deposit information including principal amount, interest
  * rate, and transaction details.
@@ -19,590 +18,388 @@ namespace s21 {
  */
 DepositCalc::PaymentPlan DepositCalc::Calculate(const DepositInfo& info) {
   PaymentPlan plan;
-  auto interest_dates = GenerateInterestDates(info);
-  auto transactions = GenerateTransactions(info);
-
-  auto interests_it = interest_dates.begin();
-  auto transactions_it = transactions.begin();
-
-  double balance = info.sum;
-  std::string prev_date = info.date;
-  double cumulated_interest = 0.0;
-
-  auto process_interests = [&]() {
-    std::string current_date = *interests_it;
-    double interest =
-        cumulated_interest +
-        CalculateInterest(prev_date, current_date, info.rate, balance);
-    cumulated_interest = 0.0;
-    ++interests_it;
-    return std::make_pair(current_date, interest);
-  };
-
-  auto process_transactions = [&]() {
-    std::string current_date = transactions_it->first;
-    double transaction = transactions_it->second;
-    cumulated_interest +=
-        CalculateInterest(prev_date, current_date, info.rate, balance);
-    ++transactions_it;
-    return std::make_pair(current_date, transaction);
-  };
-
-  while (interests_it != interest_dates.end() ||
-         transactions_it != transactions.end()) {
-    std::string current_date;
-    double interest = 0.0;
-    double transaction = 0.0;
-
-    if (interests_it != interest_dates.end() &&
-        transactions_it != transactions.end()) {
-      if (CompareDates(*interests_it, transactions_it->first) < 0) {
-        std::tie(current_date, interest) = process_interests();
-      } else {
-        std::tie(current_date, transaction) = process_transactions();
-      }
-    } else if (interests_it != interest_dates.end()) {
-      std::tie(current_date, interest) = process_interests();
-    } else {
-      std::tie(current_date, transaction) = process_transactions();
-    }
-
-    plan.dates.push_back(current_date);
-    plan.interests.push_back(interest);
-    plan.transactions.push_back(transaction);
-    if (info.capitalize) {
-      balance += interest + transaction;
-    } else {
-      balance += transaction;
-    }
-    plan.balances.push_back(balance);
-    prev_date = current_date;
+  PlanGenerator generator(info);
+  TaxCalculator tax(info.tax_rate);
+
+  Row row;
+  while (generator.Next(row)) {
+    plan.dates.push_back(row.date);
+    plan.interests.push_back(row.interest);
+    plan.transactions.push_back(row.transaction);
+    plan.balances.push_back(row.balance);
+    tax.Add(row);
   }
-  plan.transactions[0] += info.sum;
-  plan.tax_info = CalculateTax(plan, info);
+  plan.tax_info = tax.Finish();
 
   return plan;
 }
 
 /**
- * @brief Generates a vector of interest payment dates based on the provided
- * DepositInfo.
+ * @brief Constructor of the PlanGenerator class.
  *
- * This function generates interest payment dates according to the specified
- * payment period in the DepositInfo. The generated dates include the initial
- * date, accrued interest dates, and the maturity date.
+ * The interest dates depend on the payment period: the daily and weekly ones
+ * are counted in days from the initial date, and the others in months from
+ * the previous date. A payment at maturity is a single period of the whole
+ * term. The dates always start with the initial date and end with the
+ * maturity date.
  *
- * @param info The deposit information including initial date, term, and payment
- * period details.
- * @return A vector of strings representing the interest payment dates.
+ * Every transaction up to the maturity date starts a schedule, and
+ * transactions with the same first date and regularity share one, as they
+ * always fall on the same dates. The schedules are sorted by date, which
+ * makes them a heap ordered by their next dates.
  *
- * The function considers various payment periods such as daily, weekly,
- * monthly, quarterly, semi-annually, annually, and at maturity. The generated
- * dates are inclusive of the initial and maturity dates.
+ * @param info The deposit information, which must outlive the generator.
  */
-std::vector<std::string> DepositCalc::GenerateInterestDates(
-    const DepositInfo& info) {
-  std::vector<std::string> interest_dates;
-  std::string date = info.date;
-
-  auto generate_daily = [&](int step) {
-    int days = TermToDays(info.date, info.term);
-    for (int delta = 0; delta < days; delta += step) {
-      interest_dates.push_back(AddDays(info.date, delta));
-    }
-  };
-
-  auto generate_monthly = [&](int step) {
-    for (int delta = 0; delta < info.term; delta += step) {
-      interest_dates.push_back(date);
-      date = AddMonths(date, step);
-    }
-  };
-
-  if (info.period == PaymentPeriod::kAtMaturity) {
-    interest_dates.push_back(date);
-  } else if (info.period == PaymentPeriod::kDaily) {
-    generate_daily(1);
-  } else if (info.period == PaymentPeriod::kWeekly) {
-    generate_daily(7);
-  } else if (info.period == PaymentPeriod::kMonthly) {
-    generate_monthly(1);
-  } else if (info.period == PaymentPeriod::kQuarterly) {
-    generate_monthly(3);
-  } else if (info.period == PaymentPeriod::kSemiAnnually) {
-    generate_monthly(6);
-  } else if (info.period == PaymentPeriod::kAnnually) {
-    generate_monthly(12);
+DepositCalc::PlanGenerator::PlanGenerator(const DepositInfo& info)
+    : info_(&info),
+      maturity_(info.date.AddMonths(info.term)),
+      daily_(info.period == PaymentPeriod::kDaily ||
+             info.period == PaymentPeriod::kWeekly),
+      next_date_(info.date),
+      balance_(info.sum),
+      prev_date_(info.date) {
+  switch (info.period) {
+    case PaymentPeriod::kDaily:
+      step_ = 1;
+      break;
+    case PaymentPeriod::kWeekly:
+      step_ = 7;
+      break;
+    case PaymentPeriod::kMonthly:
+      step_ = 1;
+      break;
+    case PaymentPeriod::kQuarterly:
+      step_ = 3;
+      break;
+    case PaymentPeriod::kSemiAnnually:
+      step_ = 6;
+      break;
+    case PaymentPeriod::kAnnually:
+      step_ = 12;
+      break;
+    default:
+      step_ = info.term;
+      break;
   }
+  limit_ = daily_ ? maturity_ - info.date : info.term;
+  has_interest_ = NextInterestDate(interest_date_);
 
-  interest_dates.push_back(AddMonths(info.date, info.term));
-  return interest_dates;
-}
-
-/**
- * @brief Generates transactions map based on the provided DepositInfo.
- *
- * This function generates a map of transactions where keys represent
- * transaction dates and values represent the corresponding transaction amounts.
- * Transactions include both replenishments and withdrawals, adjusted based on
- * the specified regularity and term in the DepositInfo.
- *
- * @param info The deposit information including initial date, term, and
- * transaction details.
- * @return A map with transaction dates as keys and transaction amounts as
- * values.
- *
- * The function considers various regularities such as one-time, monthly,
- * bi-monthly, quarterly, semi-annually, and annually. Transactions are
- * generated based on the specified regularity and term in the DepositInfo.
- */
-std::map<std::string, double, DepositCalc::DatesComparator>
-DepositCalc::GenerateTransactions(const DepositInfo& info) {
-  std::map<std::string, double, DatesComparator> transactions_map;
-
-  auto get_step = [&info](Regularity regularity) {
-    switch (regularity) {
-      case Regularity::kOneTime:
-        return info.term;
-      case Regularity::kMonthly:
-        return 1;
-      case Regularity::kBiMonthly:
-        return 2;
-      case Regularity::kQuarterly:
-        return 3;
-      case Regularity::kSemiAnnually:
-        return 6;
-      case Regularity::kAnnually:
-        return 12;
-      default:
-        return 1;
+  schedules_.reserve(info.replenishments.size() + info.withdrawals.size());
+  for (const auto& transaction : info.replenishments) {
+    schedules_.push_back({transaction.date, transaction.date.GetDay(),
+                          GetStep(transaction.regularity), transaction.sum});
+  }
+  for (const auto& transaction : info.withdrawals) {
+    schedules_.push_back({transaction.date, transaction.date.GetDay(),
+                          GetStep(transaction.regularity), -transaction.sum});
+  }
+  std::sort(schedules_.begin(), schedules_.end(),
+            [](const Schedule& a, const Schedule& b) {
+              return a.date < b.date || (a.date == b.date && a.step < b.step);
+            });
+
+  std::size_t size = 0;
+  for (const Schedule& schedule : schedules_) {
+    if (schedule.date > maturity_) {
+      break;
     }
-  };
-
-  auto process_transactions =
-      [&](const std::vector<Transaction>& transaction_list, double sign) {
-        for (const auto& transaction : transaction_list) {
-          std::string date = transaction.date;
-          int step = get_step(transaction.regularity);
-          while (CompareDates(date, AddMonths(info.date, info.term)) <= 0) {
-            transactions_map[date] += sign * transaction.sum;
-            date = AddMonths(date, step, transaction.date);
-          }
-        }
-      };
-
-  process_transactions(info.replenishments, 1.0);
-  process_transactions(info.withdrawals, -1.0);
-
-  return transactions_map;
-}
-
-/**
- * @brief Calculates the total interest accrued between two dates based on the
- * given interest rate and initial balance.
- *
- * This function calculates the total interest accrued on a balance between two
- * specified dates using a provided interest rate. The interest is computed
- * based on the actual number of days in the interval.
- *
- * @param date1 The start date of the interest calculation period.
- * @param date2 The end date of the interest calculation period.
- * @param rate The annual interest rate in percentage.
- * @param balance The initial balance on which interest is calculated.
- * @return The total interest accrued between date1 and date2, rounded to two
- * decimal places.
- *
- * The function utilizes the actual number of days in the interval, considering
- * leap years and varying month lengths.
- */
-double DepositCalc::CalculateInterest(const std::string& date1,
-                                      const std::string& date2, double rate,
-                                      double balance) {
-  double total_interest = 0.0;
-  std::string current_date = date1;
-
-  while (CompareDates(current_date, date2) < 0) {
-    std::string next_date = FindNextYear(current_date);
-    if (CompareDates(next_date, date2) >= 0) {
-      next_date = date2;
+    if (size > 0 && schedules_[size - 1].date == schedule.date &&
+        schedules_[size - 1].step == schedule.step) {
+      schedules_[size - 1].sum += schedule.sum;
+    } else {
+      schedules_[size++] = schedule;
     }
-
-    int days_in_interval = DaysBetweenDates(current_date, next_date);
-    total_interest +=
-        balance * days_in_interval * rate / 100 / DaysInYear(current_date);
-    current_date = next_date;
   }
-
-  return std::round(total_interest * 100) / 100;
+  schedules_.resize(size);
+  has_transaction_ = NextTransaction(transaction_date_, transaction_sum_);
 }
 
 /**
- * @brief Adds a specified number of days to the given date and returns the
- * resulting date in the format "%d-%m-%Y".
+ * @brief Produces the next row of the plan.
  *
- * This function takes a date in the format "%d-%m-%Y" and adds the specified
- * number of days to it, returning the resulting date as a string in the same
- * format. The input date is parsed, and the calculated date is formatted using
- * the same format. If the input date format is invalid, an exception is thrown.
+ * The interest dates are merged with the transactions in order of date, and
+ * a transaction comes before an interest payment on the same date. The
+ * interest of a transaction row is accrued until the next interest payment,
+ * and the interest of a capitalized deposit is added to the balance.
  *
- * @param date The input date in the format "%d-%m-%Y".
- * @param days The number of days to be added to the input date.
- * @return The resulting date after adding the specified number of days in the
- * format "%d-%m-%Y".
- * @throws std::invalid_argument If the input date format is invalid.
+ * @param row The output row.
+ * @return false if the plan is finished, in which case the row is not
+ * changed.
  */
-std::string DepositCalc::AddDays(const std::string& date, int days) {
-  std::tm tm = {};
-  std::istringstream ss(date);
-  ss >> std::get_time(&tm, "%d-%m-%Y");
-  if (ss.fail()) {
-    throw std::invalid_argument("Invalid date format");
+bool DepositCalc::PlanGenerator::Next(Row& row) {
+  if (!has_interest_ && !has_transaction_) {
+    return false;
   }
 
-  auto tp = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-  tp += std::chrono::hours(24 * days);
-  std::time_t new_time = std::chrono::system_clock::to_time_t(tp);
-  std::tm* new_tm = std::localtime(&new_time);
+  row.interest = 0.0;
+  row.transaction = 0.0;
+  if (has_interest_ &&
+      (!has_transaction_ || interest_date_ < transaction_date_)) {
+    row.date = interest_date_;
+    row.interest = cumulated_interest_ + CalculateInterest(prev_date_, row.date,
+                                                           info_->rate,
+                                                           balance_);
+    cumulated_interest_ = 0.0;
+    has_interest_ = NextInterestDate(interest_date_);
+  } else {
+    row.date = transaction_date_;
+    row.transaction = transaction_sum_;
+    cumulated_interest_ +=
+        CalculateInterest(prev_date_, row.date, info_->rate, balance_);
+    has_transaction_ = NextTransaction(transaction_date_, transaction_sum_);
+  }
 
-  std::ostringstream oss;
-  oss << std::put_time(new_tm, "%d-%m-%Y");
-  return oss.str();
+  if (info_->capitalize) {
+    balance_ += row.interest + row.transaction;
+  } else {
+    balance_ += row.transaction;
+  }
+  row.balance = balance_;
+  if (first_) {
+    row.transaction += info_->sum;
+    first_ = false;
+  }
+  prev_date_ = row.date;
+  return true;
 }
 
 /**
- * @brief Adds a specified number of months to the given date and returns the
- * resulting date in the format "%d-%m-%Y".
+ * @brief Produces the next interest date.
  *
- * This function takes a date in the format "%d-%m-%Y" and adds the specified
- * number of months to it, returning the resulting date as a string in the same
- * format. The input date is parsed, and the calculated date is formatted using
- * the same format. If the input date format is invalid, the behavior is
- * undefined.
- *
- * @param date The input date in the format "%d-%m-%Y".
- * @param months The number of months to be added to the input date.
- * @return The resulting date after adding the specified number of months in the
- * format "%d-%m-%Y".
+ * @param date The output date.
+ * @return false after the maturity date.
  */
-std::string DepositCalc::AddMonths(const std::string& date, int months) {
-  std::tm tm = StringToDate(date);
-
-  tm.tm_mon += months;
-  if (tm.tm_mon > 11) {
-    tm.tm_year += tm.tm_mon / 12;
-    tm.tm_mon %= 12;
+bool DepositCalc::PlanGenerator::NextInterestDate(Date& date) {
+  if (delta_ < limit_) {
+    date = next_date_;
+    delta_ += step_;
+    next_date_ = daily_ ? info_->date.AddDays(delta_)
+                        : next_date_.AddMonths(step_);
+    return true;
   }
-
-  std::time_t new_time = std::mktime(&tm);
-  std::tm* new_tm = std::localtime(&new_time);
-
-  std::ostringstream oss;
-  oss << std::put_time(new_tm, "%d-%m-%Y");
-  return oss.str();
+  if (!maturity_done_) {
+    date = maturity_;
+    maturity_done_ = true;
+    return true;
+  }
+  return false;
 }
 
 /**
- * @brief Adds a specified number of months to the given date and returns the
- * resulting date in the format "%d-%m-%Y", considering a specified start date.
+ * @brief Constructor of the TaxCalculator class.
  *
- * This function takes a date in the format "%d-%m-%Y" and adds the specified
- * number of months to it, considering a start date. If the day component of the
- * start date is valid (within the month), it is used as a reference for the day
- * component of the resulting date. If not, the last day of the resulting month
- * is used. The calculated date is then formatted as a string in the format
- * "%d-%m-%Y". If the input date or start date format is invalid, the behavior
- * is undefined.
- *
- * @param date The input date in the format "%d-%m-%Y".
- * @param months The number of months to be added to the input date.
- * @param start_date The reference start date in the format "%d-%m-%Y".
- * @return The resulting date after adding the specified number of months in the
- * format "%d-%m-%Y".
+ * @param tax_rate The tax rate in percent.
  */
-std::string DepositCalc::AddMonths(const std::string& date, int months,
-                                   const std::string& start_date) {
-  std::tm tm = StringToDate(date);
-  std::tm start_tm = StringToDate(start_date);
-
-  tm.tm_mon += months;
-  if (tm.tm_mon > 11) {
-    tm.tm_year += tm.tm_mon / 12;
-    tm.tm_mon %= 12;
-  }
-
-  if (start_tm.tm_mday > 0 && start_tm.tm_mday <= DaysInMonth(start_tm)) {
-    tm.tm_mday = std::min(start_tm.tm_mday, DaysInMonth(tm));
-  } else {
-    tm.tm_mday = DaysInMonth(tm);
-  }
-
-  std::time_t new_time = std::mktime(&tm);
-  std::tm* new_tm = std::localtime(&new_time);
-
-  std::ostringstream oss;
-  oss << std::put_time(new_tm, "%d-%m-%Y");
-  return oss.str();
-}
+DepositCalc::TaxCalculator::TaxCalculator(double tax_rate)
+    : tax_rate_(tax_rate) {}
 
 /**
- * @brief Calculates the number of days in the specified month considering leap
- * years.
+ * @brief Adds the interest of a row to the income of its year.
  *
- * This function takes a std::tm structure representing a specific month and
- * year and calculates the number of days in that month, considering leap years
- * for February. It returns the total number of days in the specified month.
+ * When a row starts a new year, the tax of the previous one is calculated if
+ * it had any income.
  *
- * @param time A std::tm structure representing the month and year.
- * @return The number of days in the specified month, considering leap years for
- * February.
+ * @param row The next row of the plan.
  */
-int DepositCalc::DaysInMonth(const std::tm& time) {
-  static const std::vector<int> days_in_month = {31, 28, 31, 30, 31, 30,
-                                                 31, 31, 30, 31, 30, 31};
-  int month = time.tm_mon;
-
-  int days = days_in_month[month];
-  if (month == 1 && IsLeapYear(time.tm_year + 1900)) {
-    days = 29;
+void DepositCalc::TaxCalculator::Add(const Row& row) {
+  int year = row.date.GetYear();
+  if (!empty_ && year != year_) {
+    if (income_ > 0) {
+      tax_info_.push_back(MakeTaxInfo());
+    }
+    income_ = 0.0;
   }
-
-  return days;
+  year_ = year;
+  income_ += row.interest;
+  empty_ = false;
 }
 
 /**
- * @brief Parses the input date string and converts it to a std::tm structure.
+ * @brief Returns the taxes of all years, including the current one.
  *
- * This function takes a date string in the format "%d-%m-%Y" and parses it to
- * create a std::tm structure representing the date. If the input string has an
- * invalid format, it throws a std::runtime_error.
+ * Years without income are skipped, except for the last one.
  *
- * @param date The input date string in the format "%d-%m-%Y".
- * @return A std::tm structure representing the parsed date.
- * @throws std::runtime_error If the input date format is invalid.
+ * @return std::vector<TaxInfo> A vector of TaxInfo structures, each
+ * representing the tax information for a specific year, or an empty vector
+ * if no rows were added.
  */
-std::tm DepositCalc::StringToDate(const std::string& date) {
-  std::istringstream ss(date);
-  std::tm tm = {};
-  ss >> std::get_time(&tm, "%d-%m-%Y");
-  if (ss.fail()) {
-    throw std::runtime_error("Invalid date format");
+std::vector<DepositCalc::TaxInfo> DepositCalc::TaxCalculator::Finish() const {
+  std::vector<TaxInfo> tax_info = tax_info_;
+  if (!empty_) {
+    tax_info.push_back(MakeTaxInfo());
   }
-  return tm;
+  return tax_info;
 }
 
 /**
- * @brief Converts a given term in months to the corresponding number of days.
+ * @brief Calculates the tax of the income of the current year.
  *
- * This function calculates the number of days between the input date and the
- * date after adding the specified term in months.
- *
- * @param date The input date string in the format "%d-%m-%Y".
- * @param term The term in months to be converted to days.
- * @return The number of days corresponding to the given term in months.
+ * @return The tax information, payable before 1 December of the next year.
  */
-int DepositCalc::TermToDays(const std::string& date, int term) {
-  auto date1 = StringToDate(date);
-  auto date2 = StringToDate(AddMonths(date, term));
-
-  std::time_t time1 = std::mktime(&date1);
-  std::time_t time2 = std::mktime(&date2);
-  int days = std::difftime(time2, time1) / kSecondsPerDay;
-
-  return days;
+DepositCalc::TaxInfo DepositCalc::TaxCalculator::MakeTaxInfo() const {
+  TaxInfo tax;
+  tax.year = year_;
+  tax.income = income_;
+  tax.deduction = kTaxDeduction;
+  tax.deduction_income = std::max(0.0, tax.income - tax.deduction);
+  tax.tax_sum = std::round(tax.deduction_income * tax_rate_) / 100;
+  tax.pay_before = Date(year_ + 1, 12, 1);
+  return tax;
 }
 
 /**
- * @brief Compares two date strings in the format "%d-%m-%Y".
+ * @brief Produces the date and the sum of the next transactions.
  *
- * This function compares two date strings to determine their order.
+ * All schedules due on the earliest date are taken from the top of the heap
+ * and their sums are added together. Every schedule then moves to its next
+ * date and is sifted down, unless it is a one-time transaction or its next
+ * date is after maturity, in which case the last schedule takes its place.
  *
- * @param date1 The first date string to be compared.
- * @param date2 The second date string to be compared.
- * @return -1 if date1 is earlier than date2, 1 if date1 is later than date2,
- * and 0 if they are equal.
+ * @param date The output date.
+ * @param sum The output sum, negative for withdrawals.
+ * @return false if there are no more transactions.
  */
-int DepositCalc::CompareDates(const std::string& date1,
-                              const std::string& date2) {
-  std::tm tm1 = {};
-  std::tm tm2 = {};
-
-  std::istringstream ss1(date1);
-  ss1 >> std::get_time(&tm1, "%d-%m-%Y");
-
-  std::istringstream ss2(date2);
-  ss2 >> std::get_time(&tm2, "%d-%m-%Y");
-
-  if (ss1.fail() || ss2.fail()) {
-    throw std::runtime_error("Invalid date format");
+bool DepositCalc::PlanGenerator::NextTransaction(Date& date, double& sum) {
+  if (schedules_.empty()) {
+    return false;
   }
 
-  if (std::mktime(&tm1) < std::mktime(&tm2)) {
-    return -1;
-  } else if (std::mktime(&tm1) > std::mktime(&tm2)) {
-    return 1;
-  } else {
-    return 0;
+  date = schedules_.front().date;
+  sum = 0.0;
+  while (!schedules_.empty() && schedules_.front().date == date) {
+    Schedule& schedule = schedules_.front();
+    sum += schedule.sum;
+    schedule.date = schedule.date.AddMonths(schedule.step, schedule.day);
+    if (schedule.step <= 0 || schedule.date > maturity_) {
+      schedule = schedules_.back();
+      schedules_.pop_back();
+      if (schedules_.empty()) {
+        break;
+      }
+    }
+    SiftDown();
   }
+  return true;
 }
 
 /**
- * @brief Calculates the number of days between two date strings in the format
- * "%d-%m-%Y".
- *
- * This function calculates the number of days between two given date strings.
+ * @brief Moves the top schedule down the heap after it has been replaced
+ * by a later one.
  *
- * @param date1 The first date string.
- * @param date2 The second date string.
- * @return The number of days between date1 and date2.
- * @throws std::runtime_error If the conversion fails for any date string.
+ * This restores the heap in a single pass from the top, which is half the
+ * work of removing the schedule and inserting it again.
  */
-int DepositCalc::DaysBetweenDates(const std::string& date1,
-                                  const std::string& date2) {
-  std::tm tm1 = StringToDate(date1);
-  std::tm tm2 = StringToDate(date2);
-
-  std::time_t time1 = std::mktime(&tm1);
-  std::time_t time2 = std::mktime(&tm2);
-
-  if (time1 == -1 || time2 == -1) {
-    throw std::runtime_error("Invalid date format");
+void DepositCalc::PlanGenerator::SiftDown() {
+  std::size_t size = schedules_.size();
+  Schedule top = schedules_.front();
+  std::size_t i = 0;
+  for (std::size_t child = 1; child < size; child = 2 * i + 1) {
+    if (child + 1 < size && IsLater(schedules_[child], schedules_[child + 1])) {
+      ++child;
+    }
+    if (!IsLater(top, schedules_[child])) {
+      break;
+    }
+    schedules_[i] = schedules_[child];
+    i = child;
   }
-
-  int days = std::difftime(time2, time1) / kSecondsPerDay;
-
-  return days;
+  schedules_[i] = top;
 }
 
 /**
- * @brief Calculates the number of days in the year of the given date string in
- * the format "%d-%m-%Y".
- *
- * This function calculates the number of days in the year of the given date
- * string.
+ * @brief Returns the number of months between two transactions of a
+ * regularity.
  *
- * @param date The date string in the format "%d-%m-%Y".
- * @return The number of days in the year of the given date.
+ * @param regularity The regularity of the transaction.
+ * @return The step in months, or 0 for a one-time transaction.
  */
-int DepositCalc::DaysInYear(const std::string& date) {
-  std::tm tm = StringToDate(date);
-  if (tm.tm_mon == 11 && tm.tm_mday == 31) tm.tm_year += 1;
-  int year = tm.tm_year + 1900;
-
-  return IsLeapYear(year) ? 366 : 365;
+int DepositCalc::GetStep(Regularity regularity) {
+  switch (regularity) {
+    case Regularity::kMonthly:
+      return 1;
+    case Regularity::kBiMonthly:
+      return 2;
+    case Regularity::kQuarterly:
+      return 3;
+    case Regularity::kSemiAnnually:
+      return 6;
+    case Regularity::kAnnually:
+      return 12;
+    default:
+      return 0;
+  }
 }
 
 /**
- * @brief Checks if the given year is a leap year.
- *
- * This function determines whether a given year is a leap year.
- *
- * @param year The year to be checked for leap year status.
- * @return true if the year is a leap year, false otherwise.
+ * @brief Orders schedules so that the earliest one is on top of a heap.
  */
-bool DepositCalc::IsLeapYear(int year) {
-  return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+bool DepositCalc::IsLater(const Schedule& a, const Schedule& b) {
+  return a.date > b.date;
 }
 
 /**
- * @brief Finds the date corresponding to the end of the year from the given
- * date.
+ * @brief Calculates the total interest accrued between two dates based on the
+ * given interest rate and initial balance.
  *
- * This function takes a date in the format "dd-mm-yyyy" and calculates the date
- * corresponding to the end of the year (31st December).
+ * This function calculates the total interest accrued on a balance between two
+ * specified dates using a provided interest rate. The interest is computed
+ * based on the actual number of days in the interval.
+ *
+ * @param date1 The start date of the interest calculation period.
+ * @param date2 The end date of the interest calculation period.
+ * @param rate The annual interest rate in percentage.
+ * @param balance The initial balance on which interest is calculated.
+ * @return The total interest accrued between date1 and date2, rounded to two
+ * decimal places.
  *
- * @param date The input date in the format "dd-mm-yyyy".
- * @return A string representing the date at the end of the next year in the
- * format "dd-mm-yyyy".
+ * The function utilizes the actual number of days in the interval, considering
+ * leap years and varying month lengths.
  */
-std::string DepositCalc::FindNextYear(const std::string& date) {
-  std::tm tm = StringToDate(date);
-  if (tm.tm_mon == 11 && tm.tm_mday == 31) tm.tm_year += 1;
-  tm.tm_mon = 11;
-  tm.tm_mday = 31;
+double DepositCalc::CalculateInterest(Date date1, Date date2, double rate,
+                                      double balance) {
+  double total_interest = 0.0;
+  Date current_date = date1;
 
-  std::time_t new_time = std::mktime(&tm);
-  std::tm* new_tm = std::localtime(&new_time);
+  while (current_date < date2) {
+    Date next_date = FindNextYear(current_date);
+    if (next_date >= date2) {
+      next_date = date2;
+    }
 
-  std::ostringstream oss;
-  oss << std::put_time(new_tm, "%d-%m-%Y");
-  return oss.str();
+    int days_in_interval = next_date - current_date;
+    total_interest +=
+        balance * days_in_interval * rate / 100 / DaysInYear(current_date);
+    current_date = next_date;
+  }
+
+  return std::round(total_interest * 100) / 100;
 }
 
 /**
- * @brief Extracts the year from a date string in the format "dd-mm-yyyy".
+ * @brief Calculates the number of days in the year of the given date.
+ *
+ * The interest of a period that starts on 31 December belongs to the next
+ * year, so the days of the next year are returned for it.
  *
- * @param date The date string in the format "dd-mm-yyyy".
- * @return std::string The extracted year as a string.
- * @throws std::runtime_error If the input date format is invalid.
+ * @param date The date.
+ * @return The number of days in the year of the given date.
  */
-std::string DepositCalc::ExtractYear(const std::string& date) {
-  std::istringstream ss(date);
-  std::tm tm = {};
-  ss >> std::get_time(&tm, "%d-%m-%Y");
-  if (ss.fail()) {
-    throw std::runtime_error("Invalid date format");
-  }
-  std::ostringstream oss;
-  oss << std::put_time(&tm, "%Y");
-  return oss.str();
+int DepositCalc::DaysInYear(Date date) {
+  return date.AddDays(1).DaysInYear();
 }
 
 /**
- * @brief Calculates the tax information for each year within the payment plan
- * period.
+ * @brief Finds the date corresponding to the end of the year from the given
+ * date.
  *
- * This function takes the payment plan and calculates the tax information for
- * each year within the payment period. It considers the income, deductions, tax
- * amount, and the date of the final payment for each year.
+ * This function calculates the 31st December of the year of the date, or of
+ * the next year if the date is already the 31st December.
  *
- * @param plan The payment plan containing dates, interest accrued, transaction
- * amounts, and balances.
- * @return std::vector<TaxInfo> A vector of TaxInfo structures, each
- * representing the tax information for a specific year.
+ * @param date The input date.
+ * @return The date at the end of the year.
  */
-std::vector<DepositCalc::TaxInfo> DepositCalc::CalculateTax(
-    const PaymentPlan& plan, const DepositInfo& info) {
-  std::vector<TaxInfo> tax_info;
-  if (plan.dates.empty()) {
-    return tax_info;
-  }
-
-  double income = 0.0;
-  std::string current_year = ExtractYear(plan.dates.front());
-
-  for (std::size_t i = 0; i < plan.dates.size(); ++i) {
-    std::string year = ExtractYear(plan.dates[i]);
-    if (current_year == year) {
-      income += plan.interests[i];
-    } else {
-      if (income > 0) {
-        TaxInfo tax;
-        tax.year = current_year;
-        tax.income = income;
-        tax.deduction = kTaxDeduction;
-        tax.deduction_income = std::max(0.0, tax.income - tax.deduction);
-        tax.tax_sum = std::round(tax.deduction_income * info.tax_rate) / 100;
-        tax.pay_before = tax.tax_sum > 0 ? "1 December " + year : "";
-        tax_info.push_back(tax);
-      }
-
-      income = 0.0;
-      current_year = year;
-    }
-  }
-  TaxInfo tax;
-  tax.year = current_year;
-  tax.income = income;
-  tax.deduction = kTaxDeduction;
-  tax.deduction_income = std::max(0.0, tax.income - tax.deduction);
-  tax.tax_sum = std::round(tax.deduction_income * info.tax_rate) / 100;
-  tax.pay_before =
-      tax.tax_sum > 0
-          ? "1 December " + std::to_string(std::stoi(current_year) + 1)
-          : "";
-  tax_info.push_back(tax);
-
-  return tax_info;
+Date DepositCalc::FindNextYear(Date date) {
+  return Date(date.AddDays(1).GetYear(), 12, 31);
 }
 
 /**
@@ -629,7 +426,7 @@ std::string DepositCalc::PlanToString(const PaymentPlan& plan,
       << "Balance" << std::endl;
 
   for (std::size_t i = 0; i < plan.dates.size(); ++i) {
-    oss << std::setw(15) << std::left << plan.dates[i] << std::fixed
+    oss << std::setw(15) << std::left << plan.dates[i].ToString() << std::fixed
         << std::setprecision(2) << std::setw(20) << std::left
         << plan.interests[i];
 
@@ -678,7 +475,9 @@ std::string DepositCalc::TaxToString(const std::vector<TaxInfo>& tax_info) {
         << tax.deduction << std::fixed << std::setprecision(2) << std::setw(25)
         << std::left << tax.deduction_income << std::fixed
         << std::setprecision(2) << std::setw(15) << std::left << tax.tax_sum
-        << std::setw(20) << std::left << tax.pay_before << std::endl;
+        << std::setw(20) << std::left
+        << (tax.tax_sum > 0 ? tax.pay_before.Format("%d %B %Y") : "")
+        << std::endl;
   }
 
   return oss.str();
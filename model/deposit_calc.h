@@ -1,15 +1,16 @@
 #ifndef SMARTCALC_MODEL_DEPOSIT_CALC_H_
 #define SMARTCALC_MODEL_DEPOSIT_CALC_H_
 
-#include <chrono>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
-#include <map>
 #include <numeric>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "date.h"
+
 namespace s21 {
 
 /**
@@ -19,6 +20,14 @@ namespace s21 {
  * The `DepositCalc` class provides methods for calculating deposit payments
  * and interest details based on the provided deposit parameters. It supports
  * various deposit types, including regular and periodic contributions.
+ *
+ * All dates are Date values, so the calendar arithmetic of a plan is done in
+ * integers. Text is only produced by PlanToString and TaxToString.
+ *
+ * The rows of a plan are produced one at a time by a PlanGenerator, and the
+ * taxes are accumulated from them by a TaxCalculator, so a plan can be
+ * exported or summed in memory that does not depend on its length and
+ * stopped at any row. Calculate collects all rows into a PaymentPlan.
  */
 class DepositCalc {
  public:
@@ -50,7 +59,7 @@ class DepositCalc {
    */
   struct Transaction {
     Regularity regularity;
-    std::string date;
+    Date date;
     double sum;
   };
 
@@ -66,7 +75,7 @@ class DepositCalc {
   struct DepositInfo {
     double sum;
     int term;
-    std::string date;
+    Date date;
     double rate;
     double tax_rate = 13.0;
     PaymentPeriod period;
@@ -84,15 +93,16 @@ class DepositCalc {
    *
    * This struct stores information related to taxes for a particular year,
    * including income, tax deduction, income after deduction, tax amount, and
-   * payment date.
+   * payment date. The payment date is only meaningful if the tax amount is
+   * not zero.
    */
   struct TaxInfo {
-    std::string year;
+    int year;
     double income;
     double deduction;
     double deduction_income;
     double tax_sum;
-    std::string pay_before;
+    Date pay_before;
   };
 
   /**
@@ -103,7 +113,7 @@ class DepositCalc {
    * dates, earned interests, remaining balances, and applicable tax amount.
    */
   struct PaymentPlan {
-    std::vector<std::string> dates;
+    std::vector<Date> dates;
     std::vector<double> interests;
     std::vector<double> transactions;
     std::vector<double> balances;
@@ -111,17 +121,97 @@ class DepositCalc {
   };
 
   /**
-   * @struct DatesComparator
-   * @brief Functor for comparing dates represented as strings.
+   * @struct Row
+   * @brief A single row of a deposit payment plan.
    *
-   * This struct defines a comparator for dates represented as strings. It uses
-   * the CompareDates function to compare two dates and returns true if the
-   * first date is earlier than the second date.
+   * A row is either an interest payment or a transaction. The transaction of
+   * the first row includes the initial sum.
    */
-  struct DatesComparator {
-    bool operator()(const std::string& date1, const std::string& date2) const {
-      return CompareDates(date1, date2) == -1;
-    }
+  struct Row {
+    Date date;
+    double interest;
+    double transaction;
+    double balance;
+  };
+
+  /**
+   * @struct Schedule
+   * @brief The next occurrence of a replenishment or a withdrawal.
+   *
+   * A recurring transaction keeps the day of its first date, or the last day
+   * of shorter months, and a step of 0 months marks a one-time transaction.
+   */
+  struct Schedule {
+    Date date;
+    int day;
+    int step;
+    double sum;
+  };
+
+  /**
+   * @class PlanGenerator
+   * @brief Produces the rows of a deposit payment plan in order of date.
+   *
+   * The interest dates are generated one at a time. Every replenishment and
+   * withdrawal is a schedule of its own, which only holds its next date, and
+   * the schedules are merged in a min-heap by date, so the memory use grows
+   * with the number of transactions but not with the length of the plan.
+   * Transactions on the same date are summed into one row. The DepositInfo
+   * must outlive the generator.
+   */
+  class PlanGenerator {
+   public:
+    explicit PlanGenerator(const DepositInfo& info);
+
+    bool Next(Row& row);
+
+   private:
+    bool NextInterestDate(Date& date);
+    bool NextTransaction(Date& date, double& sum);
+    void SiftDown();
+
+    const DepositInfo* info_;
+    Date maturity_;
+    bool daily_;
+    int step_;
+    int limit_;
+    int delta_ = 0;
+    Date next_date_;
+    bool maturity_done_ = false;
+    bool has_interest_;
+    Date interest_date_;
+    std::vector<Schedule> schedules_;
+    bool has_transaction_;
+    Date transaction_date_;
+    double transaction_sum_;
+    double balance_;
+    Date prev_date_;
+    double cumulated_interest_ = 0.0;
+    bool first_ = true;
+  };
+
+  /**
+   * @class TaxCalculator
+   * @brief Accumulates the taxes of the interest income from plan rows.
+   *
+   * The rows must be added in order of date. Only the income of the current
+   * year and the taxes of the finished years are kept.
+   */
+  class TaxCalculator {
+   public:
+    explicit TaxCalculator(double tax_rate);
+
+    void Add(const Row& row);
+    std::vector<TaxInfo> Finish() const;
+
+   private:
+    TaxInfo MakeTaxInfo() const;
+
+    double tax_rate_;
+    std::vector<TaxInfo> tax_info_;
+    double income_ = 0.0;
+    int year_ = 0;
+    bool empty_ = true;
   };
 
   static PaymentPlan Calculate(const DepositInfo& info);
@@ -130,31 +220,12 @@ class DepositCalc {
   static std::string TaxToString(const std::vector<TaxInfo>& tax_info);
 
  private:
-  static constexpr int kSecondsPerDay = 24 * 60 * 60;
-
-  static std::vector<std::string> GenerateInterestDates(
-      const DepositInfo& info);
-  static std::map<std::string, double, DatesComparator> GenerateTransactions(
-      const DepositInfo& info);
-  static double CalculateInterest(const std::string& date1,
-                                  const std::string& date2, double rate,
+  static int GetStep(Regularity regularity);
+  static bool IsLater(const Schedule& a, const Schedule& b);
+  static double CalculateInterest(Date date1, Date date2, double rate,
                                   double balance);
-  static std::tm StringToDate(const std::string& date);
-  static int CompareDates(const std::string& date1, const std::string& date2);
-  static int TermToDays(const std::string& date, int term);
-  static std::string AddDays(const std::string& date, int days);
-  static std::string AddMonths(const std::string& date, int months);
-  static std::string AddMonths(const std::string& date, int months,
-                               const std::string& start_date);
-  static int DaysInYear(const std::string& date);
-  static int DaysInMonth(const std::tm& time);
-  static int DaysBetweenDates(const std::string& date1,
-                              const std::string& date2);
-  static std::string FindNextYear(const std::string& date);
-  static std::string ExtractYear(const std::string& date);
-  static bool IsLeapYear(int year);
-  static std::vector<TaxInfo> CalculateTax(const PaymentPlan& plan,
-                                           const DepositInfo& info);
+  static int DaysInYear(Date date);
+  static Date FindNextYear(Date date);
 };
 }  // namespace s21
 
@@ -0,0 +1,268 @@
+#include "dual_evaluator.h"
+
+namespace s21 {
+
+/**
+ * @brief Calculates the value and the derivatives of a compiled expression.
+ *
+ * The value is computed with the same operations as MathCalc::Calculate and
+ * is identical to its result.
+ *
+ * @param program The compiled expression, as returned by MathCalc::Compile,
+ * with at most one variable.
+ * @param x The point of differentiation.
+ * @return The value and the first and second derivatives at x.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+DualEvaluator::Dual DualEvaluator::Evaluate(const Program& program, double x) {
+  if (program.variables.size() > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  return Execute(program, x);
+}
+
+/**
+ * @brief Calculates the derivative of a compiled expression for a range of
+ * variable values.
+ *
+ * @param program The compiled expression, with at most one variable.
+ * @param x_min The minimum value of the variable.
+ * @param x_max The maximum value of the variable.
+ * @param size The number of points to be generated between x_min and x_max
+ * (inclusive).
+ * @return A pair of vectors with the variable values and the derivatives.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+std::pair<std::vector<double>, std::vector<double>>
+DualEvaluator::Differentiate(const Program& program, double x_min,
+                             double x_max, std::size_t size) {
+  if (program.variables.size() > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  std::vector<double> x(size), dy(size);
+  double step = (x_max - x_min) / (size - 1);
+  for (std::size_t i = 0; i < size; ++i) {
+    x[i] = x_min + static_cast<double>(i) * step;
+    dy[i] = Execute(program, x[i]).first;
+  }
+  return {x, dy};
+}
+
+/**
+ * @brief Executes the instructions of a Program on dual numbers.
+ *
+ * The operand buffer is kept per thread and reused between calls.
+ */
+DualEvaluator::Dual DualEvaluator::Execute(const Program& program, double x) {
+  thread_local std::vector<Dual> stack;
+  if (stack.size() < program.depth) {
+    stack.resize(program.depth);
+  }
+  std::size_t top = 0;
+
+  for (const Instruction& instruction : program.code) {
+    if (instruction.op == OpCode::kNumber) {
+      stack[top++] = {instruction.value, 0.0, 0.0};
+      continue;
+    }
+    if (instruction.op == OpCode::kVariable) {
+      stack[top++] = {x, 1.0, 0.0};
+      continue;
+    }
+    if (instruction.op == OpCode::kLoad) {
+      stack[top++] = stack[static_cast<std::size_t>(instruction.value)];
+      continue;
+    }
+    if (instruction.op == OpCode::kStore) {
+      stack[static_cast<std::size_t>(instruction.value)] = stack[top - 1];
+      continue;
+    }
+    if (instruction.op == OpCode::kCoefficient) {
+      continue;
+    }
+    if (IsBinary(instruction.op)) {
+      --top;
+    }
+    Dual& u = stack[top - 1];
+    const Dual& v = IsBinary(instruction.op) ? stack[top] : u;
+    double value = u.value;
+
+    switch (instruction.op) {
+      case OpCode::kNegate:
+        u = {-u.value, -u.first, -u.second};
+        break;
+      case OpCode::kAdd:
+        u = {u.value + v.value, u.first + v.first, u.second + v.second};
+        break;
+      case OpCode::kSub:
+        u = {u.value - v.value, u.first - v.first, u.second - v.second};
+        break;
+      case OpCode::kMul:
+        u = Mul(u, v);
+        break;
+      case OpCode::kDiv:
+        u = Div(u, v);
+        break;
+      case OpCode::kPow:
+        u = Pow(u, v);
+        break;
+      case OpCode::kMod:
+        u = Mod(u, v);
+        break;
+      case OpCode::kPowInt:
+        u = PowInt(u, static_cast<long>(instruction.value));
+        break;
+      case OpCode::kPolynomial: {
+        const Instruction* coefficient = &instruction + 1;
+        Dual result = {coefficient->value, 0.0, 0.0};
+        for (std::size_t k = 0; k < static_cast<std::size_t>(instruction.value);
+             ++k) {
+          ++coefficient;
+          result = Mul(result, u);
+          result.value += coefficient->value;
+        }
+        u = result;
+        break;
+      }
+      case OpCode::kSin:
+        u = Chain(u, std::sin(value), std::cos(value), -std::sin(value));
+        break;
+      case OpCode::kCos:
+        u = Chain(u, std::cos(value), -std::sin(value), -std::cos(value));
+        break;
+      case OpCode::kTan: {
+        double tangent = std::tan(value);
+        double secant = 1.0 + tangent * tangent;
+        u = Chain(u, tangent, secant, 2.0 * tangent * secant);
+        break;
+      }
+      case OpCode::kAsin:
+      case OpCode::kAcos: {
+        double root = 1.0 / std::sqrt(1.0 - value * value);
+        double sign = instruction.op == OpCode::kAsin ? 1.0 : -1.0;
+        u = Chain(u,
+                  instruction.op == OpCode::kAsin ? std::asin(value)
+                                                  : std::acos(value),
+                  sign * root, sign * value * root * root * root);
+        break;
+      }
+      case OpCode::kAtan: {
+        double inverse = 1.0 / (1.0 + value * value);
+        u = Chain(u, std::atan(value), inverse,
+                  -2.0 * value * inverse * inverse);
+        break;
+      }
+      case OpCode::kSqrt: {
+        double root = std::sqrt(value);
+        u = Chain(u, root, 0.5 / root, -0.25 / (root * root * root));
+        break;
+      }
+      case OpCode::kLn:
+        u = Chain(u, std::log(value), 1.0 / value, -1.0 / (value * value));
+        break;
+      case OpCode::kLog:
+        u = Chain(u, std::log10(value), 1.0 / (value * kLn10),
+                  -1.0 / (value * value * kLn10));
+        break;
+      default:
+        break;
+    }
+  }
+
+  return stack[0];
+}
+
+/**
+ * @brief Applies a function of one argument by the chain rule.
+ *
+ * The derivatives of a constant argument are zero, so they stay zero even
+ * where the derivatives of the function are infinite.
+ *
+ * @param u The argument.
+ * @param value The value of the function at u.value.
+ * @param first The first derivative of the function at u.value.
+ * @param second The second derivative of the function at u.value.
+ */
+DualEvaluator::Dual DualEvaluator::Chain(const Dual& u, double value,
+                                         double first, double second) {
+  Dual result = {value, 0.0, 0.0};
+  if (u.first != 0.0) {
+    result.first = first * u.first;
+    result.second = second * u.first * u.first;
+  }
+  if (u.second != 0.0) {
+    result.second += first * u.second;
+  }
+  return result;
+}
+
+/**
+ * @brief Multiplies two dual numbers.
+ */
+DualEvaluator::Dual DualEvaluator::Mul(const Dual& u, const Dual& v) {
+  return {u.value * v.value, u.first * v.value + u.value * v.first,
+          u.second * v.value + 2.0 * u.first * v.first + u.value * v.second};
+}
+
+/**
+ * @brief Divides two dual numbers.
+ */
+DualEvaluator::Dual DualEvaluator::Div(const Dual& u, const Dual& v) {
+  double value = u.value / v.value;
+  double first = (u.first - value * v.first) / v.value;
+  double second =
+      (u.second - 2.0 * first * v.first - value * v.second) / v.value;
+  return {value, first, second};
+}
+
+/**
+ * @brief Raises a dual number to the power of another dual number.
+ *
+ * A constant exponent is differentiated by the power rule, which also holds
+ * for negative bases. Otherwise the power is differentiated as
+ * exp(v * ln(u)).
+ */
+DualEvaluator::Dual DualEvaluator::Pow(const Dual& u, const Dual& v) {
+  double value = std::pow(u.value, v.value);
+  if (v.first == 0.0 && v.second == 0.0) {
+    double e = v.value;
+    return Chain(u, value, e * std::pow(u.value, e - 1.0),
+                 e * (e - 1.0) * std::pow(u.value, e - 2.0));
+  }
+
+  double ln = std::log(u.value);
+  double ratio = u.first / u.value;
+  double first = v.first * ln + v.value * ratio;
+  double second = v.second * ln + 2.0 * v.first * ratio +
+                  v.value * (u.second / u.value - ratio * ratio);
+  return {value, value * first, value * (second + first * first)};
+}
+
+/**
+ * @brief Raises a dual number to an integer power.
+ *
+ * The value is computed by repeated squaring like OpCode::kPowInt.
+ */
+DualEvaluator::Dual DualEvaluator::PowInt(const Dual& u, long exponent) {
+  if (exponent == 0) {
+    return {1.0, 0.0, 0.0};
+  }
+  auto n = static_cast<double>(exponent);
+  double second =
+      exponent == 1 ? 0.0 : n * (n - 1.0) * s21::PowInt(u.value, exponent - 2);
+  return Chain(u, s21::PowInt(u.value, exponent),
+               n * s21::PowInt(u.value, exponent - 1), second);
+}
+
+/**
+ * @brief Computes the floating-point remainder of two dual numbers.
+ *
+ * Between the jumps the remainder is u - k * v with a constant integer k.
+ */
+DualEvaluator::Dual DualEvaluator::Mod(const Dual& u, const Dual& v) {
+  double k = std::trunc(u.value / v.value);
+  return {std::fmod(u.value, v.value), u.first - k * v.first,
+          u.second - k * v.second};
+}
+
+}  // namespace s21
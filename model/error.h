@@ -0,0 +1,50 @@
+#ifndef SMARTCALC_MODEL_ERROR_H_
+#define SMARTCALC_MODEL_ERROR_H_
+
+#include <cstddef>
+#include <string>
+
+namespace s21 {
+
+enum class ErrorCode : unsigned char {
+  kOk,
+  kInvalidCharacter,
+  kInvalidNumber,
+  kInvalidToken,
+  kMissingOperator,
+  kMissingOperand,
+  kInvalidBrackets,
+  kInvalidExpression,
+  kInvalidVariable
+};
+
+/**
+ * @struct Error
+ * @brief Describes why an expression was rejected.
+ *
+ * Error is filled in by the non-throwing overloads of MathCalc and
+ * ProgramCache instead of throwing an exception, which keeps the rejection of
+ * invalid expressions cheap when many of them are processed in bulk. The
+ * message is the same as the one of the exception thrown by the throwing
+ * overloads. The position is the offset of the offending character in the
+ * expression, or its length if the expression ends prematurely.
+ */
+struct Error {
+  ErrorCode code = ErrorCode::kOk;
+  std::string message;
+  std::size_t position = 0;
+
+  bool IsOk() const { return code == ErrorCode::kOk; }
+};
+
+/**
+ * @brief The outcome of evaluating an expression at a single point.
+ *
+ * Points outside the domain of the expression, such as sqrt(-1) or 0/0,
+ * evaluate to NaN and are undefined; points where the result overflows or
+ * hits a pole evaluate to an infinity.
+ */
+enum class PointStatus : unsigned char { kOk, kUndefined, kInfinite };
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_ERROR_H_
@@ -0,0 +1,420 @@
+#include "incremental_parser.h"
+
+namespace s21 {
+
+/**
+ * @brief Evaluates the edited text of an expression.
+ *
+ * The old and the new text are compared to find the first changed
+ * character, and only the tokens that the change can affect are parsed
+ * again. A change of the variable value, including the sign of a zero,
+ * invalidates every value computed so far, so the whole text is parsed
+ * again.
+ *
+ * @param expression The new text of the expression.
+ * @param x The value of the variable in the expression.
+ * @param error Receives the code, message and position of the first error,
+ * or ErrorCode::kOk if the expression is valid.
+ * @return The result of evaluating the expression, or 0 if it is invalid.
+ */
+double IncrementalParser::Update(const std::string& expression, double x,
+                                 Error& error) {
+  if (x != x_ || std::signbit(x) != std::signbit(x_)) {
+    x_ = x;
+    Rollback(0);
+  }
+  std::size_t pos = CommonPrefix(text_, expression);
+  text_.replace(pos, std::string::npos, expression, pos, std::string::npos);
+  Rollback(pos);
+
+  error = Error();
+  if (!Parse(error)) {
+    return 0.0;
+  }
+  return Finish(error);
+}
+
+/**
+ * @brief Restores the state before the first token that a change of the text
+ * at the given position can affect.
+ *
+ * A token that ends before the change is not affected by it, with two
+ * exceptions. A run of letters may turn into a function name when letters are
+ * appended, which changes the tokens in its last KeywordTable::kMaxLength
+ * characters. And the validation of spaces looks ahead to the next token, so
+ * a run of spaces is parsed again as a whole.
+ *
+ * @param pos The position of the first changed character.
+ */
+void IncrementalParser::Rollback(std::size_t pos) {
+  std::size_t index = checkpoints_.size();
+  while (index > 0 &&
+         checkpoints_[index - 1].offset + KeywordTable::kMaxLength > pos) {
+    --index;
+  }
+  if (index > 0) {
+    --index;
+  }
+  auto is_space = [this](std::size_t i) {
+    return std::isspace(
+        static_cast<unsigned char>(text_[checkpoints_[i].offset]));
+  };
+  while (index > 0 && is_space(index) && is_space(index - 1)) {
+    --index;
+  }
+  if (index == checkpoints_.size()) {
+    return;
+  }
+
+  const Checkpoint& checkpoint = checkpoints_[index];
+  Undo(checkpoint.changes);
+  resume_ = checkpoint.offset;
+  last_ = checkpoint.last;
+  has_last_ = checkpoint.has_last;
+  checkpoints_.resize(index);
+}
+
+/**
+ * @brief Parses the text from the last restored checkpoint to its end.
+ *
+ * The lexer of MathCalc is resumed with the type of the last token, which
+ * decides omitted multiplications, unary operators and the validity of
+ * spaces. A checkpoint is taken before every token or space.
+ *
+ * @param error Receives the reason if the text is invalid.
+ * @return True if the whole text was parsed, False otherwise.
+ */
+bool IncrementalParser::Parse(Error& error) {
+  std::string_view text = text_;
+  std::size_t pos = resume_;
+  std::size_t alpha_end = 0;
+
+  while (pos < text.length()) {
+    checkpoints_.push_back({pos, changes_.size(), last_, has_last_});
+    tokens_.clear();
+    if (has_last_) {
+      tokens_.push_back(Token(last_, {}));
+    }
+    std::size_t first = tokens_.size();
+    pos = MathCalc::ParseToken(text, pos, alpha_end, variables_, tokens_,
+                               error);
+    for (std::size_t i = first; i < tokens_.size() && error.IsOk(); ++i) {
+      Process(tokens_[i], error);
+    }
+    if (!error.IsOk()) {
+      return false;
+    }
+    if (!tokens_.empty()) {
+      last_ = tokens_.back().GetType();
+      has_last_ = true;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Processes a token with the Shunting-Yard algorithm.
+ *
+ * Operands are pushed to the value stack, and operators are applied to it as
+ * soon as MathCalc::ConvertToRPN would emit them.
+ *
+ * @param token The token to be processed.
+ * @param error Receives the reason if the brackets do not match or an
+ * operator is missing an operand.
+ * @return True if the token was processed, False otherwise.
+ */
+bool IncrementalParser::Process(const Token& token, Error& error) {
+  if (token.IsNumber() || token.IsVariable()) {
+    PushValue(token.IsNumber()
+                  ? Value{token.GetValue(), true, true,
+                          Optimizer::Polynomial::Constant(token.GetValue())}
+                  : Value{x_, false, true,
+                          Optimizer::Polynomial::Variable(0)});
+  } else if (token.IsFunction() || token.IsOpenBracket()) {
+    PushOperator(MakeOperator(token));
+  } else if (token.IsCloseBracket()) {
+    return ProcessBrackets(token, error);
+  } else if (token.IsOperator()) {
+    Operator op = MakeOperator(token);
+    while (!operators_.empty() && IsOperator(operators_.back()) &&
+           (op.priority < operators_.back().priority ||
+            (op.priority == operators_.back().priority &&
+             !operators_.back().right_associative))) {
+      if (!Apply(error)) {
+        return false;
+      }
+    }
+    PushOperator(op);
+  }
+  return true;
+}
+
+/**
+ * @brief Applies the operators up to the matching open bracket and the
+ * function before it.
+ *
+ * @param token The close bracket.
+ * @param error Receives the reason if there is no matching open bracket or
+ * an operator is missing an operand.
+ * @return True if the bracket was processed, False otherwise.
+ */
+bool IncrementalParser::ProcessBrackets(const Token& token, Error& error) {
+  while (!operators_.empty() &&
+         operators_.back().type != TokenType::kOpenBracket) {
+    if (!Apply(error)) {
+      return false;
+    }
+  }
+  if (operators_.empty()) {
+    return MathCalc::Fail(ErrorCode::kInvalidBrackets,
+                          "Invalid bracket sequence",
+                          MathCalc::Position(text_, token), error);
+  }
+  changes_.push_back({Change::Kind::kPopOperator, operators_.back(), {}, {}});
+  operators_.pop_back();
+  if (!operators_.empty() && operators_.back().type == TokenType::kFunction) {
+    return Apply(error);
+  }
+  return true;
+}
+
+/**
+ * @brief Applies the operator on top of the operator stack to its operands.
+ *
+ * @param error Receives the reason if the operator is missing an operand,
+ * with the same message as MathCalc::Compile.
+ * @return True if the operator was applied, False otherwise.
+ */
+bool IncrementalParser::Apply(Error& error) {
+  const Operator op = operators_.back();
+  std::size_t arity = op.type == TokenType::kBinaryOperator ? 2 : 1;
+  if (values_.size() < arity) {
+    std::string message =
+        op.type == TokenType::kFunction
+            ? "Not enough operands for function: " +
+                  text_.substr(op.position,
+                               MathCalc::FindAlphaEnd(text_, op.position) -
+                                   op.position)
+        : op.type == TokenType::kUnaryOperator
+            ? "Not enough operands for unary operator"
+            : "Not enough operands for binary operator";
+    return MathCalc::Fail(ErrorCode::kMissingOperand, std::move(message),
+                          Position(op), error);
+  }
+
+  Value lhs = values_[values_.size() - arity];
+  Value rhs = values_.back();
+  changes_.push_back({Change::Kind::kApply, op, lhs, rhs});
+  operators_.pop_back();
+  values_.resize(values_.size() - arity);
+  values_.push_back(Evaluate(op, lhs, rhs));
+  return true;
+}
+
+/**
+ * @brief Completes the evaluation of the parsed text.
+ *
+ * The pending operators are applied as MathCalc::ProcessRemainingOperators
+ * would emit them, and the changes are undone afterwards, so that the text
+ * can still be extended.
+ *
+ * @param error Receives the reason if a bracket is not closed, an operator is
+ * missing an operand or the expression does not have exactly one result.
+ * @return The result of evaluating the expression, or 0 if it is invalid.
+ */
+double IncrementalParser::Finish(Error& error) {
+  for (auto it = operators_.rbegin(); it != operators_.rend(); ++it) {
+    if (it->type == TokenType::kOpenBracket) {
+      MathCalc::Fail(ErrorCode::kInvalidBrackets, "Invalid bracket sequence",
+                     Position(*it), error);
+      return 0.0;
+    }
+  }
+
+  std::size_t size = changes_.size();
+  while (!operators_.empty() && Apply(error)) {
+  }
+  if (error.IsOk() && values_.size() != 1) {
+    MathCalc::Fail(ErrorCode::kInvalidExpression, "Invalid expression",
+                   text_.length(), error);
+  }
+  double result = error.IsOk() ? Close(values_.back()) : 0.0;
+  Undo(size);
+  return result;
+}
+
+/**
+ * @brief Reverts the changes of the state until the undo log has the given
+ * size.
+ */
+void IncrementalParser::Undo(std::size_t size) {
+  while (changes_.size() > size) {
+    const Change& change = changes_.back();
+    switch (change.kind) {
+      case Change::Kind::kPushValue:
+        values_.pop_back();
+        break;
+      case Change::Kind::kPushOperator:
+        operators_.pop_back();
+        break;
+      case Change::Kind::kPopOperator:
+        operators_.push_back(change.op);
+        break;
+      case Change::Kind::kApply:
+        values_.pop_back();
+        values_.push_back(change.lhs);
+        if (change.op.type == TokenType::kBinaryOperator) {
+          values_.push_back(change.rhs);
+        }
+        operators_.push_back(change.op);
+        break;
+    }
+    changes_.pop_back();
+  }
+}
+
+/**
+ * @brief Pushes an operand to the value stack.
+ */
+void IncrementalParser::PushValue(const Value& value) {
+  values_.push_back(value);
+  changes_.push_back({Change::Kind::kPushValue, {}, {}, {}});
+}
+
+/**
+ * @brief Pushes an operator, function or open bracket to the operator stack.
+ */
+void IncrementalParser::PushOperator(const Operator& op) {
+  operators_.push_back(op);
+  changes_.push_back({Change::Kind::kPushOperator, {}, {}, {}});
+}
+
+/**
+ * @brief Resolves the opcode and position of an operator, function or open
+ * bracket token.
+ */
+IncrementalParser::Operator IncrementalParser::MakeOperator(
+    const Token& token) const {
+  Operator op = {token.GetType(), OpCode::kAdd, token.GetPriority(),
+                 token.IsRightAssociative(), MathCalc::Position(text_, token)};
+  if (op.position == text_.length()) {
+    op.position = kInserted;
+  }
+  if (token.IsFunction()) {
+    op.op = MathCalc::CompileFunction(token);
+  } else if (token.IsOperator()) {
+    op.op = MathCalc::CompileOperator(token);
+  }
+  return op;
+}
+
+/**
+ * @brief Computes the position of an operator in the text for an error.
+ *
+ * Omitted multiplications are placed at the end of the text, like in
+ * MathCalc.
+ */
+std::size_t IncrementalParser::Position(const Operator& op) const {
+  return op.position == kInserted ? text_.length() : op.position;
+}
+
+/**
+ * @brief Computes the length of the common prefix of two texts.
+ *
+ * The texts are compared with memcmp in blocks, and the common case of one
+ * text extending the other takes a single comparison.
+ */
+std::size_t IncrementalParser::CommonPrefix(std::string_view lhs,
+                                            std::string_view rhs) {
+  std::size_t length = std::min(lhs.length(), rhs.length());
+  if (lhs.substr(0, length) == rhs.substr(0, length)) {
+    return length;
+  }
+  std::size_t pos = 0;
+  while (lhs.substr(pos, kBlockSize) == rhs.substr(pos, kBlockSize)) {
+    pos += kBlockSize;
+  }
+  while (lhs[pos] == rhs[pos]) {
+    ++pos;
+  }
+  return pos;
+}
+
+/**
+ * @brief Checks if an entry of the operator stack is a unary or binary
+ * operator.
+ */
+bool IncrementalParser::IsOperator(const Operator& op) {
+  return op.type == TokenType::kUnaryOperator ||
+         op.type == TokenType::kBinaryOperator;
+}
+
+/**
+ * @brief Computes the result of an operator applied to its operands.
+ *
+ * The result is the one of the Program compiled by MathCalc: unary plus is
+ * dropped, subexpressions that do not depend on the variable are folded with
+ * Optimizer::Apply, small integer powers of the variable are computed with
+ * PowInt as rewritten by the Optimizer, and polynomial operands are
+ * evaluated by Horner's scheme unless the result is a polynomial too. The
+ * coefficients of constant results are not collected, as they are the
+ * constant itself.
+ *
+ * @param op The operator or function.
+ * @param lhs The first (or the only) operand.
+ * @param rhs The second operand of a binary operator.
+ * @return The result, whether it depends on the variable and its
+ * coefficients if it is a polynomial.
+ */
+IncrementalParser::Value IncrementalParser::Evaluate(const Operator& op,
+                                                     const Value& lhs,
+                                                     const Value& rhs) const {
+  bool binary = op.type == TokenType::kBinaryOperator;
+  if (op.type == TokenType::kUnaryOperator && op.op == OpCode::kAdd) {
+    return lhs;
+  }
+
+  Value result = {0.0, false, false, {}};
+  result.polynomial =
+      lhs.polynomial && (!binary || rhs.polynomial) &&
+      !(lhs.constant && (!binary || rhs.constant)) &&
+      Optimizer::Apply({op.op, 0.0}, lhs.terms, binary ? rhs.terms : lhs.terms,
+                       result.terms);
+  double a = result.polynomial ? lhs.value : Close(lhs);
+  double b = result.polynomial ? rhs.value : Close(rhs);
+
+  if (!binary) {
+    result.value = Optimizer::Apply({op.op, 0.0}, a);
+    result.constant = lhs.constant;
+  } else if (op.op == OpCode::kPow && !lhs.constant && rhs.constant &&
+             rhs.value == 0.0) {
+    result.value = 1.0;
+    result.constant = true;
+  } else if (op.op == OpCode::kPow && !lhs.constant && rhs.constant &&
+             Optimizer::IsInteger(rhs.value) &&
+             std::fabs(rhs.value) <= Optimizer::kMaxPowInt) {
+    result.value = PowInt(a, static_cast<long>(rhs.value));
+  } else {
+    result.value = Optimizer::Apply({op.op, 0.0}, a, b);
+    result.constant = lhs.constant && rhs.constant;
+  }
+
+  if (result.constant) {
+    result.polynomial = true;
+    result.terms = Optimizer::Polynomial::Constant(result.value);
+  }
+  return result;
+}
+
+/**
+ * @brief Computes the value of an operand as the Program does when it is
+ * used by an operation that is not a polynomial.
+ */
+double IncrementalParser::Close(const Value& value) const {
+  return value.polynomial && value.terms.IsSpecialized()
+             ? value.terms.Evaluate(x_)
+             : value.value;
+}
+
+}  // namespace s21
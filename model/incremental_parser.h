@@ -0,0 +1,149 @@
+#ifndef SMARTCALC_MODEL_INCREMENTAL_PARSER_H_
+#define SMARTCALC_MODEL_INCREMENTAL_PARSER_H_
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+#include "keyword_table.h"
+#include "math_calc.h"
+#include "optimizer.h"
+#include "program.h"
+#include "token.h"
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @class IncrementalParser
+ * @brief Evaluates an expression that is edited at its end, such as the text
+ * of the calculator display while it is being typed.
+ *
+ * IncrementalParser keeps the state of the Shunting-Yard algorithm for the
+ * current text and evaluates the operators as soon as they are emitted, so
+ * the state is a stack of values and a stack of pending operators. Every
+ * change of the state is recorded in an undo log, and a checkpoint is taken
+ * before every token. When the text is edited, the state is rolled back to
+ * the last checkpoint that the edit cannot affect and only the text after it
+ * is parsed again. Appending a token or removing one with backspace therefore
+ * takes constant time regardless of the length of the expression, apart from
+ * finding where the new text differs from the old one.
+ *
+ * The tokens are produced by the lexer of MathCalc and the operations are
+ * those of the compiled Program, so a valid expression has the same result as
+ * MathCalc::Calculate, down to the sign of a zero. An invalid expression is
+ * rejected with the same kind of
+ * error, although for an expression with several errors the first one in the
+ * text is reported rather than the first one found by MathCalc.
+ */
+class IncrementalParser {
+ public:
+  double Update(const std::string& expression, double x, Error& error);
+
+ private:
+  /**
+   * @struct Value
+   * @brief An operand on the value stack.
+   *
+   * Values that do not depend on the variable are constant, which decides
+   * the rewrites of the Optimizer that apply to them. Values that are
+   * polynomials also keep their coefficients: the value of a polynomial is
+   * computed term by term while it is a part of a larger polynomial, and by
+   * Horner's scheme once it is an operand of anything else, like the
+   * OpCode::kPolynomial emitted by the Optimizer.
+   */
+  struct Value {
+    double value;
+    bool constant;
+    bool polynomial;
+    Optimizer::Polynomial terms;
+  };
+
+  /**
+   * @struct Operator
+   * @brief An operator, function or open bracket on the operator stack.
+   *
+   * The position is the offset of the token in the text, or kInserted for an
+   * omitted multiplication.
+   */
+  struct Operator {
+    TokenType type;
+    OpCode op;
+    short priority;
+    bool right_associative;
+    std::size_t position;
+  };
+
+  /**
+   * @struct Change
+   * @brief An entry of the undo log.
+   *
+   * An applied operator keeps its operands, so that they can be restored.
+   */
+  struct Change {
+    enum class Kind : unsigned char {
+      kPushValue,
+      kPushOperator,
+      kPopOperator,
+      kApply
+    };
+
+    Kind kind;
+    Operator op;
+    Value lhs;
+    Value rhs;
+  };
+
+  /**
+   * @struct Checkpoint
+   * @brief The state before a token, or a space, of the text.
+   *
+   * The state is the size of the undo log and the type of the last token,
+   * which is all the lexer looks at when it resumes.
+   */
+  struct Checkpoint {
+    std::size_t offset;
+    std::size_t changes;
+    TokenType last;
+    bool has_last;
+  };
+
+  static constexpr std::size_t kInserted = static_cast<std::size_t>(-1);
+  static constexpr std::size_t kBlockSize = 64;
+
+  void Rollback(std::size_t pos);
+  bool Parse(Error& error);
+  bool Process(const Token& token, Error& error);
+  bool ProcessBrackets(const Token& token, Error& error);
+  bool Apply(Error& error);
+  double Finish(Error& error);
+  void Undo(std::size_t size);
+  void PushValue(const Value& value);
+  void PushOperator(const Operator& op);
+  Operator MakeOperator(const Token& token) const;
+  std::size_t Position(const Operator& op) const;
+  static std::size_t CommonPrefix(std::string_view lhs, std::string_view rhs);
+  static bool IsOperator(const Operator& op);
+  Value Evaluate(const Operator& op, const Value& lhs,
+                 const Value& rhs) const;
+  double Close(const Value& value) const;
+
+  std::string text_;
+  double x_ = 0.0;
+  VariableTable variables_;
+  std::vector<Value> values_;
+  std::vector<Operator> operators_;
+  std::vector<Change> changes_;
+  std::vector<Checkpoint> checkpoints_;
+  std::vector<Token> tokens_;
+  std::size_t resume_ = 0;
+  TokenType last_ = TokenType::kNumber;
+  bool has_last_ = false;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_INCREMENTAL_PARSER_H_
@@ -0,0 +1,492 @@
+#include "interval_evaluator.h"
+
+namespace s21 {
+
+/**
+ * @brief Bounds a compiled expression of at most one variable.
+ *
+ * @param program The compiled expression, as returned by MathCalc::Compile.
+ * @param x The range of the variable.
+ * @return An interval containing the value of the expression at every point
+ * of x where it is defined, or an empty interval if it is defined nowhere.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Evaluate(const Program& program,
+                                                        const Interval& x) {
+  if (program.variables.size() > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  return Execute(program, &x);
+}
+
+/**
+ * @brief Bounds a compiled expression over ranges of its variables.
+ *
+ * @param program The compiled expression, as returned by MathCalc::Compile.
+ * @param values The ranges of the variables in the order of their slots.
+ * @return An interval containing the value of the expression at every point
+ * of the ranges where it is defined, or an empty interval if it is defined
+ * nowhere.
+ * @throws std::logic_error if the number of ranges does not match the number
+ * of variables.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Evaluate(
+    const Program& program, const std::vector<Interval>& values) {
+  if (values.size() != program.variables.size()) {
+    throw std::logic_error("Invalid number of variable values");
+  }
+  return Execute(program, values.data());
+}
+
+/**
+ * @brief Executes the instructions of a Program on intervals.
+ *
+ * An empty operand makes the result empty, and the result is marked as
+ * possibly undefined if any of the operands is. The operand buffer is kept
+ * per thread and reused between calls.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Execute(const Program& program,
+                                                       const Interval* values) {
+  thread_local std::vector<Interval> stack;
+  if (stack.size() < program.depth) {
+    stack.resize(program.depth);
+  }
+  std::size_t top = 0;
+
+  for (const Instruction& instruction : program.code) {
+    OpCode op = instruction.op;
+    if (op == OpCode::kNumber) {
+      stack[top++] = {instruction.value, instruction.value, true};
+      continue;
+    }
+    if (op == OpCode::kVariable) {
+      const Interval& x = values[static_cast<std::size_t>(instruction.value)];
+      stack[top++] = x.IsEmpty() ? Empty() : x;
+      continue;
+    }
+    if (op == OpCode::kLoad) {
+      stack[top++] = stack[static_cast<std::size_t>(instruction.value)];
+      continue;
+    }
+    if (op == OpCode::kStore) {
+      stack[static_cast<std::size_t>(instruction.value)] = stack[top - 1];
+      continue;
+    }
+    if (op == OpCode::kCoefficient) {
+      continue;
+    }
+
+    if (IsBinary(op)) {
+      --top;
+    }
+    Interval& a = stack[top - 1];
+    const Interval& b = IsBinary(op) ? stack[top] : a;
+    if (a.IsEmpty() || b.IsEmpty()) {
+      a = Empty();
+      continue;
+    }
+
+    Interval result;
+    switch (op) {
+      case OpCode::kNegate:
+        result = {-a.upper, -a.lower, true};
+        break;
+      case OpCode::kAdd:
+        result = Add(a, b);
+        break;
+      case OpCode::kSub:
+        result = Sub(a, b);
+        break;
+      case OpCode::kMul:
+        result = Mul(a, b);
+        break;
+      case OpCode::kDiv:
+        result = Div(a, b);
+        break;
+      case OpCode::kPow:
+        result = Pow(a, b);
+        break;
+      case OpCode::kMod:
+        result = Mod(a, b);
+        break;
+      case OpCode::kPowInt:
+        result = PowInt(a, static_cast<long>(instruction.value));
+        break;
+      case OpCode::kPolynomial: {
+        const Instruction* coefficient = &instruction + 1;
+        result = {coefficient->value, coefficient->value, true};
+        for (std::size_t k = 0; k < static_cast<std::size_t>(instruction.value);
+             ++k) {
+          ++coefficient;
+          result = Add(Mul(result, a),
+                       {coefficient->value, coefficient->value, true});
+        }
+        break;
+      }
+      case OpCode::kSin:
+      case OpCode::kCos:
+        result = Periodic(a, op);
+        break;
+      case OpCode::kTan:
+        result = Tan(a);
+        break;
+      case OpCode::kAsin:
+        result = Restrict(a, -1.0, 1.0);
+        if (!result.IsEmpty()) {
+          result = Make(std::asin(result.lower), std::asin(result.upper),
+                        result.defined, kFunctionUlps);
+        }
+        break;
+      case OpCode::kAcos:
+        result = Restrict(a, -1.0, 1.0);
+        if (!result.IsEmpty()) {
+          result = Make(std::acos(result.upper), std::acos(result.lower),
+                        result.defined, kFunctionUlps);
+          result.lower = std::max(result.lower, 0.0);
+        }
+        break;
+      case OpCode::kAtan:
+        result = Make(std::atan(a.lower), std::atan(a.upper), true,
+                      kFunctionUlps);
+        break;
+      case OpCode::kSqrt:
+        result = Restrict(a, 0.0, std::numeric_limits<double>::infinity());
+        if (!result.IsEmpty()) {
+          result = Make(std::sqrt(result.lower), std::sqrt(result.upper),
+                        result.defined, 1);
+          result.lower = std::max(result.lower, 0.0);
+        }
+        break;
+      case OpCode::kLn:
+      case OpCode::kLog:
+        result = Restrict(a, 0.0, std::numeric_limits<double>::infinity());
+        if (!(result.upper > 0.0)) {
+          result = Empty();
+        } else if (op == OpCode::kLn) {
+          result = Make(std::log(result.lower), std::log(result.upper),
+                        result.defined && result.lower > 0.0, kFunctionUlps);
+        } else {
+          result = Make(std::log10(result.lower), std::log10(result.upper),
+                        result.defined && result.lower > 0.0, kFunctionUlps);
+        }
+        break;
+      default:
+        break;
+    }
+    result.defined = result.defined && a.defined && b.defined;
+    a = result;
+  }
+
+  return stack[0];
+}
+
+/**
+ * @brief Returns an empty interval.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Empty() {
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  return {nan, nan, false};
+}
+
+/**
+ * @brief Returns the interval of all real numbers.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Entire(bool defined) {
+  double inf = std::numeric_limits<double>::infinity();
+  return {-inf, inf, defined};
+}
+
+/**
+ * @brief Builds an interval from computed bounds.
+ *
+ * Each bound is moved outwards by the given number of units in the last
+ * place to cover the rounding error of its computation. A NaN bound, which
+ * results from operations on infinite bounds, becomes infinite.
+ *
+ * @param lower The computed lower bound.
+ * @param upper The computed upper bound.
+ * @param defined False if the expression may be undefined on the interval.
+ * @param ulps The maximum rounding error of the bounds.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Make(double lower, double upper,
+                                                    bool defined, int ulps) {
+  double inf = std::numeric_limits<double>::infinity();
+  lower = std::isnan(lower) ? -inf : lower;
+  upper = std::isnan(upper) ? inf : upper;
+  for (int i = 0; i < ulps; ++i) {
+    lower = std::nextafter(lower, -inf);
+    upper = std::nextafter(upper, inf);
+  }
+  return {lower, upper, defined};
+}
+
+/**
+ * @brief Adds two intervals.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Add(const Interval& a,
+                                                   const Interval& b) {
+  return Make(a.lower + b.lower, a.upper + b.upper, true, 1);
+}
+
+/**
+ * @brief Subtracts two intervals.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Sub(const Interval& a,
+                                                   const Interval& b) {
+  return Make(a.lower - b.upper, a.upper - b.lower, true, 1);
+}
+
+/**
+ * @brief Multiplies two intervals.
+ *
+ * The extremes of the product are attained at the corners.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Mul(const Interval& a,
+                                                   const Interval& b) {
+  double corners[] = {Product(a.lower, b.lower), Product(a.lower, b.upper),
+                      Product(a.upper, b.lower), Product(a.upper, b.upper)};
+  return Make(*std::min_element(corners, corners + 4),
+              *std::max_element(corners, corners + 4), true, 1);
+}
+
+/**
+ * @brief Divides two intervals.
+ *
+ * If the divisor contains zero the quotient is unbounded on the side of the
+ * pole and the expression is undefined at it. A divisor of exactly zero
+ * gives an infinity of either sign, as the bounds do not record the sign of
+ * the zero, and leaves nothing defined only if the dividend is zero as well.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Div(const Interval& a,
+                                                   const Interval& b) {
+  double inf = std::numeric_limits<double>::infinity();
+  if (b.lower > 0.0 || b.upper < 0.0) {
+    double corners[] = {a.lower / b.lower, a.lower / b.upper, a.upper / b.lower,
+                        a.upper / b.upper};
+    double lower = corners[0], upper = corners[0];
+    for (double corner : corners) {
+      lower = std::fmin(lower, corner);
+      upper = std::fmax(upper, corner);
+    }
+    return Make(lower, upper, true, 1);
+  }
+  if (b.lower == 0.0 && b.upper == 0.0) {
+    return a.lower == 0.0 && a.upper == 0.0 ? Empty() : Entire(false);
+  }
+  if (b.lower == 0.0 && a.lower >= 0.0) {
+    return Make(a.lower / b.upper, inf, false, 1);
+  }
+  if (b.lower == 0.0 && a.upper <= 0.0) {
+    return Make(-inf, a.upper / b.upper, false, 1);
+  }
+  if (b.upper == 0.0 && a.lower >= 0.0) {
+    return Make(-inf, a.lower / b.lower, false, 1);
+  }
+  if (b.upper == 0.0 && a.upper <= 0.0) {
+    return Make(a.upper / b.lower, inf, false, 1);
+  }
+  return Entire(false);
+}
+
+/**
+ * @brief Raises an interval to the power of another interval.
+ *
+ * An exponent that is a single integer is handled exactly like
+ * OpCode::kPowInt. Otherwise the positive part of the base is bounded from
+ * the corners, where the power is monotonic in each argument, and a negative
+ * base only contributes if the exponent range contains integers, in which
+ * case the power may take either sign.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Pow(const Interval& a,
+                                                   const Interval& b) {
+  if (b.lower == b.upper && std::abs(b.lower) < 0x1p53 &&
+      std::nearbyint(b.lower) == b.lower) {
+    return PowInt(a, static_cast<long>(b.lower));
+  }
+
+  Interval result = Empty();
+  if (a.upper >= 0.0) {
+    double base = std::max(a.lower, 0.0);
+    double corners[] = {std::pow(base, b.lower), std::pow(base, b.upper),
+                        std::pow(a.upper, b.lower), std::pow(a.upper, b.upper)};
+    result = Make(*std::min_element(corners, corners + 4),
+                  *std::max_element(corners, corners + 4),
+                  !(base == 0.0 && b.lower < 0.0), kFunctionUlps);
+  }
+  if (a.lower < 0.0) {
+    if (std::floor(b.upper) >= b.lower) {
+      double smallest = std::max(-a.upper, 0.0);
+      double largest = -a.lower;
+      double magnitude =
+          std::max({std::pow(smallest, b.lower), std::pow(smallest, b.upper),
+                    std::pow(largest, b.lower), std::pow(largest, b.upper)});
+      result = Hull(result, Make(-magnitude, magnitude, false, kFunctionUlps));
+    }
+    result.defined = false;
+  }
+  return result;
+}
+
+/**
+ * @brief Raises an interval to an integer power.
+ *
+ * The bounds are computed with std::pow and widened to also cover the
+ * rounding error of the repeated squaring used by the evaluators.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::PowInt(const Interval& a,
+                                                      long exponent) {
+  if (exponent == 0) {
+    return {1.0, 1.0, true};
+  }
+  if (exponent < 0) {
+    return Div({1.0, 1.0, true}, PowInt(a, -exponent));
+  }
+
+  int ulps = kFunctionUlps;
+  for (long n = exponent; n; n >>= 1) {
+    ulps += 2;
+  }
+  auto n = static_cast<double>(exponent);
+  if (exponent % 2) {
+    return Make(std::pow(a.lower, n), std::pow(a.upper, n), true, ulps);
+  }
+  double smallest = a.lower > 0.0    ? a.lower
+                    : a.upper < 0.0 ? -a.upper
+                                     : 0.0;
+  double largest = std::max(-a.lower, a.upper);
+  Interval result =
+      Make(std::pow(smallest, n), std::pow(largest, n), true, ulps);
+  result.lower = std::max(result.lower, 0.0);
+  return result;
+}
+
+/**
+ * @brief Computes the floating-point remainder of two intervals.
+ *
+ * The remainder has the sign of the dividend and is smaller in magnitude than
+ * both the dividend and the divisor. If the divisor is a single number and
+ * the dividend does not cross one of its multiples, the remainder is the
+ * dividend shifted by a constant and is bounded exactly.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Mod(const Interval& a,
+                                                   const Interval& b) {
+  if (b.lower == 0.0 && b.upper == 0.0) {
+    return Empty();
+  }
+  double divisor = std::max(std::abs(b.lower), std::abs(b.upper));
+  bool defined = b.lower > 0.0 || b.upper < 0.0;
+
+  if (b.lower == b.upper && (a.lower >= 0.0 || a.upper <= 0.0) &&
+      std::nextafter(a.upper - a.lower, divisor) < divisor) {
+    double lower = std::fmod(a.lower, divisor);
+    double upper = std::fmod(a.upper, divisor);
+    if (lower <= upper) {
+      return {lower, upper, defined};
+    }
+  }
+
+  double lower = a.lower >= 0.0 ? 0.0 : -std::min(-a.lower, divisor);
+  double upper = a.upper <= 0.0 ? 0.0 : std::min(a.upper, divisor);
+  return {lower, upper, defined};
+}
+
+/**
+ * @brief Bounds sin or cos over an interval.
+ *
+ * The function is monotonic between its extremes, so the bounds are the
+ * values at the ends unless a maximum or a minimum lies inside.
+ *
+ * @param a The argument.
+ * @param op OpCode::kSin or OpCode::kCos.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Periodic(const Interval& a,
+                                                        OpCode op) {
+  if (!(a.upper - a.lower < 2 * kPi) ||
+      std::max(std::abs(a.lower), std::abs(a.upper)) > 0x1p40) {
+    return {-1.0, 1.0, true};
+  }
+  bool sine = op == OpCode::kSin;
+  double peak = sine ? kPi / 2 : 0.0;
+  double first = sine ? std::sin(a.lower) : std::cos(a.lower);
+  double last = sine ? std::sin(a.upper) : std::cos(a.upper);
+  Interval result = Make(std::min(first, last), std::max(first, last), true,
+                         kFunctionUlps);
+  if (ContainsPhase(a.lower, a.upper, peak, 2 * kPi)) {
+    result.upper = 1.0;
+  }
+  if (ContainsPhase(a.lower, a.upper, peak + kPi, 2 * kPi)) {
+    result.lower = -1.0;
+  }
+  result.lower = std::max(result.lower, -1.0);
+  result.upper = std::min(result.upper, 1.0);
+  return result;
+}
+
+/**
+ * @brief Bounds tan over an interval.
+ *
+ * Between two poles tan is increasing; an interval around a pole is mapped
+ * to all real numbers.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Tan(const Interval& a) {
+  if (!(a.upper - a.lower < kPi) ||
+      std::max(std::abs(a.lower), std::abs(a.upper)) > 0x1p40 ||
+      ContainsPhase(a.lower, a.upper, kPi / 2, kPi)) {
+    return Entire(false);
+  }
+  return Make(std::tan(a.lower), std::tan(a.upper), true, kFunctionUlps);
+}
+
+/**
+ * @brief Intersects an interval with the domain of a function.
+ *
+ * @return The intersection, marked as possibly undefined if the interval
+ * leaves the domain, or an empty interval if they do not intersect.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Restrict(const Interval& a,
+                                                        double lower,
+                                                        double upper) {
+  Interval result = {std::max(a.lower, lower), std::min(a.upper, upper),
+                     a.lower >= lower && a.upper <= upper};
+  return result.IsEmpty() ? Empty() : result;
+}
+
+/**
+ * @brief Returns the smallest interval containing two intervals.
+ */
+IntervalEvaluator::Interval IntervalEvaluator::Hull(const Interval& a,
+                                                    const Interval& b) {
+  if (a.IsEmpty()) {
+    return b;
+  }
+  if (b.IsEmpty()) {
+    return a;
+  }
+  return {std::min(a.lower, b.lower), std::max(a.upper, b.upper),
+          a.defined && b.defined};
+}
+
+/**
+ * @brief Checks if an interval may contain a point phase + k * period.
+ *
+ * The points are computed in floating point, so the interval is extended by
+ * a margin that covers their rounding error and the answer errs on the side
+ * of containment.
+ */
+bool IntervalEvaluator::ContainsPhase(double lower, double upper, double phase,
+                                      double period) {
+  double margin =
+      1e-14 * std::max({1.0, std::abs(lower), std::abs(upper)});
+  double k = std::ceil((lower - margin - phase) / period);
+  return phase + k * period <= upper + margin ||
+         phase + (k - 1) * period >= lower - margin;
+}
+
+/**
+ * @brief Multiplies two bounds, treating zero times infinity as zero.
+ */
+double IntervalEvaluator::Product(double a, double b) {
+  return a == 0.0 || b == 0.0 ? 0.0 : a * b;
+}
+
+}  // namespace s21
@@ -0,0 +1,75 @@
+#ifndef SMARTCALC_MODEL_INTERVAL_EVALUATOR_H_
+#define SMARTCALC_MODEL_INTERVAL_EVALUATOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "program.h"
+
+namespace s21 {
+
+/**
+ * @class IntervalEvaluator
+ * @brief A class for bounding compiled expressions over intervals.
+ *
+ * IntervalEvaluator executes a Program on intervals instead of numbers and
+ * returns an interval that is guaranteed to contain the value of the
+ * expression at every point of the input where it is defined. Every bound is
+ * rounded outwards, and the domains of sqrt, ln, log, asin, acos, the poles of
+ * tan and the divisions by zero are tracked, so the result also tells whether
+ * the expression may be undefined somewhere on the input or nowhere defined at
+ * all. The bounds are not always tight, but they never exclude a value the
+ * expression takes, which makes them suitable for discarding whole regions in
+ * plotting and in searches for roots and extrema.
+ */
+class IntervalEvaluator {
+ public:
+  /**
+   * @struct Interval
+   * @brief A closed range of real numbers.
+   *
+   * The bounds may be infinite. An interval with NaN bounds is empty. The
+   * defined flag of a result is cleared if the expression may be undefined
+   * at some point of the input.
+   */
+  struct Interval {
+    double lower = 0.0;
+    double upper = 0.0;
+    bool defined = true;
+
+    bool IsEmpty() const { return !(lower <= upper); }
+  };
+
+  static Interval Evaluate(const Program& program, const Interval& x);
+  static Interval Evaluate(const Program& program,
+                           const std::vector<Interval>& values);
+
+ private:
+  static constexpr int kFunctionUlps = 2;
+  static constexpr double kPi = 3.14159265358979323846;
+
+  static Interval Execute(const Program& program, const Interval* values);
+  static Interval Empty();
+  static Interval Entire(bool defined);
+  static Interval Make(double lower, double upper, bool defined, int ulps);
+  static Interval Add(const Interval& a, const Interval& b);
+  static Interval Sub(const Interval& a, const Interval& b);
+  static Interval Mul(const Interval& a, const Interval& b);
+  static Interval Div(const Interval& a, const Interval& b);
+  static Interval Pow(const Interval& a, const Interval& b);
+  static Interval PowInt(const Interval& a, long exponent);
+  static Interval Mod(const Interval& a, const Interval& b);
+  static Interval Periodic(const Interval& a, OpCode op);
+  static Interval Tan(const Interval& a);
+  static Interval Restrict(const Interval& a, double lower, double upper);
+  static Interval Hull(const Interval& a, const Interval& b);
+  static bool ContainsPhase(double lower, double upper, double phase,
+                            double period);
+  static double Product(double a, double b);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_INTERVAL_EVALUATOR_H_
@@ -0,0 +1,374 @@
+#include "jit_program.h"
+
+#if defined(__x86_64__) && defined(__unix__)
+#include <sys/mman.h>
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Constructor of the JitProgram class.
+ *
+ * Translates the Program into machine code and maps it into memory that is
+ * first writable and then only executable. If translation is not supported or
+ * the memory cannot be mapped, the JitProgram falls back to the interpreter.
+ * Only expressions with at most one variable are translated.
+ *
+ * @param program A valid compiled expression.
+ */
+JitProgram::JitProgram(const Program& program) : program_(program) {
+#if defined(__x86_64__) && defined(__unix__)
+  if (program.variables.size() > 1) {
+    return;
+  }
+  std::vector<unsigned char> bytes = Link(Translate(program));
+  void* memory = mmap(nullptr, bytes.size(), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    return;
+  }
+  std::memcpy(memory, bytes.data(), bytes.size());
+  if (mprotect(memory, bytes.size(), PROT_READ | PROT_EXEC) != 0) {
+    munmap(memory, bytes.size());
+    return;
+  }
+  memory_ = memory;
+  size_ = bytes.size();
+  function_ = reinterpret_cast<Function>(memory);
+#endif
+}
+
+/**
+ * @brief Destructor of the JitProgram class.
+ *
+ * Unmaps the machine code.
+ */
+JitProgram::~JitProgram() {
+#if defined(__x86_64__) && defined(__unix__)
+  if (memory_) {
+    munmap(memory_, size_);
+  }
+#endif
+}
+
+/**
+ * @brief Checks if expressions can be translated into machine code on this
+ * platform.
+ *
+ * @return True on x86-64 Unix systems, False otherwise.
+ */
+bool JitProgram::IsSupported() {
+#if defined(__x86_64__) && defined(__unix__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief Checks if the expression runs as machine code.
+ *
+ * @return True if the expression was translated, False if it falls back to
+ * the interpreter.
+ */
+bool JitProgram::IsNative() const { return function_ != nullptr; }
+
+/**
+ * @brief Calculate the result of the expression with a given variable value.
+ *
+ * The generated code only uses its own stack frame, so the same JitProgram
+ * may be called by several threads at once.
+ *
+ * @param x The value of the variable 'x' in the expression.
+ * @return The result of evaluating the expression.
+ */
+double JitProgram::Calculate(double x) const {
+  return function_ ? function_(x) : MathCalc::Calculate(program_, x);
+}
+
+/**
+ * @brief Calculate the results of the expression for an array of variable
+ * values.
+ *
+ * @param x The values of the variable.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of values.
+ */
+void JitProgram::Calculate(const double* x, double* y,
+                           std::size_t size) const {
+  for (std::size_t i = 0; i < size; ++i) {
+    y[i] = Calculate(x[i]);
+  }
+}
+
+/**
+ * @brief Translates a Program into the machine code of a function taking and
+ * returning a double.
+ *
+ * The generated function follows the System V calling convention. The top of
+ * the operand stack lives in xmm0, the operand below it in slot top - 2 of the
+ * stack frame, the temporaries in their slots above the operands and the
+ * variable in slot depth. Operands are spilled to the
+ * frame only when a new one is pushed, and since all slots are in memory,
+ * calls to library functions need no further saving. The frame keeps the
+ * stack pointer aligned to 16 bytes as required for calls. Every arithmetic
+ * operation is performed by the same single SSE2 instruction as in the
+ * compiled interpreter, and integer powers and polynomials use the same
+ * sequence of multiplications and additions as PowInt and Horner, so the
+ * results are identical.
+ *
+ * @param program A valid compiled expression.
+ * @return The code with unresolved references to its constants.
+ */
+JitProgram::Code JitProgram::Translate(const Program& program) {
+  Code code;
+  std::uint32_t frame = ((program.depth + 1) * 8 + 15) / 16 * 16 + 8;
+  std::size_t top = 0;
+
+  EmitStackFrame(code, 0xEC, frame);
+  EmitSlot(code, 0x11, 0, program.depth);
+
+  for (const Instruction& instruction : program.code) {
+    switch (instruction.op) {
+      case OpCode::kNumber:
+      case OpCode::kVariable:
+      case OpCode::kLoad:
+        if (top > 0) {
+          EmitSlot(code, 0x11, 0, top - 1);
+        }
+        if (instruction.op == OpCode::kNumber) {
+          EmitConstant(code, 0xF2, 0x10, 0, instruction.value);
+        } else if (instruction.op == OpCode::kVariable) {
+          EmitSlot(code, 0x10, 0, program.depth);
+        } else {
+          EmitSlot(code, 0x10, 0, static_cast<std::size_t>(instruction.value));
+        }
+        ++top;
+        break;
+      case OpCode::kStore:
+        EmitSlot(code, 0x11, 0, static_cast<std::size_t>(instruction.value));
+        break;
+      case OpCode::kNegate:
+        EmitConstant(code, 0x66, 0x57, 0, -0.0);
+        break;
+      case OpCode::kAdd:
+      case OpCode::kSub:
+      case OpCode::kMul:
+      case OpCode::kDiv: {
+        static constexpr std::uint8_t kOpcodes[] = {0x58, 0x5C, 0x59, 0x5E};
+        std::size_t index = static_cast<std::size_t>(instruction.op) -
+                            static_cast<std::size_t>(OpCode::kAdd);
+        EmitSlot(code, 0x10, 1, top - 2);
+        EmitRegister(code, 0xF2, kOpcodes[index], 1, 0);
+        EmitRegister(code, 0x66, 0x28, 0, 1);
+        --top;
+        break;
+      }
+      case OpCode::kPow:
+      case OpCode::kMod:
+        EmitRegister(code, 0x66, 0x28, 1, 0);
+        EmitSlot(code, 0x10, 0, top - 2);
+        EmitCall(code, LibraryFunction(instruction.op));
+        --top;
+        break;
+      case OpCode::kPowInt:
+        EmitPowInt(code, static_cast<long>(instruction.value));
+        break;
+      case OpCode::kPolynomial: {
+        const Instruction* coefficient = &instruction + 1;
+        EmitRegister(code, 0x66, 0x28, 1, 0);
+        EmitConstant(code, 0xF2, 0x10, 0, coefficient->value);
+        for (std::size_t k = 0; k < static_cast<std::size_t>(instruction.value);
+             ++k) {
+          ++coefficient;
+          EmitRegister(code, 0xF2, 0x59, 0, 1);
+          EmitConstant(code, 0xF2, 0x58, 0, coefficient->value);
+        }
+        break;
+      }
+      case OpCode::kCoefficient:
+        break;
+      case OpCode::kSqrt:
+        EmitRegister(code, 0xF2, 0x51, 0, 0);
+        break;
+      default:
+        EmitCall(code, LibraryFunction(instruction.op));
+        break;
+    }
+  }
+
+  EmitStackFrame(code, 0xC4, frame);
+  code.bytes.push_back(0xC3);
+  return code;
+}
+
+/**
+ * @brief Emits a sub or add instruction adjusting the stack pointer.
+ *
+ * @param modrm 0xEC for sub rsp, 0xC4 for add rsp.
+ * @param offset The size of the stack frame.
+ */
+void JitProgram::EmitStackFrame(Code& code, std::uint8_t modrm,
+                                std::uint32_t offset) {
+  code.bytes.insert(code.bytes.end(), {0x48, 0x81, modrm});
+  for (int i = 0; i < 4; ++i) {
+    code.bytes.push_back(static_cast<unsigned char>(offset >> (8 * i)));
+  }
+}
+
+/**
+ * @brief Emits a scalar double instruction with an operand in a slot of the
+ * stack frame.
+ *
+ * @param opcode The second opcode byte, such as 0x10 for a load or 0x11 for a
+ * store.
+ * @param reg The number of the xmm register.
+ * @param slot The index of the slot.
+ */
+void JitProgram::EmitSlot(Code& code, std::uint8_t opcode, int reg,
+                          std::size_t slot) {
+  std::uint32_t offset = static_cast<std::uint32_t>(slot * 8);
+  code.bytes.insert(code.bytes.end(),
+                    {0xF2, 0x0F, opcode,
+                     static_cast<unsigned char>(0x84 | reg << 3), 0x24});
+  for (int i = 0; i < 4; ++i) {
+    code.bytes.push_back(static_cast<unsigned char>(offset >> (8 * i)));
+  }
+}
+
+/**
+ * @brief Emits an instruction with a constant operand addressed relative to
+ * the instruction pointer.
+ *
+ * Constants are stored once per bit pattern in 16-byte entries after the
+ * code, so that they can also serve as operands of packed instructions.
+ *
+ * @param prefix The mandatory prefix, 0xF2 for scalar or 0x66 for packed
+ * instructions.
+ * @param opcode The second opcode byte.
+ * @param reg The number of the xmm register.
+ * @param value The constant.
+ */
+void JitProgram::EmitConstant(Code& code, std::uint8_t prefix,
+                              std::uint8_t opcode, int reg, double value) {
+  std::size_t index = 0;
+  while (index < code.constants.size() &&
+         std::memcmp(&code.constants[index], &value, sizeof(value)) != 0) {
+    ++index;
+  }
+  if (index == code.constants.size()) {
+    code.constants.push_back(value);
+  }
+  code.bytes.insert(code.bytes.end(),
+                    {prefix, 0x0F, opcode,
+                     static_cast<unsigned char>(0x05 | reg << 3)});
+  code.fixups.emplace_back(code.bytes.size(), index);
+  code.bytes.insert(code.bytes.end(), 4, 0);
+}
+
+/**
+ * @brief Emits an instruction with two xmm register operands.
+ */
+void JitProgram::EmitRegister(Code& code, std::uint8_t prefix,
+                              std::uint8_t opcode, int dst, int src) {
+  unsigned char modrm = static_cast<unsigned char>(0xC0 | dst << 3 | src);
+  code.bytes.insert(code.bytes.end(), {prefix, 0x0F, opcode, modrm});
+}
+
+/**
+ * @brief Emits a call of a function at an absolute address.
+ */
+void JitProgram::EmitCall(Code& code, std::uintptr_t function) {
+  code.bytes.insert(code.bytes.end(), {0x48, 0xB8});
+  for (int i = 0; i < 8; ++i) {
+    code.bytes.push_back(static_cast<unsigned char>(function >> (8 * i)));
+  }
+  code.bytes.insert(code.bytes.end(), {0xFF, 0xD0});
+}
+
+/**
+ * @brief Emits the multiplications of PowInt unrolled for a given exponent.
+ *
+ * The base is taken from xmm0 and the result is accumulated in xmm1.
+ */
+void JitProgram::EmitPowInt(Code& code, long exponent) {
+  unsigned long n = std::labs(exponent);
+  EmitConstant(code, 0xF2, 0x10, 1, 1.0);
+  while (n) {
+    if (n & 1) {
+      EmitRegister(code, 0xF2, 0x59, 1, 0);
+    }
+    n >>= 1;
+    if (n) {
+      EmitRegister(code, 0xF2, 0x59, 0, 0);
+    }
+  }
+  if (exponent < 0) {
+    EmitConstant(code, 0xF2, 0x10, 0, 1.0);
+    EmitRegister(code, 0xF2, 0x5E, 0, 1);
+  } else {
+    EmitRegister(code, 0x66, 0x28, 0, 1);
+  }
+}
+
+/**
+ * @brief Returns the address of the library function implementing an opcode.
+ */
+std::uintptr_t JitProgram::LibraryFunction(OpCode op) {
+  using Unary = double (*)(double);
+  using Binary = double (*)(double, double);
+
+  switch (op) {
+    case OpCode::kPow:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Binary>(std::pow));
+    case OpCode::kMod:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Binary>(std::fmod));
+    case OpCode::kSin:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::sin));
+    case OpCode::kCos:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::cos));
+    case OpCode::kTan:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::tan));
+    case OpCode::kAsin:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::asin));
+    case OpCode::kAcos:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::acos));
+    case OpCode::kAtan:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::atan));
+    case OpCode::kLn:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::log));
+    case OpCode::kLog:
+      return reinterpret_cast<std::uintptr_t>(static_cast<Unary>(std::log10));
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Appends the constants to the code and resolves the references to
+ * them.
+ *
+ * @param code The translated code.
+ * @return The machine code ready to be copied into executable memory.
+ */
+std::vector<unsigned char> JitProgram::Link(const Code& code) {
+  std::vector<unsigned char> bytes = code.bytes;
+  bytes.resize((bytes.size() + 15) / 16 * 16, 0xCC);
+  std::size_t constants = bytes.size();
+
+  for (double value : code.constants) {
+    unsigned char entry[16] = {};
+    std::memcpy(entry, &value, sizeof(value));
+    bytes.insert(bytes.end(), entry, entry + sizeof(entry));
+  }
+
+  for (const auto& [position, index] : code.fixups) {
+    std::int32_t offset = static_cast<std::int32_t>(constants + index * 16 -
+                                                    (position + 4));
+    std::memcpy(&bytes[position], &offset, sizeof(offset));
+  }
+
+  return bytes;
+}
+
+}  // namespace s21
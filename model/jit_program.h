@@ -0,0 +1,74 @@
+#ifndef SMARTCALC_MODEL_JIT_PROGRAM_H_
+#define SMARTCALC_MODEL_JIT_PROGRAM_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "math_calc.h"
+#include "program.h"
+
+namespace s21 {
+
+/**
+ * @class JitProgram
+ * @brief A compiled expression translated into native machine code.
+ *
+ * JitProgram translates a Program into x86-64 machine code in an executable
+ * memory buffer, which removes the instruction dispatch of the interpreter.
+ * The top of the operand stack is kept in a register and the rest of the
+ * stack in the frame of the generated function; arithmetic is performed with
+ * scalar SSE2 instructions and elementary functions are called from the C
+ * library, so the results are identical to those of MathCalc. On other
+ * processors, or if the system does not allow executable memory, the Program
+ * is run by the interpreter instead, which is transparent to the caller.
+ */
+class JitProgram {
+ public:
+  explicit JitProgram(const Program& program);
+  ~JitProgram();
+
+  JitProgram(const JitProgram&) = delete;
+  JitProgram& operator=(const JitProgram&) = delete;
+
+  static bool IsSupported();
+  bool IsNative() const;
+  double Calculate(double x) const;
+  void Calculate(const double* x, double* y, std::size_t size) const;
+
+ private:
+  using Function = double (*)(double);
+
+  /**
+   * @struct Code
+   * @brief Machine code of a function followed by its constants.
+   */
+  struct Code {
+    std::vector<unsigned char> bytes;
+    std::vector<double> constants;
+    std::vector<std::pair<std::size_t, std::size_t>> fixups;
+  };
+
+  static Code Translate(const Program& program);
+  static void EmitStackFrame(Code& code, std::uint8_t modrm,
+                             std::uint32_t offset);
+  static void EmitSlot(Code& code, std::uint8_t opcode, int reg,
+                       std::size_t slot);
+  static void EmitConstant(Code& code, std::uint8_t prefix,
+                           std::uint8_t opcode, int reg, double value);
+  static void EmitRegister(Code& code, std::uint8_t prefix,
+                           std::uint8_t opcode, int dst, int src);
+  static void EmitCall(Code& code, std::uintptr_t function);
+  static void EmitPowInt(Code& code, long exponent);
+  static std::uintptr_t LibraryFunction(OpCode op);
+  static std::vector<unsigned char> Link(const Code& code);
+
+  Program program_;
+  void* memory_ = nullptr;
+  std::size_t size_ = 0;
+  Function function_ = nullptr;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_JIT_PROGRAM_H_
@@ -0,0 +1,119 @@
+#ifndef SMARTCALC_MODEL_KEYWORD_TABLE_H_
+#define SMARTCALC_MODEL_KEYWORD_TABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+#include "program.h"
+#include "token.h"
+
+namespace s21 {
+
+/**
+ * @struct Keyword
+ * @brief A reserved word of the expression language.
+ *
+ * Keywords are the names of the functions and of the "mod" operator, together
+ * with the type and priority of their tokens and the opcode they compile to.
+ */
+struct Keyword {
+  std::string_view name;
+  TokenType type;
+  OpCode op;
+  short priority;
+};
+
+/**
+ * @class KeywordTable
+ * @brief Perfect hash table of the reserved words.
+ *
+ * The slot of a word is computed from its first two letters and its length,
+ * which is free of collisions for the reserved words. The slots are assigned
+ * at compile time and a collision fails the build, so a lookup costs one hash
+ * and at most one comparison, without any allocation. No keyword is longer
+ * than kMaxLength.
+ */
+class KeywordTable {
+ public:
+  static constexpr std::size_t kMaxLength = 4;
+
+  static const Keyword* Find(std::string_view word);
+
+ private:
+  static constexpr std::size_t kSlots = 13;
+  static constexpr unsigned char kEmpty = 0xFF;
+  static constexpr Keyword kKeywords[] = {
+      {"sin", TokenType::kFunction, OpCode::kSin, 0},
+      {"cos", TokenType::kFunction, OpCode::kCos, 0},
+      {"tan", TokenType::kFunction, OpCode::kTan, 0},
+      {"asin", TokenType::kFunction, OpCode::kAsin, 0},
+      {"acos", TokenType::kFunction, OpCode::kAcos, 0},
+      {"atan", TokenType::kFunction, OpCode::kAtan, 0},
+      {"sqrt", TokenType::kFunction, OpCode::kSqrt, 0},
+      {"ln", TokenType::kFunction, OpCode::kLn, 0},
+      {"log", TokenType::kFunction, OpCode::kLog, 0},
+      {"mod", TokenType::kBinaryOperator, OpCode::kMod, 2},
+  };
+
+  static constexpr std::size_t Hash(std::string_view word);
+  static constexpr std::array<unsigned char, kSlots> BuildIndex();
+};
+
+/**
+ * @brief Computes the slot of a word of at least two characters.
+ */
+constexpr std::size_t KeywordTable::Hash(std::string_view word) {
+  return (static_cast<unsigned char>(word[0]) +
+          3 * static_cast<unsigned char>(word[1]) + 7 * word.size()) %
+         kSlots;
+}
+
+/**
+ * @brief Maps every slot to the index of its keyword.
+ *
+ * @throws std::logic_error if two keywords share a slot or a keyword is
+ * longer than kMaxLength, which is a compile time error when the index is
+ * built in a constant expression.
+ */
+constexpr std::array<unsigned char, KeywordTable::kSlots>
+KeywordTable::BuildIndex() {
+  std::array<unsigned char, kSlots> index{};
+  for (unsigned char& slot : index) {
+    slot = kEmpty;
+  }
+  for (std::size_t i = 0; i < std::size(kKeywords); ++i) {
+    std::size_t slot = Hash(kKeywords[i].name);
+    if (kKeywords[i].name.size() > kMaxLength) {
+      throw std::logic_error("Keyword too long");
+    }
+    if (index[slot] != kEmpty) {
+      throw std::logic_error("Keyword hash collision");
+    }
+    index[slot] = static_cast<unsigned char>(i);
+  }
+  return index;
+}
+
+/**
+ * @brief Looks up a reserved word.
+ *
+ * @param word The word to be looked up.
+ * @return The keyword, or nullptr if the word is not reserved.
+ */
+inline const Keyword* KeywordTable::Find(std::string_view word) {
+  static constexpr std::array<unsigned char, kSlots> kIndex = BuildIndex();
+  if (word.size() < 2) {
+    return nullptr;
+  }
+  unsigned char index = kIndex[Hash(word)];
+  if (index == kEmpty || kKeywords[index].name != word) {
+    return nullptr;
+  }
+  return &kKeywords[index];
+}
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_KEYWORD_TABLE_H_
@@ -5,23 +5,23 @@ namespace s21 {
 /**
  * @brief Constructor of the MathCalc class.
  *
- * The constructor takes a mathematical expression as a string and then
- * converts it to Reverse Polish Notation (RPN) using the ParseExpression and
- * ConvertToRPN methods, and stores the resulting RPN expression within the
- * MathCalc object.
+ * The constructor takes a mathematical expression as a string, converts it to
+ * Reverse Polish Notation (RPN) using the ParseExpression and ConvertToRPN
+ * methods, compiles the RPN into a Program and stores it within the MathCalc
+ * object.
  *
  * @param expression Mathematical expression as a string.
  */
 MathCalc::MathCalc(const std::string& expression)
-    : rpn_{ConvertToRPN(ParseExpression(expression))} {}
+    : program_{Compile(expression)} {}
 
 /**
  * @brief Calculate the result of the mathematical expression with a given
  * variable value.
  *
  * This method parses the input mathematical expression, converts it to Reverse
- * Polish Notation (RPN), and then evaluates the RPN expression with the
- * provided value for the variable 'x'.
+ * Polish Notation (RPN), compiles it into a Program, and then executes the
+ * Program with the provided value for the variable 'x'.
  *
  * @param expression The mathematical expression to be evaluated.
  * @param x The value of the variable 'x' in the expression.
@@ -29,103 +29,554 @@ MathCalc::MathCalc(const std::string& expression)
  * value.
  */
 double MathCalc::Calculate(const std::string& expression, double x) {
-  std::vector<Token> tokens = ParseExpression(expression);
-  std::vector<Token> rpn = ConvertToRPN(tokens);
-  return EvaluateRPN(rpn, x);
+  return Calculate(Compile(expression), x);
 }
 
 /**
  * @brief Calculate the results of the mathematical expression for a range of
  * variable values.
  *
- * This method generates a vector of variable values from x_min to x_max
- * (inclusive) with a specified step size. It then parses the input mathematical
- * expression, converts it to Reverse Polish Notation (RPN), and evaluates the
- * RPN expression with the generated vector of variable values.
+ * This method parses the input mathematical expression and compiles it once.
+ * It then generates variable values from x_min to x_max (inclusive) with a
+ * specified step size and executes the resulting Program for all of them with
+ * the VectorEvaluator. The results of elementary functions may differ from the
+ * scalar overloads by the few units in the last place documented in
+ * VectorMath.
+ *
+ * The range is processed in chunks of kChunkSize values, which fit into the
+ * L1 cache together with their results. With more than one thread the chunks
+ * are distributed over the shared ThreadPool. Every value is computed in the
+ * same way regardless of its chunk, so the results do not depend on the number
+ * of threads.
  *
  * @param expression The mathematical expression to be evaluated.
  * @param x_min The minimum value of the variables in the expression.
  * @param x_max The maximum value of the variables in the expression.
  * @param size The number of points to be generated between x_min and x_max
  * (inclusive).
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
  * @return A pair of vectors: the first vector contains the generated variable
  * values, and the second vector contains the results of evaluating the
  * expression with the specified variable values.
  */
 std::pair<std::vector<double>, std::vector<double>> MathCalc::Calculate(
     const std::string& expression, double x_min, double x_max,
-    std::size_t size) {
+    std::size_t size, std::size_t threads) {
+  return Calculate(Compile(expression), x_min, x_max, size, threads);
+}
+
+/**
+ * @brief Calculate the results of the mathematical expression for a range of
+ * variable values without throwing.
+ *
+ * An invalid expression is reported through the error and yields empty
+ * vectors. Otherwise every point is evaluated, and points where the result is
+ * undefined or infinite are marked in the status instead of failing the
+ * whole range.
+ *
+ * @param expression The mathematical expression to be evaluated.
+ * @param x_min The minimum value of the variables in the expression.
+ * @param x_max The maximum value of the variables in the expression.
+ * @param size The number of points to be generated between x_min and x_max
+ * (inclusive).
+ * @param status Receives the status of every point.
+ * @param error Receives the reason if the expression is invalid.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>> MathCalc::Calculate(
+    const std::string& expression, double x_min, double x_max,
+    std::size_t size, std::vector<PointStatus>& status, Error& error,
+    std::size_t threads) {
+  Program program = Compile(expression, error);
+  if (!error.IsOk()) {
+    status.clear();
+    return {};
+  }
+  return Calculate(program, x_min, x_max, size, status, threads);
+}
+
+/**
+ * @brief Calculate the results of a compiled expression for a range of
+ * variable values.
+ *
+ * Works like the overload taking the expression as a string, but skips
+ * parsing and compilation. The Program is only read, so it may be shared
+ * between threads.
+ *
+ * @param program The compiled expression, as returned by Compile.
+ * @param x_min The minimum value of the variables in the expression.
+ * @param x_max The maximum value of the variables in the expression.
+ * @param size The number of points to be generated between x_min and x_max
+ * (inclusive).
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>> MathCalc::Calculate(
+    const ProgramView& program, double x_min, double x_max, std::size_t size,
+    std::size_t threads) {
+  return Tabulate(program, x_min, x_max, size, nullptr, Precision::kDouble,
+                  threads);
+}
+
+/**
+ * @brief Calculate the results of a compiled expression for a range of
+ * variable values together with the status of every point.
+ *
+ * @param program The compiled expression, as returned by Compile.
+ * @param x_min The minimum value of the variables in the expression.
+ * @param x_max The maximum value of the variables in the expression.
+ * @param size The number of points to be generated between x_min and x_max
+ * (inclusive).
+ * @param status Receives PointStatus::kUndefined for every NaN result,
+ * PointStatus::kInfinite for every infinite one and PointStatus::kOk for the
+ * others.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>> MathCalc::Calculate(
+    const ProgramView& program, double x_min, double x_max, std::size_t size,
+    std::vector<PointStatus>& status, std::size_t threads) {
+  status.resize(size);
+  return Tabulate(program, x_min, x_max, size, status.data(),
+                  Precision::kDouble, threads);
+}
+
+/**
+ * @brief Calculate the results of a compiled expression for a range of
+ * variable values in a given precision.
+ *
+ * The variable values are generated in double precision. With
+ * Precision::kSingle they are rounded to float and evaluated with the float
+ * vector path, whose results differ from the double ones by the rounding
+ * of the values and constants of the expression to float and the few float
+ * ULP documented in VectorMath. With Precision::kExtended every value is
+ * evaluated in long double with the scalar interpreter, which is slower but
+ * only rounded once, when the result is converted to double.
+ *
+ * @param program The compiled expression, as returned by Compile.
+ * @param x_min The minimum value of the variables in the expression.
+ * @param x_max The maximum value of the variables in the expression.
+ * @param size The number of points to be generated between x_min and x_max
+ * (inclusive).
+ * @param precision The scalar type the expression is evaluated in.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ * @return A pair of vectors with the variable values and the results.
+ */
+std::pair<std::vector<double>, std::vector<double>> MathCalc::Calculate(
+    const ProgramView& program, double x_min, double x_max, std::size_t size,
+    Precision precision, std::size_t threads) {
+  return Tabulate(program, x_min, x_max, size, nullptr, precision, threads);
+}
+
+/**
+ * @brief Evaluates a range in chunks and classifies the results of every
+ * chunk while they are still in the cache.
+ *
+ * @param status The output buffer for the status of every point, or nullptr.
+ */
+std::pair<std::vector<double>, std::vector<double>> MathCalc::Tabulate(
+    const ProgramView& program, double x_min, double x_max, std::size_t size,
+    PointStatus* status, Precision precision, std::size_t threads) {
   std::vector<double> x(size), y(size);
   double step = (x_max - x_min) / (size - 1);
-  std::iota(x.begin(), x.end(), 0);
-  std::for_each(x.begin(), x.end(),
-                [x_min, step](double& value) { value = x_min + value * step; });
-  std::vector<Token> tokens = ParseExpression(expression);
-  std::vector<Token> rpn = ConvertToRPN(tokens);
-  std::transform(x.begin(), x.end(), y.begin(),
-                 [&rpn](double value) { return EvaluateRPN(rpn, value); });
+  std::size_t chunks = (size + kChunkSize - 1) / kChunkSize;
+
+  auto calculate_chunk = [&](std::size_t chunk) {
+    std::size_t begin = chunk * kChunkSize;
+    std::size_t end = std::min(begin + kChunkSize, size);
+    for (std::size_t i = begin; i < end; ++i) {
+      x[i] = x_min + static_cast<double>(i) * step;
+    }
+    TabulateChunk(program, x.data() + begin, y.data() + begin, end - begin,
+                  precision);
+    if (status) {
+      for (std::size_t i = begin; i < end; ++i) {
+        status[i] = std::isnan(y[i])   ? PointStatus::kUndefined
+                    : std::isinf(y[i]) ? PointStatus::kInfinite
+                                       : PointStatus::kOk;
+      }
+    }
+  };
+
+  if (threads == 1 || chunks <= 1) {
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+      calculate_chunk(chunk);
+    }
+  } else {
+    ThreadPool::Shared().ParallelFor(chunks, calculate_chunk, threads);
+  }
   return {x, y};
 }
 
+/**
+ * @brief Evaluates a chunk of a range in a given precision.
+ *
+ * The float buffers of the single precision path are kept per thread and
+ * hold at most kChunkSize values, so they stay in the cache and are not
+ * reallocated between chunks.
+ */
+void MathCalc::TabulateChunk(const ProgramView& program, const double* x,
+                             double* y, std::size_t size,
+                             Precision precision) {
+  switch (precision) {
+    case Precision::kSingle: {
+      thread_local std::vector<float> x_single, y_single;
+      x_single.resize(size);
+      y_single.resize(size);
+      std::copy(x, x + size, x_single.begin());
+      VectorEvaluator::Evaluate(program, x_single.data(), y_single.data(),
+                                size);
+      std::copy(y_single.begin(), y_single.end(), y);
+      break;
+    }
+    case Precision::kDouble:
+      VectorEvaluator::Evaluate(program, x, y, size);
+      break;
+    case Precision::kExtended:
+      for (std::size_t i = 0; i < size; ++i) {
+        y[i] = static_cast<double>(
+            Evaluate(program, static_cast<long double>(x[i])));
+      }
+      break;
+  }
+}
+
+/**
+ * @brief Calculate the results of a compiled expression for columns of
+ * variable values.
+ *
+ * Every row consists of the values at the same index in all columns, so a
+ * table of size rows is passed as one contiguous column per variable and the
+ * results are written to a single output column. Like the range overload, the
+ * rows are processed in chunks of kChunkSize with the VectorEvaluator, and
+ * with more than one thread the chunks are distributed over the shared
+ * ThreadPool without changing the results.
+ *
+ * @param program The compiled expression, as returned by Compile.
+ * @param columns One column of size values per variable of the Program, in
+ * the order of the slots of the VariableTable it was compiled with.
+ * @param y The output column, which receives size results.
+ * @param size The number of rows.
+ * @param threads The number of threads to use, or 0 to use one thread per
+ * hardware thread.
+ */
+void MathCalc::Calculate(const ProgramView& program,
+                         const double* const* columns, double* y,
+                         std::size_t size, std::size_t threads) {
+  std::size_t chunks = (size + kChunkSize - 1) / kChunkSize;
+
+  auto calculate_chunk = [&](std::size_t chunk) {
+    std::size_t begin = chunk * kChunkSize;
+    std::size_t end = std::min(begin + kChunkSize, size);
+    std::vector<const double*> rows(columns, columns + program.variables);
+    for (const double*& row : rows) {
+      row += begin;
+    }
+    VectorEvaluator::Evaluate(program, rows.data(), y + begin, end - begin);
+  };
+
+  if (threads == 1 || chunks <= 1) {
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+      calculate_chunk(chunk);
+    }
+  } else {
+    ThreadPool::Shared().ParallelFor(chunks, calculate_chunk, threads);
+  }
+}
+
 /**
  * @brief Calculate the result of the stored mathematical expression with a
  * given variable value.
  *
  * This method evaluates the previously stored mathematical expression (which
  * was provided during object construction) with the provided value for the
- * variable 'x'.
+ * variable 'x'. The operand buffer is kept per thread, so the method may be
+ * called by several threads at once.
  *
  * @param x The value of the variable 'x' in the stored expression.
  * @return The result of evaluating the stored expression with the specified
  * variable value.
  */
-double MathCalc::Calculate(double x) { return EvaluateRPN(rpn_, x); }
+double MathCalc::Calculate(double x) const { return Evaluate(program_, x); }
+
+/**
+ * @brief Computes the canonical form of an expression.
+ *
+ * The canonical form is derived from the tokens of the expression, so it does
+ * not depend on whitespace or on whether multiplications are written out or
+ * implied, and numbers are written with all significant digits of their
+ * value, so "2x", "2 * x" and "2.0*x" share the same canonical form. Two
+ * expressions with the same canonical form compile into the same Program
+ * with the same VariableTable, which makes it suitable as a key for caching
+ * compiled expressions.
+ *
+ * @param expression The mathematical expression.
+ * @param variables The variables that may appear in the expression.
+ * @return The canonical form of the expression.
+ * @throws std::logic_error if the expression cannot be tokenized.
+ */
+std::string MathCalc::Canonicalize(const std::string& expression,
+                                   const VariableTable& variables) {
+  Error error;
+  std::string canonical = Canonicalize(expression, error, variables);
+  if (!error.IsOk()) {
+    throw std::logic_error(error.message);
+  }
+  return canonical;
+}
+
+/**
+ * @brief Computes the canonical form of an expression without throwing.
+ *
+ * @param expression The mathematical expression.
+ * @param error Receives the reason if the expression cannot be tokenized.
+ * @param variables The variables that may appear in the expression.
+ * @return The canonical form of the expression, or an empty string on error.
+ */
+std::string MathCalc::Canonicalize(const std::string& expression, Error& error,
+                                   const VariableTable& variables) {
+  std::vector<Token> tokens;
+  std::string canonical;
+  error = Error();
+  if (!ParseExpression(expression, variables, tokens, error)) {
+    return canonical;
+  }
+
+  for (const Token& token : tokens) {
+    if (token.IsNumber()) {
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "%.17g", token.GetValue());
+      canonical += buffer;
+    } else {
+      if (token.IsUnaryOperator()) {
+        canonical += 'u';
+      }
+      canonical += token.GetToken();
+    }
+    canonical += ' ';
+  }
+
+  return canonical;
+}
+
+/**
+ * @brief Compiles a mathematical expression into a Program.
+ *
+ * The resulting Program does not depend on the MathCalc object and can be
+ * executed any number of times, also by several threads at once, with the
+ * overloads of Calculate taking a Program. Every variable is resolved to its
+ * slot in the VariableTable, and the Program reads the value of the variable
+ * from that slot.
+ *
+ * @param expression The mathematical expression.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled and optimized Program.
+ * @throws std::logic_error if the expression is invalid or uses a variable
+ * that is not in the table.
+ */
+Program MathCalc::Compile(const std::string& expression,
+                          const VariableTable& variables) {
+  Error error;
+  Program program = Compile(expression, error, variables);
+  if (!error.IsOk()) {
+    throw std::logic_error(error.message);
+  }
+  return program;
+}
+
+/**
+ * @brief Compiles a mathematical expression into a Program without throwing.
+ *
+ * Invalid expressions are reported through the error instead of an
+ * exception, which makes rejecting them about as cheap as compiling valid
+ * ones.
+ *
+ * @param expression The mathematical expression.
+ * @param error Receives the code, message and position of the first error,
+ * or ErrorCode::kOk if the expression is valid.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled and optimized Program, or an empty Program on error.
+ */
+Program MathCalc::Compile(const std::string& expression, Error& error,
+                          const VariableTable& variables) {
+  std::vector<Token> tokens;
+  std::vector<Token> rpn;
+  Program program;
+  error = Error();
+  if (!ParseExpression(expression, variables, tokens, error) ||
+      !ConvertToRPN(expression, tokens, rpn, error) ||
+      !Compile(expression, rpn, variables, program, error)) {
+    return Program();
+  }
+  return program;
+}
+
+/**
+ * @brief Calculate the result of a compiled expression with a given variable
+ * value.
+ *
+ * The operand buffer is kept per thread and reused between calls, so no
+ * memory is allocated once the buffer is large enough.
+ *
+ * @param program The compiled expression, as returned by Compile, with at
+ * most one variable.
+ * @param x The value of the variable in the expression.
+ * @return The result of evaluating the expression.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+double MathCalc::Calculate(const ProgramView& program, double x) {
+  return Evaluate(program, x);
+}
+
+/**
+ * @brief Evaluates a compiled expression with a given variable value in the
+ * scalar type T.
+ *
+ * The constants of the Program are rounded to T and every operation is
+ * performed in T with the functions of <cmath> for that type. Constant
+ * subexpressions have already been folded in double by the Optimizer, so
+ * long double only extends the precision of the operations that depend on
+ * the variable. The template is instantiated for float, double and long
+ * double.
+ *
+ * @param program The compiled expression, as returned by Compile, with at
+ * most one variable.
+ * @param x The value of the variable in the expression.
+ * @return The result of evaluating the expression.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+template <class T>
+T MathCalc::Evaluate(const ProgramView& program, T x) {
+  if (program.variables > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  thread_local std::vector<T> stack;
+  if (stack.size() < program.depth) {
+    stack.resize(program.depth);
+  }
+  return Execute(program, &x, stack.data());
+}
+
+template float MathCalc::Evaluate(const ProgramView& program, float x);
+template double MathCalc::Evaluate(const ProgramView& program, double x);
+template long double MathCalc::Evaluate(const ProgramView& program,
+                                        long double x);
+
+/**
+ * @brief Calculate the result of a compiled expression with given values of
+ * its variables.
+ *
+ * @param program The compiled expression, as returned by Compile.
+ * @param values The values of the variables in the order of their slots.
+ * @return The result of evaluating the expression.
+ * @throws std::logic_error if the number of values does not match the number
+ * of variables.
+ */
+double MathCalc::Calculate(const ProgramView& program,
+                           const std::vector<double>& values) {
+  if (values.size() != program.variables) {
+    throw std::logic_error("Invalid number of variable values");
+  }
+  thread_local std::vector<double> stack;
+  if (stack.size() < program.depth) {
+    stack.resize(program.depth);
+  }
+  return Execute(program, values.data(), stack.data());
+}
 
 /**
  * @brief Parses the given expression into a vector of tokens.
  *
  * This method takes an input mathematical expression as a string and tokenizes
- * it, creating a vector of tokens that represent the expression.
+ * it, creating a vector of tokens that represent the expression. The tokens
+ * refer to the text of the expression, and the end of a run of letters is
+ * found once for all the tokens in it, so the time is linear in the length of
+ * the expression.
  *
  * @param expression The input mathematical expression to be parsed.
- * @return A vector of tokens representing the parsed expression.
- * @throws std::logic_error if the expression contains invalid characters
- * or if it is missing an operator between consecutive operands or variables.
+ * @param variables The variables that may appear in the expression.
+ * @param tokens The vector to store the parsed tokens.
+ * @param error Receives the reason if the expression contains invalid
+ * characters or if it is missing an operator between consecutive operands or
+ * variables.
+ * @return True if the expression was tokenized, False otherwise.
  */
-std::vector<Token> MathCalc::ParseExpression(const std::string& expression) {
-  std::vector<Token> tokens;
+bool MathCalc::ParseExpression(std::string_view expression,
+                               const VariableTable& variables,
+                               std::vector<Token>& tokens, Error& error) {
   std::size_t pos = 0;
+  std::size_t alpha_end = 0;
 
-  while (pos < expression.length()) {
-    char ch = expression[pos];
+  if (!ValidateVariables(variables, error)) {
+    return false;
+  }
 
-    if (std::isdigit(ch)) {
-      InsertOmittedMul(tokens, true);
-      pos = ParseNumber(expression, pos, tokens);
-    } else if (ch == '.') {
-      pos = ParseNumber(expression, pos, tokens);
-    } else if (std::isalpha(ch)) {
-      pos = ParseAlpha(expression, pos, tokens);
-    } else if (ch == '(') {
-      InsertOmittedMul(tokens);
-      tokens.push_back(Token(TokenType::kOpenBracket, "("));
-      ++pos;
-    } else if (ch == ')') {
-      tokens.push_back(Token(TokenType::kCloseBracket, ")"));
-      ++pos;
-    } else if (ch == '+' || ch == '-' || ch == '*' || ch == '/' || ch == '^') {
-      pos = ParseOperator(expression, pos, tokens);
-    } else if (std::isspace(ch)) {
-      if (!ValidateSpaces(expression, pos)) {
-        throw std::logic_error("Invalid expression: missing operator");
-      }
-      ++pos;
-    } else {
-      throw std::logic_error("Invalid character: " + std::string(1, ch));
-    }
+  while (pos < expression.length() && error.IsOk()) {
+    pos = ParseToken(expression, pos, alpha_end, variables, tokens, error);
   }
 
-  return tokens;
+  return error.IsOk();
+}
+
+/**
+ * @brief Parses the token or the space at the given position.
+ *
+ * A token may be preceded by an omitted multiplication, which is inserted
+ * before it. The tokens parsed so far are only inspected at their end, so
+ * parsing can resume at any token boundary given the last token before it.
+ *
+ * @param expression The input mathematical expression to be parsed.
+ * @param pos The position of the token or space.
+ * @param alpha_end The end of the last run of letters found, which is updated
+ * when the token starts a new run.
+ * @param variables The variables that may appear in the expression.
+ * @param tokens The vector to store the parsed tokens.
+ * @param error Receives the reason if the token is invalid.
+ * @return The position after the parsed token or space.
+ */
+std::size_t MathCalc::ParseToken(std::string_view expression, std::size_t pos,
+                                 std::size_t& alpha_end,
+                                 const VariableTable& variables,
+                                 std::vector<Token>& tokens, Error& error) {
+  char ch = expression[pos];
+
+  if (std::isdigit(static_cast<unsigned char>(ch))) {
+    InsertOmittedMul(tokens, true);
+    return ParseNumber(expression, pos, tokens, error);
+  }
+  if (ch == '.') {
+    return ParseNumber(expression, pos, tokens, error);
+  }
+  if (std::isalpha(static_cast<unsigned char>(ch))) {
+    if (pos >= alpha_end) {
+      alpha_end = FindAlphaEnd(expression, pos);
+    }
+    return ParseAlpha(expression, pos, alpha_end, tokens, variables, error);
+  }
+  if (ch == '(') {
+    InsertOmittedMul(tokens);
+    tokens.push_back(Token(TokenType::kOpenBracket, expression.substr(pos, 1)));
+  } else if (ch == ')') {
+    tokens.push_back(
+        Token(TokenType::kCloseBracket, expression.substr(pos, 1)));
+  } else if (ch == '+' || ch == '-' || ch == '*' || ch == '/' || ch == '^') {
+    return ParseOperator(expression, pos, tokens, error);
+  } else if (std::isspace(static_cast<unsigned char>(ch))) {
+    if (!ValidateSpaces(expression, pos, tokens, variables)) {
+      Fail(ErrorCode::kMissingOperator, "Invalid expression: missing operator",
+           pos, error);
+    }
+  } else {
+    Fail(ErrorCode::kInvalidCharacter,
+         "Invalid character: " + std::string(1, ch), pos, error);
+  }
+  return pos + 1;
 }
 
 /**
@@ -135,11 +586,15 @@ std::vector<Token> MathCalc::ParseExpression(const std::string& expression) {
  * This method takes a vector of input tokens in infix notation and transforms
  * them into the equivalent expression in RPN using the Shunting-Yard algorithm.
  *
+ * @param expression The expression the tokens refer to.
  * @param tokens A vector of input tokens in infix notation.
- * @return A vector of tokens representing the same expression in RPN.
+ * @param rpn The vector to store the same expression in RPN.
+ * @param error Receives the reason if the brackets do not match.
+ * @return True if the expression was converted, False otherwise.
  */
-std::vector<Token> MathCalc::ConvertToRPN(const std::vector<Token>& tokens) {
-  std::vector<Token> rpn;
+bool MathCalc::ConvertToRPN(std::string_view expression,
+                            const std::vector<Token>& tokens,
+                            std::vector<Token>& rpn, Error& error) {
   std::stack<Token> operators;
 
   for (const Token& token : tokens) {
@@ -148,68 +603,228 @@ std::vector<Token> MathCalc::ConvertToRPN(const std::vector<Token>& tokens) {
     } else if (token.IsFunction() || token.IsOpenBracket()) {
       operators.push(token);
     } else if (token.IsCloseBracket()) {
-      ProcessBrackets(operators, rpn);
+      if (!ProcessBrackets(operators, rpn)) {
+        return Fail(ErrorCode::kInvalidBrackets, "Invalid bracket sequence",
+                    Position(expression, token), error);
+      }
     } else if (token.IsOperator()) {
       ProcessOperators(token, operators, rpn);
     }
   }
 
-  ProcessRemainingOperators(operators, rpn);
+  if (!ProcessRemainingOperators(operators, rpn)) {
+    return Fail(ErrorCode::kInvalidBrackets, "Invalid bracket sequence",
+                Position(expression, operators.top()), error);
+  }
 
-  return rpn;
+  return true;
 }
 
 /**
- * @brief Evaluates an expression in Reverse Polish Notation (RPN) given a value
- * for the variable 'x'.
+ * @brief Compiles an expression in Reverse Polish Notation (RPN) into a
+ * Program.
+ *
+ * This method translates every token of the RPN expression into an
+ * instruction: numeric literals are decoded into doubles, and operators and
+ * functions are mapped to opcodes, so that no string handling is left for
+ * evaluation. While doing so it tracks the depth of the operand stack, which
+ * both validates the expression and determines the size of the operand buffer
+ * required to execute it. Unary plus does not change its operand and is
+ * omitted from the Program. The valid Program is then simplified by the
+ * Optimizer.
  *
+ * @param expression The expression the tokens refer to.
  * @param rpn A vector of tokens representing the expression in RPN.
- * @param x The value to substitute for the variable 'x'.
- * @return The result of evaluating the expression.
- * @throws std::logic_error if the RPN expression is invalid or contains
- * too few or too many operands.
+ * @param variables The table the variables of the expression are resolved
+ * against.
+ * @param program Receives the compiled and optimized Program.
+ * @param error Receives the reason if the RPN expression is invalid or
+ * contains too few or too many operands.
+ * @return True if the expression was compiled, False otherwise.
  */
-double MathCalc::EvaluateRPN(const std::vector<Token>& rpn, double x) {
-  std::stack<double> operands;
+bool MathCalc::Compile(std::string_view expression,
+                       const std::vector<Token>& rpn,
+                       const VariableTable& variables, Program& program,
+                       Error& error) {
+  program.variables = variables.GetNames();
+  std::size_t depth = 0;
 
   for (const Token& token : rpn) {
     if (token.IsNumber()) {
-      operands.push(std::stod(token.GetToken()));
+      program.code.push_back({OpCode::kNumber, token.GetValue()});
+      ++depth;
     } else if (token.IsVariable()) {
-      operands.push(x);
-    } else if (token.IsOperator()) {
-      ProcessOperator(token, operands);
+      std::size_t slot = variables.Find(token.GetToken());
+      program.code.push_back({OpCode::kVariable, static_cast<double>(slot)});
+      ++depth;
+    } else if (token.IsUnaryOperator()) {
+      if (depth < 1) {
+        return Fail(ErrorCode::kMissingOperand,
+                    "Not enough operands for unary operator",
+                    Position(expression, token), error);
+      }
+      OpCode op = CompileOperator(token);
+      if (op != OpCode::kAdd) {
+        program.code.push_back({op, 0.0});
+      }
+    } else if (token.IsBinaryOperator()) {
+      if (depth < 2) {
+        return Fail(ErrorCode::kMissingOperand,
+                    "Not enough operands for binary operator",
+                    Position(expression, token), error);
+      }
+      program.code.push_back({CompileOperator(token), 0.0});
+      --depth;
     } else if (token.IsFunction()) {
-      ProcessFunction(token, operands);
+      if (depth < 1) {
+        return Fail(ErrorCode::kMissingOperand,
+                    "Not enough operands for function: " +
+                        std::string(token.GetToken()),
+                    Position(expression, token), error);
+      }
+      program.code.push_back({CompileFunction(token), 0.0});
     }
+    program.depth = std::max(program.depth, depth);
   }
 
-  if (operands.size() != 1) {
-    throw std::logic_error("Invalid expression");
+  if (depth != 1) {
+    return Fail(ErrorCode::kInvalidExpression, "Invalid expression",
+                expression.length(), error);
+  }
+
+  program = Optimizer::Optimize(program);
+  return true;
+}
+
+/**
+ * @brief Executes a compiled Program given the values of its variables.
+ *
+ * The operand stack is kept in a caller-provided flat buffer, which must hold
+ * at least program.depth values. The Program is expected to be valid, as
+ * ensured by Compile, so no checks are performed during execution.
+ *
+ * @param program The compiled expression.
+ * @param values The values to substitute for the variables, indexed by slot.
+ * @param stack The operand buffer used during execution.
+ * @return The result of evaluating the expression.
+ */
+template <class T>
+T MathCalc::Execute(const ProgramView& program, const T* values, T* stack) {
+  std::size_t top = 0;
+
+  for (std::size_t i = 0; i < program.length; ++i) {
+    const Instruction& instruction = program.code[i];
+    switch (instruction.op) {
+      case OpCode::kNumber:
+        stack[top++] = static_cast<T>(instruction.value);
+        break;
+      case OpCode::kVariable:
+        stack[top++] = values[static_cast<std::size_t>(instruction.value)];
+        break;
+      case OpCode::kNegate:
+        stack[top - 1] = -stack[top - 1];
+        break;
+      case OpCode::kAdd:
+        --top;
+        stack[top - 1] += stack[top];
+        break;
+      case OpCode::kSub:
+        --top;
+        stack[top - 1] -= stack[top];
+        break;
+      case OpCode::kMul:
+        --top;
+        stack[top - 1] *= stack[top];
+        break;
+      case OpCode::kDiv:
+        --top;
+        stack[top - 1] /= stack[top];
+        break;
+      case OpCode::kPow:
+        --top;
+        stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+        break;
+      case OpCode::kMod:
+        --top;
+        stack[top - 1] = std::fmod(stack[top - 1], stack[top]);
+        break;
+      case OpCode::kPowInt:
+        stack[top - 1] =
+            PowInt(stack[top - 1], static_cast<long>(instruction.value));
+        break;
+      case OpCode::kSin:
+        stack[top - 1] = std::sin(stack[top - 1]);
+        break;
+      case OpCode::kCos:
+        stack[top - 1] = std::cos(stack[top - 1]);
+        break;
+      case OpCode::kTan:
+        stack[top - 1] = std::tan(stack[top - 1]);
+        break;
+      case OpCode::kAsin:
+        stack[top - 1] = std::asin(stack[top - 1]);
+        break;
+      case OpCode::kAcos:
+        stack[top - 1] = std::acos(stack[top - 1]);
+        break;
+      case OpCode::kAtan:
+        stack[top - 1] = std::atan(stack[top - 1]);
+        break;
+      case OpCode::kSqrt:
+        stack[top - 1] = std::sqrt(stack[top - 1]);
+        break;
+      case OpCode::kLn:
+        stack[top - 1] = std::log(stack[top - 1]);
+        break;
+      case OpCode::kLog:
+        stack[top - 1] = std::log10(stack[top - 1]);
+        break;
+      case OpCode::kStore:
+        stack[static_cast<std::size_t>(instruction.value)] = stack[top - 1];
+        break;
+      case OpCode::kLoad:
+        stack[top++] = stack[static_cast<std::size_t>(instruction.value)];
+        break;
+      case OpCode::kPolynomial: {
+        std::size_t degree = static_cast<std::size_t>(instruction.value);
+        stack[top - 1] = Horner(&instruction + 1, degree, stack[top - 1]);
+        i += degree + 1;
+        break;
+      }
+      case OpCode::kCoefficient:
+        break;
+    }
   }
 
-  return operands.top();
+  return stack[0];
 }
 
 /**
  * @brief Parses a numeric token from the expression starting at the given
  * position.
  *
+ * The number is decoded with std::from_chars, which does not depend on the
+ * locale and does not allocate.
+ *
  * @param expression The expression to parse.
  * @param pos The starting position for parsing.
  * @param tokens The vector to store the parsed tokens.
+ * @param error Receives the reason if the parsed number is invalid.
  * @return The new position after parsing the number.
- * @throws std::logic_error if the parsed number is invalid.
  */
-std::size_t MathCalc::ParseNumber(const std::string& expression,
-                                  std::size_t pos, std::vector<Token>& tokens) {
+std::size_t MathCalc::ParseNumber(std::string_view expression,
+                                  std::size_t pos, std::vector<Token>& tokens,
+                                  Error& error) {
   std::size_t start = pos;
-  auto is_exp = [](char ch) { return std::toupper(ch) == 'E'; };
+  auto is_exp = [](char ch) {
+    return std::toupper(static_cast<unsigned char>(ch)) == 'E';
+  };
   auto is_exp_sign = [](char ch) { return ch == '+' || ch == '-'; };
 
   while (pos < expression.length()) {
     char ch = expression[pos];
-    if (!std::isdigit(ch) && ch != '.' && !is_exp(ch)) {
+    if (!std::isdigit(static_cast<unsigned char>(ch)) && ch != '.' &&
+        !is_exp(ch)) {
       break;
     }
     if (is_exp(ch)) {
@@ -224,13 +839,19 @@ std::size_t MathCalc::ParseNumber(const std::string& expression,
     ++pos;
   }
 
-  std::string tok = expression.substr(start, pos - start);
+  std::string_view tok = expression.substr(start, pos - start);
+  double value = 0.0;
+  auto [end, result] =
+      std::from_chars(tok.data(), tok.data() + tok.size(), value);
 
-  if (!ValidateNumber(tok)) {
-    throw std::logic_error("Invalid number: " + tok);
+  if (!ValidateNumber(tok) || end != tok.data() + tok.size() ||
+      result != std::errc()) {
+    Fail(ErrorCode::kInvalidNumber, "Invalid number: " + std::string(tok),
+         start, error);
+    return pos;
   }
 
-  tokens.push_back(Token(TokenType::kNumber, tok));
+  tokens.push_back(Token(TokenType::kNumber, tok, 0, value));
 
   return pos;
 }
@@ -239,36 +860,86 @@ std::size_t MathCalc::ParseNumber(const std::string& expression,
  * @brief Parses an alpha token from the expression starting at the given
  * position.
  *
+ * A run of letters may contain several tokens written without separators,
+ * such as "2xcos(x)" or "x mody". The token at the given position is the
+ * longest word that is a variable, the "mod" operator or, at the end of the
+ * run only, a function name, since a function must be followed by its
+ * argument in brackets.
+ *
  * @param expression The expression string.
  * @param pos The current position within the expression.
+ * @param end The end of the run of letters containing the position.
  * @param tokens The vector to store parsed tokens.
+ * @param variables The variables that may appear in the expression.
+ * @param error Receives the reason if no valid token starts at the position.
  * @return The new position after parsing the alpha token.
- * @throws std::logic_error if the parsed token is not a valid alpha token.
  */
-std::size_t MathCalc::ParseAlpha(const std::string& expression, std::size_t pos,
-                                 std::vector<Token>& tokens) {
-  std::size_t start = pos;
-  while (pos < expression.length() && std::isalpha(expression[pos]) &&
-         expression.substr(start, pos - start) != "mod" &&
-         expression.substr(start, pos - start) != "x") {
-    ++pos;
+std::size_t MathCalc::ParseAlpha(std::string_view expression, std::size_t pos,
+                                 std::size_t end, std::vector<Token>& tokens,
+                                 const VariableTable& variables, Error& error) {
+  std::string_view word = expression.substr(pos, end - pos);
+  std::size_t length = MatchAlpha(word, variables);
+  if (length == 0) {
+    Fail(ErrorCode::kInvalidToken, "Invalid token: " + std::string(word), pos,
+         error);
+    return end;
   }
-  std::string tok = expression.substr(start, pos - start);
+  std::string_view tok = word.substr(0, length);
 
-  if (!ValidateAlpha(tok)) {
-    throw std::logic_error("Invalid token: " + tok);
-  }
-
-  if (tok == "x") {
+  if (variables.Find(tok) != VariableTable::kNotFound) {
     InsertOmittedMul(tokens);
     tokens.push_back(Token(TokenType::kVariable, tok));
-  } else if (tok == "mod") {
-    tokens.push_back(Token(TokenType::kBinaryOperator, tok, 2));
   } else {
-    InsertOmittedMul(tokens);
-    tokens.push_back(Token(TokenType::kFunction, tok));
+    const Keyword* keyword = KeywordTable::Find(tok);
+    if (keyword->type == TokenType::kFunction) {
+      InsertOmittedMul(tokens);
+    }
+    tokens.push_back(Token(keyword->type, tok, keyword->priority));
+  }
+
+  return pos + length;
+}
+
+/**
+ * @brief Finds the longest alpha token at the start of a run of letters.
+ *
+ * Variables are compared with the start of the run, and function names are
+ * looked up in the KeywordTable only for the whole run.
+ *
+ * @param word The rest of a run of letters.
+ * @param variables The variables that may appear in the expression.
+ * @return The length of the token, or 0 if no valid token starts the run.
+ */
+std::size_t MathCalc::MatchAlpha(std::string_view word,
+                                 const VariableTable& variables) {
+  std::size_t length = 0;
+  for (const std::string& name : variables.GetNames()) {
+    if (name.length() > length && word.substr(0, name.length()) == name) {
+      length = name.length();
+    }
+  }
+  if (length < 3 && word.substr(0, 3) == "mod") {
+    length = 3;
+  }
+  const Keyword* keyword = KeywordTable::Find(word);
+  if (keyword && keyword->type == TokenType::kFunction &&
+      word.length() > length) {
+    length = word.length();
   }
+  return length;
+}
 
+/**
+ * @brief Finds the end of the run of letters and underscores starting at the
+ * given position.
+ */
+std::size_t MathCalc::FindAlphaEnd(std::string_view expression,
+                                   std::size_t pos) {
+  while (pos < expression.length() &&
+         (std::isalpha(static_cast<unsigned char>(expression[pos])) ||
+          expression[pos] == '_')) {
+    ++pos;
+  }
   return pos;
 }
 
@@ -279,12 +950,12 @@ std::size_t MathCalc::ParseAlpha(const std::string& expression, std::size_t pos,
  * @param expression The expression string.
  * @param pos The current position within the expression.
  * @param tokens The vector to store parsed tokens.
- * @throws std::logic_error if the parsed operator is not valid.
+ * @param error Receives the reason if the parsed operator is not valid.
  * @return The new position after parsing the operator token.
  */
-std::size_t MathCalc::ParseOperator(const std::string& expression,
-                                    std::size_t pos,
-                                    std::vector<Token>& tokens) {
+std::size_t MathCalc::ParseOperator(std::string_view expression,
+                                    std::size_t pos, std::vector<Token>& tokens,
+                                    Error& error) {
   char op = expression[pos];
   TokenType type;
   short priority;
@@ -308,10 +979,12 @@ std::size_t MathCalc::ParseOperator(const std::string& expression,
       priority = 3;
       break;
     default:
-      throw std::logic_error("Invalid operator: " + std::string(1, op));
+      Fail(ErrorCode::kInvalidCharacter,
+           "Invalid operator: " + std::string(1, op), pos, error);
+      return pos + 1;
   }
 
-  tokens.push_back(Token(type, std::string(1, op), priority));
+  tokens.push_back(Token(type, expression.substr(pos, 1), priority));
   ++pos;
 
   return pos;
@@ -346,16 +1019,17 @@ void MathCalc::InsertOmittedMul(std::vector<Token>& tokens, bool flg) {
  * @param token The string to be validated.
  * @return True if the string represents a valid number, False otherwise.
  */
-bool MathCalc::ValidateNumber(const std::string& token) {
+bool MathCalc::ValidateNumber(std::string_view token) {
   bool has_dot = false;
   bool has_e = false;
   bool has_sign = false;
 
   for (char ch : token) {
-    if (!std::isdigit(ch)) {
+    if (!std::isdigit(static_cast<unsigned char>(ch))) {
       if (ch == '.' && !has_dot && !has_e) {
         has_dot = true;
-      } else if ((std::toupper(ch) == 'E') && !has_e) {
+      } else if (std::toupper(static_cast<unsigned char>(ch)) == 'E' &&
+                 !has_e) {
         has_e = true;
       } else if ((ch == '+' || ch == '-') && has_e && !has_sign) {
         has_sign = true;
@@ -365,8 +1039,9 @@ bool MathCalc::ValidateNumber(const std::string& token) {
     }
   }
 
-  if (has_e && (std::toupper(token.front()) == 'E' ||
-                std::toupper(token.back()) == 'E')) {
+  if (has_e &&
+      (std::toupper(static_cast<unsigned char>(token.front())) == 'E' ||
+       std::toupper(static_cast<unsigned char>(token.back())) == 'E')) {
     return false;
   }
 
@@ -378,166 +1053,149 @@ bool MathCalc::ValidateNumber(const std::string& token) {
 }
 
 /**
- * @brief Validates if a given string represents a valid alphanumeric token.
+ * @brief Checks that the variables do not clash with the names of functions
+ * and operators.
  *
- * This method checks if the input string is a valid alphanumeric token, which
- * can be one of the predefined valid tokens such as mathematical functions
- * ("sin", "cos", "tan"), the "mod" operator, or user-defined variables.
+ * @param variables The variables that may appear in an expression.
+ * @param error Receives the reason if a variable is named like a function or
+ * "mod".
+ * @return True if the names are valid, False otherwise.
+ */
+bool MathCalc::ValidateVariables(const VariableTable& variables,
+                                 Error& error) {
+  for (const std::string& name : variables.GetNames()) {
+    if (KeywordTable::Find(name)) {
+      return Fail(ErrorCode::kInvalidVariable, "Invalid variable name: " + name,
+                  0, error);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Records the reason why an expression was rejected.
  *
- * @param token The string to be validated.
- * @return True if the string represents a valid alphanumeric token, False
- * otherwise.
+ * @param code The kind of the error.
+ * @param message The description of the error.
+ * @param position The offset of the offending character in the expression.
+ * @param error The error to be filled in.
+ * @return False, so that callers can return the result directly.
  */
-bool MathCalc::ValidateAlpha(const std::string& token) {
-  static const std::vector<std::string> valid_tokens = {
-      "sin",  "cos", "tan", "asin", "acos", "atan",
-      "sqrt", "ln",  "log", "x",    "mod"};
+bool MathCalc::Fail(ErrorCode code, std::string message, std::size_t position,
+                    Error& error) {
+  error.code = code;
+  error.message = std::move(message);
+  error.position = position;
+  return false;
+}
 
-  return std::any_of(valid_tokens.cbegin(), valid_tokens.cend(),
-                     [&token](const std::string& tok) { return tok == token; });
+/**
+ * @brief Computes the offset of a token in the expression it refers to.
+ *
+ * Tokens inserted by the parser, such as an omitted multiplication, do not
+ * refer to the expression and are placed at its end.
+ */
+std::size_t MathCalc::Position(std::string_view expression,
+                               const Token& token) {
+  std::less<const char*> before;
+  const char* begin = expression.data();
+  const char* end = begin + expression.length();
+  const char* text = token.GetToken().data();
+  if (before(text, begin) || !before(text, end)) {
+    return expression.length();
+  }
+  return static_cast<std::size_t>(text - begin);
 }
 
 /**
  * @brief Validates the correct placement of spaces in an expression.
  *
  * This method checks if the spaces in the input expression are correctly
- * placed. Specifically, it ensures that spaces are not present between digits
- * or between a digit and a variable (e.g., "x 5" or "2 3"), which would result
- * in an invalid expression.
+ * placed. Specifically, it ensures that spaces do not separate two operands,
+ * that is numbers or variables (e.g., "x 5", "2 3" or "x y"), which would
+ * result in an invalid expression.
  *
  * @param expression The expression to be validated.
  * @param pos The current position in the expression where validation is being
  * performed.
+ * @param tokens The tokens preceding the spaces.
+ * @param variables The variables that may appear in the expression.
  * @return True if spaces are correctly placed, False if an invalid space
  * configuration is found.
  */
-bool MathCalc::ValidateSpaces(const std::string& expression, std::size_t pos) {
-  std::size_t start = pos;
-  while (pos < expression.length() && std::isspace(expression[pos])) {
+bool MathCalc::ValidateSpaces(std::string_view expression, std::size_t pos,
+                              const std::vector<Token>& tokens,
+                              const VariableTable& variables) {
+  while (pos < expression.length() &&
+         std::isspace(static_cast<unsigned char>(expression[pos]))) {
     ++pos;
   }
 
-  if (pos < expression.length() && start > 0 &&
-      (std::isdigit(expression[start - 1]) || expression[start - 1] == 'x') &&
-      (std::isdigit(expression[pos]) || expression[pos] == 'x')) {
+  if (pos == expression.length() || tokens.empty() ||
+      (!tokens.back().IsNumber() && !tokens.back().IsVariable())) {
+    return true;
+  }
+  if (std::isdigit(static_cast<unsigned char>(expression[pos]))) {
     return false;
   }
+  if (std::isalpha(static_cast<unsigned char>(expression[pos]))) {
+    std::string_view word =
+        expression.substr(pos, FindAlphaEnd(expression, pos) - pos);
+    return variables.Find(word.substr(0, MatchAlpha(word, variables))) ==
+           VariableTable::kNotFound;
+  }
 
   return true;
 }
 
 /**
- * @brief Processes and evaluates a mathematical operator.
+ * @brief Maps an operator token to the corresponding opcode.
  *
- * This method takes a mathematical operator token and the stack of operands.
- * It performs the corresponding unary or binary operation on the operands
- * based on the operator token and pushes the result back onto the operand
- * stack.
+ * This method is used while compiling an expression and resolves the textual
+ * representation of a unary or binary operator into an opcode once, so that
+ * no string comparisons are needed during evaluation. Unary plus is mapped to
+ * OpCode::kAdd and is dropped by the caller. The token is produced by
+ * ParseExpression, so it is always a valid operator.
  *
- * @param token The operator token to be processed.
- * @param operands A stack containing the operands for the mathematical
- * operation.
- *
- * @throws std::logic_error if there are not enough operands for the
- * operator, division by zero is encountered, or if an unsupported operator is
- * encountered.
+ * @param token The operator token to be compiled.
+ * @return The opcode of the operator.
  */
-void MathCalc::ProcessOperator(const Token& token,
-                               std::stack<double>& operands) {
-  if (operands.size() < 1 && token.IsUnaryOperator()) {
-    throw std::logic_error("Not enough operands for unary operator");
-  }
-  if (operands.size() < 2 && token.IsBinaryOperator()) {
-    throw std::logic_error("Not enough operands for binary operator");
-  }
-  double result = 0.0;
+OpCode MathCalc::CompileOperator(const Token& token) {
+  std::string_view op = token.GetToken();
 
   if (token.IsUnaryOperator()) {
-    double operand = operands.top();
-    operands.pop();
-
-    if (token.GetToken() == "+") {
-      result = operand;
-    } else if (token.GetToken() == "-") {
-      result = -operand;
-    } else {
-      throw std::logic_error("Unsupported unary operator: " + token.GetToken());
-    }
-  } else {
-    double operand2 = operands.top();
-    operands.pop();
-    double operand1 = operands.top();
-    operands.pop();
-
-    if (token.GetToken() == "+") {
-      result = operand1 + operand2;
-    } else if (token.GetToken() == "-") {
-      result = operand1 - operand2;
-    } else if (token.GetToken() == "*") {
-      result = operand1 * operand2;
-    } else if (token.GetToken() == "/") {
-      result = operand1 / operand2;
-    } else if (token.GetToken() == "^") {
-      result = std::pow(operand1, operand2);
-    } else if (token.GetToken() == "mod") {
-      result = std::fmod(operand1, operand2);
-    } else {
-      throw std::logic_error("Unsupported binary operator: " +
-                             token.GetToken());
-    }
+    return op == "-" ? OpCode::kNegate : OpCode::kAdd;
   }
 
-  operands.push(result);
+  switch (op.front()) {
+    case '+':
+      return OpCode::kAdd;
+    case '-':
+      return OpCode::kSub;
+    case '*':
+      return OpCode::kMul;
+    case '/':
+      return OpCode::kDiv;
+    case '^':
+      return OpCode::kPow;
+    default:
+      return OpCode::kMod;
+  }
 }
 
 /**
- * @brief Processes and evaluates a mathematical function.
- *
- * This method takes a mathematical function token and the stack of operands.
- * It performs the corresponding mathematical function on the top operand
- * and pushes the result back onto the operand stack.
+ * @brief Maps a function token to the corresponding opcode.
  *
- * @param token The function token to be processed.
- * @param operands A stack containing the operands for the function.
+ * This method is used while compiling an expression and resolves the name of
+ * a mathematical function into an opcode once with the KeywordTable, so that
+ * no string comparisons are needed during evaluation. The token is produced by
+ * ParseExpression, so it is always the name of a function.
  *
- * @throws std::logic_error if there are not enough operands for the
- * function, if an invalid input is provided to a function (e.g., sqrt of a
- * negative number), or if an unsupported function is encountered.
+ * @param token The function token to be compiled.
+ * @return The opcode of the function.
  */
-void MathCalc::ProcessFunction(const Token& token,
-                               std::stack<double>& operands) {
-  if (operands.empty()) {
-    throw std::logic_error("Not enough operands for function: " +
-                           token.GetToken());
-  }
-
-  double operand = operands.top();
-  operands.pop();
-  double result = 0.0;
-
-  if (token.GetToken() == "sin") {
-    result = std::sin(operand);
-  } else if (token.GetToken() == "cos") {
-    result = std::cos(operand);
-  } else if (token.GetToken() == "tan") {
-    result = std::tan(operand);
-  } else if (token.GetToken() == "asin") {
-    result = std::asin(operand);
-  } else if (token.GetToken() == "acos") {
-    result = std::acos(operand);
-  } else if (token.GetToken() == "atan") {
-    result = std::atan(operand);
-  } else if (token.GetToken() == "sqrt") {
-    result = std::sqrt(operand);
-  } else if (token.GetToken() == "ln") {
-    result = std::log(operand);
-  } else if (token.GetToken() == "log") {
-    result = std::log10(operand);
-  } else {
-    throw std::logic_error("Unsupported function: " + token.GetToken());
-  }
-
-  operands.push(result);
+OpCode MathCalc::CompileFunction(const Token& token) {
+  return KeywordTable::Find(token.GetToken())->op;
 }
 
 /**
@@ -551,23 +1209,23 @@ void MathCalc::ProcessFunction(const Token& token,
  *
  * @param operators A stack containing operators.
  * @param rpn A vector representing the Reverse Polish Notation output.
- *
- * @throws std::logic_error if there is an invalid bracket sequence.
+ * @return False if there is no matching opening bracket, True otherwise.
  */
-void MathCalc::ProcessBrackets(std::stack<Token>& operators,
+bool MathCalc::ProcessBrackets(std::stack<Token>& operators,
                                std::vector<Token>& rpn) {
   while (!operators.empty() && !operators.top().IsOpenBracket()) {
     rpn.push_back(operators.top());
     operators.pop();
   }
   if (operators.empty() || !operators.top().IsOpenBracket()) {
-    throw std::logic_error("Invalid bracket sequence");
+    return false;
   }
   operators.pop();
   if (!operators.empty() && operators.top().IsFunction()) {
     rpn.push_back(operators.top());
     operators.pop();
   }
+  return true;
 }
 
 /**
@@ -608,17 +1266,19 @@ void MathCalc::ProcessOperators(const Token& token,
  *
  * @param operators A stack containing operators.
  * @param rpn A vector representing the Reverse Polish Notation output.
- * @throws std::logic_error if an invalid bracket sequence is encountered.
+ * @return False if an unmatched bracket is encountered, which is left on top
+ * of the stack, True otherwise.
  */
-void MathCalc::ProcessRemainingOperators(std::stack<Token>& operators,
+bool MathCalc::ProcessRemainingOperators(std::stack<Token>& operators,
                                          std::vector<Token>& rpn) {
   while (!operators.empty()) {
     if (operators.top().IsOpenBracket() || operators.top().IsCloseBracket()) {
-      throw std::logic_error("Invalid bracket sequence");
+      return false;
     }
     rpn.push_back(operators.top());
     operators.pop();
   }
+  return true;
 }
 
 }  // namespace s21
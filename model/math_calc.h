@@ -3,13 +3,24 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cmath>
+#include <cstdio>
+#include <functional>
 #include <numeric>
 #include <stack>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
+#include "error.h"
+#include "keyword_table.h"
+#include "optimizer.h"
+#include "program.h"
+#include "thread_pool.h"
 #include "token.h"
+#include "variable_table.h"
+#include "vector_evaluator.h"
 
 namespace s21 {
 
@@ -19,44 +30,135 @@ namespace s21 {
  *
  * MathCalc provides methods for parsing, converting, and evaluating
  * mathematical expressions. It supports basic arithmetic operations, functions,
- * variables, and can evaluate expressions with or without variables. The class
- * utilizes Reverse Polish Notation (RPN) and the Shunting-Yard algorithm for
- * expression processing.
+ * variables, and can evaluate expressions with or without variables. The
+ * variables are declared in a VariableTable, which defaults to the single
+ * variable 'x'. The class utilizes Reverse Polish Notation (RPN) and the
+ * Shunting-Yard algorithm for expression processing. The resulting RPN is
+ * compiled into a Program with decoded literals and opcodes, which is then
+ * executed on a flat operand buffer.
+ *
+ * Invalid expressions are reported with a std::logic_error, or, by the
+ * overloads taking an Error, with an error code, message and position
+ * without throwing.
+ *
+ * Evaluation never modifies a Program or a MathCalc object and keeps its
+ * operand buffers per thread, so both can be evaluated by several threads at
+ * once. CompiledExpression wraps a Program for sharing between threads.
+ *
+ * Compiled expressions are evaluated in double precision by default. Evaluate
+ * runs the same interpreter in float, double or long double, and the range
+ * overloads taking a Precision trade accuracy for speed or the other way
+ * round.
  */
 class MathCalc {
  public:
+  /**
+   * @brief The scalar type a range of values is evaluated in.
+   *
+   * kSingle uses the float vector path, which processes twice as many values
+   * per instruction, kDouble is the default and kExtended evaluates every
+   * value in long double with the scalar interpreter. The results are always
+   * returned as doubles.
+   */
+  enum class Precision : unsigned char { kSingle, kDouble, kExtended };
+
   explicit MathCalc(const std::string& expression);
 
   static double Calculate(const std::string& expression, double x = 0.0);
   static std::pair<std::vector<double>, std::vector<double>> Calculate(
       const std::string& expression, double x_min, double x_max,
-      std::size_t size);
-  double Calculate(double x);
+      std::size_t size, std::size_t threads = 1);
+  static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const std::string& expression, double x_min, double x_max,
+      std::size_t size, std::vector<PointStatus>& status, Error& error,
+      std::size_t threads = 1);
+  double Calculate(double x) const;
+
+  static std::string Canonicalize(
+      const std::string& expression,
+      const VariableTable& variables = VariableTable());
+  static std::string Canonicalize(
+      const std::string& expression, Error& error,
+      const VariableTable& variables = VariableTable());
+  static Program Compile(const std::string& expression,
+                         const VariableTable& variables = VariableTable());
+  static Program Compile(const std::string& expression, Error& error,
+                         const VariableTable& variables = VariableTable());
+  static double Calculate(const ProgramView& program, double x);
+  static double Calculate(const ProgramView& program,
+                          const std::vector<double>& values);
+  static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const ProgramView& program, double x_min, double x_max, std::size_t size,
+      std::size_t threads = 1);
+  static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const ProgramView& program, double x_min, double x_max, std::size_t size,
+      std::vector<PointStatus>& status, std::size_t threads = 1);
+  static std::pair<std::vector<double>, std::vector<double>> Calculate(
+      const ProgramView& program, double x_min, double x_max, std::size_t size,
+      Precision precision, std::size_t threads = 1);
+  static void Calculate(const ProgramView& program,
+                        const double* const* columns, double* y,
+                        std::size_t size, std::size_t threads = 1);
+  template <class T>
+  static T Evaluate(const ProgramView& program, T x);
 
  private:
-  static std::vector<Token> ParseExpression(const std::string& expression);
-  static std::vector<Token> ConvertToRPN(const std::vector<Token>& tokens);
-  static double EvaluateRPN(const std::vector<Token>& rpn, double x);
-  static std::size_t ParseNumber(const std::string& expression, std::size_t pos,
-                                 std::vector<Token>& tokens);
-  static std::size_t ParseAlpha(const std::string& expression, std::size_t pos,
-                                std::vector<Token>& tokens);
-  static std::size_t ParseOperator(const std::string& expression,
-                                   std::size_t pos, std::vector<Token>& tokens);
+  friend class IncrementalParser;
+
+  static constexpr std::size_t kChunkSize = 4096;
+
+  static std::pair<std::vector<double>, std::vector<double>> Tabulate(
+      const ProgramView& program, double x_min, double x_max, std::size_t size,
+      PointStatus* status, Precision precision, std::size_t threads);
+  static void TabulateChunk(const ProgramView& program, const double* x,
+                            double* y, std::size_t size, Precision precision);
+  static bool ParseExpression(std::string_view expression,
+                              const VariableTable& variables,
+                              std::vector<Token>& tokens, Error& error);
+  static std::size_t ParseToken(std::string_view expression, std::size_t pos,
+                                std::size_t& alpha_end,
+                                const VariableTable& variables,
+                                std::vector<Token>& tokens, Error& error);
+  static bool ConvertToRPN(std::string_view expression,
+                           const std::vector<Token>& tokens,
+                           std::vector<Token>& rpn, Error& error);
+  static bool Compile(std::string_view expression,
+                      const std::vector<Token>& rpn,
+                      const VariableTable& variables, Program& program,
+                      Error& error);
+  template <class T>
+  static T Execute(const ProgramView& program, const T* values, T* stack);
+  static std::size_t ParseNumber(std::string_view expression, std::size_t pos,
+                                 std::vector<Token>& tokens, Error& error);
+  static std::size_t ParseAlpha(std::string_view expression, std::size_t pos,
+                                std::size_t end, std::vector<Token>& tokens,
+                                const VariableTable& variables, Error& error);
+  static std::size_t MatchAlpha(std::string_view word,
+                                const VariableTable& variables);
+  static std::size_t FindAlphaEnd(std::string_view expression,
+                                  std::size_t pos);
+  static std::size_t ParseOperator(std::string_view expression,
+                                   std::size_t pos, std::vector<Token>& tokens,
+                                   Error& error);
   static void InsertOmittedMul(std::vector<Token>& tokens, bool flg = false);
-  static bool ValidateNumber(const std::string& token);
-  static bool ValidateAlpha(const std::string& token);
-  static bool ValidateSpaces(const std::string& expression, std::size_t pos);
-  static void ProcessOperator(const Token& token, std::stack<double>& operands);
-  static void ProcessFunction(const Token& token, std::stack<double>& operands);
-  static void ProcessBrackets(std::stack<Token>& operators,
+  static bool ValidateNumber(std::string_view token);
+  static bool ValidateVariables(const VariableTable& variables, Error& error);
+  static bool ValidateSpaces(std::string_view expression, std::size_t pos,
+                             const std::vector<Token>& tokens,
+                             const VariableTable& variables);
+  static bool Fail(ErrorCode code, std::string message, std::size_t position,
+                   Error& error);
+  static std::size_t Position(std::string_view expression, const Token& token);
+  static OpCode CompileOperator(const Token& token);
+  static OpCode CompileFunction(const Token& token);
+  static bool ProcessBrackets(std::stack<Token>& operators,
                               std::vector<Token>& rpn);
   static void ProcessOperators(const Token& token, std::stack<Token>& operators,
                                std::vector<Token>& rpn);
-  static void ProcessRemainingOperators(std::stack<Token>& operators,
+  static bool ProcessRemainingOperators(std::stack<Token>& operators,
                                         std::vector<Token>& rpn);
 
-  std::vector<Token> rpn_;
+  Program program_;
 };
 }  // namespace s21
 
@@ -0,0 +1,647 @@
+#include "optimizer.h"
+
+namespace s21 {
+
+/**
+ * @brief Simplifies a compiled expression.
+ *
+ * This method performs a single pass over the instructions of a valid Program
+ * while tracking which code range produces each operand on the stack. An
+ * operation whose operands are all constants is evaluated immediately and
+ * replaced with a literal. Operations with a neutral operand (x*1, 1*x, x/1,
+ * x-0, x+(-0), (-0)+x, x^1) are removed, x^0 becomes 1, multiplication or
+ * division by -1 becomes a negation, a double negation cancels out, and
+ * integer powers up to kMaxPowInt are replaced with OpCode::kPowInt, which is
+ * evaluated with multiplications instead of std::pow. All rewrites preserve
+ * the result for every value of the variable. x+0 is kept, as it turns -0
+ * into +0, which changes the sign of an infinity further on. The
+ * simplified code is then passed to SpecializePolynomials, which changes the
+ * order of the roundings in polynomials, and to ShareSubexpressions.
+ *
+ * @param program The Program to be optimized, without temporaries.
+ * @return The optimized Program with the recomputed stack depth.
+ */
+Program Optimizer::Optimize(const Program& program) {
+  Program optimized;
+  std::vector<Operand> operands;
+
+  for (const Instruction& instruction : program.code) {
+    if (instruction.op == OpCode::kNumber) {
+      operands.push_back({optimized.code.size(), true, instruction.value});
+      optimized.code.push_back(instruction);
+    } else if (instruction.op == OpCode::kVariable) {
+      operands.push_back({optimized.code.size(), false, 0.0});
+      optimized.code.push_back(instruction);
+    } else if (IsBinary(instruction.op)) {
+      OptimizeBinary(instruction, optimized.code, operands);
+    } else {
+      OptimizeUnary(instruction, optimized.code, operands);
+    }
+  }
+
+  SpecializePolynomials(optimized.code);
+  ShareSubexpressions(optimized);
+  optimized.variables = program.variables;
+  return optimized;
+}
+
+/**
+ * @brief Optimizes an instruction that takes a single operand.
+ *
+ * A constant operand is folded into a literal, and a negation of a negation
+ * is removed. Otherwise the instruction is appended to the code unchanged.
+ *
+ * @param instruction The unary instruction being processed.
+ * @param code The optimized code built so far.
+ * @param operands The operands currently on the stack.
+ */
+void Optimizer::OptimizeUnary(const Instruction& instruction,
+                              std::vector<Instruction>& code,
+                              std::vector<Operand>& operands) {
+  Operand operand = operands.back();
+  operands.pop_back();
+
+  if (operand.constant) {
+    EmitConstant(Apply(instruction, operand.value), operand.begin, code,
+                 operands);
+  } else if (instruction.op == OpCode::kNegate &&
+             code.back().op == OpCode::kNegate) {
+    code.pop_back();
+    operands.push_back({operand.begin, false, 0.0});
+  } else {
+    code.push_back(instruction);
+    operands.push_back({operand.begin, false, 0.0});
+  }
+}
+
+/**
+ * @brief Optimizes an instruction that takes two operands.
+ *
+ * Two constant operands are folded into a literal. If only one operand is
+ * constant, the algebraic identities described in Optimize are applied. The
+ * code of the left operand always precedes the code of the right one, so a
+ * neutral right operand is removed by truncating the code, and a neutral left
+ * operand, which is a single literal, is erased from its start.
+ *
+ * @param instruction The binary instruction being processed.
+ * @param code The optimized code built so far.
+ * @param operands The operands currently on the stack.
+ */
+void Optimizer::OptimizeBinary(const Instruction& instruction,
+                               std::vector<Instruction>& code,
+                               std::vector<Operand>& operands) {
+  Operand rhs = operands.back();
+  operands.pop_back();
+  Operand lhs = operands.back();
+  operands.pop_back();
+
+  if (lhs.constant && rhs.constant) {
+    EmitConstant(Apply(instruction, lhs.value, rhs.value), lhs.begin, code,
+                 operands);
+    return;
+  }
+
+  auto drop_rhs = [&]() {
+    code.resize(rhs.begin);
+    operands.push_back({lhs.begin, false, 0.0});
+  };
+  auto drop_lhs = [&]() {
+    code.erase(code.begin() + lhs.begin);
+    operands.push_back({lhs.begin, false, 0.0});
+  };
+  auto negate = [&]() {
+    OptimizeUnary({OpCode::kNegate, 0.0}, code, operands);
+  };
+
+  OpCode op = instruction.op;
+  if (op == OpCode::kAdd && rhs.constant && rhs.value == 0.0 &&
+      std::signbit(rhs.value)) {
+    drop_rhs();
+  } else if (op == OpCode::kAdd && lhs.constant && lhs.value == 0.0 &&
+             std::signbit(lhs.value)) {
+    drop_lhs();
+  } else if (op == OpCode::kSub && rhs.constant && rhs.value == 0.0 &&
+             !std::signbit(rhs.value)) {
+    drop_rhs();
+  } else if ((op == OpCode::kMul || op == OpCode::kDiv) && rhs.constant &&
+             std::fabs(rhs.value) == 1.0) {
+    drop_rhs();
+    if (rhs.value < 0.0) {
+      negate();
+    }
+  } else if (op == OpCode::kMul && lhs.constant &&
+             std::fabs(lhs.value) == 1.0) {
+    drop_lhs();
+    if (lhs.value < 0.0) {
+      negate();
+    }
+  } else if (op == OpCode::kPow && rhs.constant && rhs.value == 1.0) {
+    drop_rhs();
+  } else if (op == OpCode::kPow && rhs.constant && rhs.value == 0.0) {
+    EmitConstant(1.0, lhs.begin, code, operands);
+  } else if (op == OpCode::kPow && rhs.constant && IsInteger(rhs.value) &&
+             std::fabs(rhs.value) <= kMaxPowInt) {
+    drop_rhs();
+    code.push_back({OpCode::kPowInt, rhs.value});
+  } else {
+    code.push_back(instruction);
+    operands.push_back({lhs.begin, false, 0.0});
+  }
+}
+
+/**
+ * @brief Replaces the code of an operand with a single literal.
+ *
+ * @param value The value of the literal.
+ * @param begin The start of the code range being replaced.
+ * @param code The optimized code built so far.
+ * @param operands The operands currently on the stack.
+ */
+void Optimizer::EmitConstant(double value, std::size_t begin,
+                             std::vector<Instruction>& code,
+                             std::vector<Operand>& operands) {
+  code.resize(begin);
+  code.push_back({OpCode::kNumber, value});
+  operands.push_back({begin, true, value});
+}
+
+/**
+ * @brief Checks if a value is a finite integer.
+ *
+ * @param value The value to be checked.
+ * @return True if the value has no fractional part, False otherwise.
+ */
+bool Optimizer::IsInteger(double value) {
+  return std::isfinite(value) && std::trunc(value) == value;
+}
+
+/**
+ * @brief Evaluates a single instruction on constant operands.
+ *
+ * The evaluation uses the same functions as MathCalc, so folding a constant
+ * subexpression produces exactly the value it would have at run time.
+ *
+ * @param instruction The instruction to be evaluated.
+ * @param lhs The first (or the only) operand.
+ * @param rhs The second operand of a binary operator.
+ * @return The result of the instruction.
+ */
+double Optimizer::Apply(const Instruction& instruction, double lhs,
+                        double rhs) {
+  switch (instruction.op) {
+    case OpCode::kNegate:
+      return -lhs;
+    case OpCode::kAdd:
+      return lhs + rhs;
+    case OpCode::kSub:
+      return lhs - rhs;
+    case OpCode::kMul:
+      return lhs * rhs;
+    case OpCode::kDiv:
+      return lhs / rhs;
+    case OpCode::kPow:
+      return std::pow(lhs, rhs);
+    case OpCode::kMod:
+      return std::fmod(lhs, rhs);
+    case OpCode::kPowInt:
+      return PowInt(lhs, static_cast<long>(instruction.value));
+    case OpCode::kSin:
+      return std::sin(lhs);
+    case OpCode::kCos:
+      return std::cos(lhs);
+    case OpCode::kTan:
+      return std::tan(lhs);
+    case OpCode::kAsin:
+      return std::asin(lhs);
+    case OpCode::kAcos:
+      return std::acos(lhs);
+    case OpCode::kAtan:
+      return std::atan(lhs);
+    case OpCode::kSqrt:
+      return std::sqrt(lhs);
+    case OpCode::kLn:
+      return std::log(lhs);
+    case OpCode::kLog:
+      return std::log10(lhs);
+    default:
+      return instruction.value;
+  }
+}
+
+/**
+ * @brief Creates a polynomial of degree 0.
+ */
+Optimizer::Polynomial Optimizer::Polynomial::Constant(double value) {
+  Polynomial polynomial;
+  polynomial.coefficients[0] = value;
+  return polynomial;
+}
+
+/**
+ * @brief Creates the polynomial of degree 1 that is the variable itself.
+ */
+Optimizer::Polynomial Optimizer::Polynomial::Variable(std::size_t slot) {
+  Polynomial polynomial;
+  polynomial.slot = slot;
+  polynomial.degree = 1;
+  polynomial.coefficients[1] = 1.0;
+  return polynomial;
+}
+
+/**
+ * @brief Counts the nonzero coefficients.
+ */
+std::size_t Optimizer::Polynomial::CountTerms() const {
+  return static_cast<std::size_t>(
+      std::count_if(coefficients, coefficients + degree + 1,
+                    [](double coefficient) { return coefficient != 0.0; }));
+}
+
+/**
+ * @brief Checks if the polynomial is a power of the variable or its
+ * negation, such as x or -x^3.
+ */
+bool Optimizer::Polynomial::IsPower() const {
+  return slot != kNoSlot && CountTerms() == 1 &&
+         std::fabs(coefficients[degree]) == 1.0;
+}
+
+/**
+ * @brief Checks if the polynomial is evaluated with OpCode::kPolynomial.
+ *
+ * Horner's scheme pays off for polynomials of at least the second degree
+ * with at least two terms. A single term such as 3*x^7 is cheaper to compute
+ * as written.
+ */
+bool Optimizer::Polynomial::IsSpecialized() const {
+  return degree >= 2 && CountTerms() >= 2;
+}
+
+/**
+ * @brief Evaluates the polynomial with the same operations as Horner.
+ *
+ * @param x The value of the variable.
+ * @return The value of the polynomial at x.
+ */
+double Optimizer::Polynomial::Evaluate(double x) const {
+  double result = coefficients[degree];
+  for (std::size_t k = degree; k-- > 0;) {
+    result = result * x + coefficients[k];
+  }
+  return result;
+}
+
+/**
+ * @brief Computes the coefficients of an instruction applied to polynomials.
+ *
+ * Only expressions that are already written as a sum of terms in descending
+ * powers or in Horner's form are collected, so that no coefficient is
+ * computed from others and the partial sums of Horner's scheme are those of
+ * the original expression up to rounding. The result is a polynomial for a
+ * negation, a sum or difference of a polynomial and a single term below its
+ * lowest power, a product by a power of the variable or by 1 or -1, a
+ * quotient of a power of the variable by a constant or of any polynomial by 1
+ * or -1, and a positive integer power of a power of the variable, as long as
+ * its degree does not exceed kMaxDegree and its coefficients are finite. A
+ * power of 1 leaves its base as it is, and powers of constants are left to
+ * the constant folder. Both operands must be in the same variable or
+ * constant.
+ *
+ * @param instruction The instruction to be applied.
+ * @param lhs The first (or the only) operand.
+ * @param rhs The second operand of a binary operator.
+ * @param result Receives the polynomial if the result is one.
+ * @return True if the result is a polynomial, False otherwise.
+ */
+bool Optimizer::Apply(const Instruction& instruction, const Polynomial& lhs,
+                      const Polynomial& rhs, Polynomial& result) {
+  OpCode op = instruction.op;
+  Polynomial polynomial;
+  polynomial.slot = lhs.slot;
+  if (IsBinary(op) && rhs.slot != Polynomial::kNoSlot) {
+    if (lhs.slot != Polynomial::kNoSlot && lhs.slot != rhs.slot) {
+      return false;
+    }
+    polynomial.slot = rhs.slot;
+  }
+  bool constant_rhs = rhs.slot == Polynomial::kNoSlot;
+  bool unit_rhs = constant_rhs && std::fabs(rhs.coefficients[0]) == 1.0;
+
+  if (op == OpCode::kNegate) {
+    polynomial.degree = lhs.degree;
+    for (std::size_t k = 0; k <= lhs.degree; ++k) {
+      polynomial.coefficients[k] = -lhs.coefficients[k];
+    }
+  } else if (op == OpCode::kAdd || op == OpCode::kSub) {
+    if (rhs.CountTerms() > 1) {
+      return false;
+    }
+    polynomial.degree = std::max(lhs.degree, rhs.degree);
+    bool below = false;
+    for (std::size_t k = polynomial.degree + 1; k-- > 0;) {
+      below = below || rhs.coefficients[k] != 0.0;
+      if (below && lhs.coefficients[k] != 0.0) {
+        return false;
+      }
+      polynomial.coefficients[k] =
+          Apply(instruction, lhs.coefficients[k], rhs.coefficients[k]);
+    }
+  } else if (op == OpCode::kMul) {
+    if (!Multiply(lhs, rhs, polynomial)) {
+      return false;
+    }
+  } else if (op == OpCode::kDiv && constant_rhs &&
+             rhs.coefficients[0] != 0.0 && (lhs.IsPower() || unit_rhs)) {
+    polynomial.degree = lhs.degree;
+    for (std::size_t k = 0; k <= lhs.degree; ++k) {
+      polynomial.coefficients[k] = lhs.coefficients[k] / rhs.coefficients[0];
+    }
+  } else if ((op == OpCode::kPowInt && instruction.value >= 1.0) ||
+             (op == OpCode::kPow && constant_rhs &&
+              IsInteger(rhs.coefficients[0]) && rhs.coefficients[0] >= 1.0)) {
+    double exponent = op == OpCode::kPowInt ? instruction.value
+                                            : rhs.coefficients[0];
+    // The degree of the base is at least 1 past this check, so the exponent
+    // and the number of multiplications below are at most kMaxDegree.
+    if (exponent > 1.0 && (!lhs.IsPower() ||
+                           exponent * static_cast<double>(lhs.degree) >
+                               static_cast<double>(kMaxDegree))) {
+      return false;
+    }
+    polynomial = lhs;
+    for (double power = 1.0; power < exponent; ++power) {
+      Polynomial factor = polynomial;
+      Multiply(factor, lhs, polynomial);
+    }
+  } else {
+    return false;
+  }
+
+  auto finite = [](double coefficient) { return std::isfinite(coefficient); };
+  if (!std::all_of(polynomial.coefficients,
+                   polynomial.coefficients + polynomial.degree + 1, finite)) {
+    return false;
+  }
+  result = polynomial;
+  return true;
+}
+
+/**
+ * @brief Multiplies two polynomials if one of them is a power of the
+ * variable or the constant 1 or -1.
+ *
+ * The coefficients of the product are then those of the other factor,
+ * shifted or negated, and a power is not multiplied by the constant 0, which
+ * would hide an infinite or NaN value of the power.
+ *
+ * @param lhs The first factor.
+ * @param rhs The second factor.
+ * @param result Receives the product; its slot must already be set.
+ * @return True if the product is a polynomial of at most kMaxDegree, False
+ * otherwise.
+ */
+bool Optimizer::Multiply(const Polynomial& lhs, const Polynomial& rhs,
+                         Polynomial& result) {
+  auto unit = [](const Polynomial& polynomial) {
+    return polynomial.slot == Polynomial::kNoSlot &&
+           std::fabs(polynomial.coefficients[0]) == 1.0;
+  };
+  auto zero = [](const Polynomial& polynomial) {
+    return polynomial.slot == Polynomial::kNoSlot &&
+           polynomial.coefficients[0] == 0.0;
+  };
+  if (!((lhs.IsPower() && !zero(rhs)) || (rhs.IsPower() && !zero(lhs)) ||
+        unit(lhs) || unit(rhs)) ||
+      lhs.degree + rhs.degree > kMaxDegree) {
+    return false;
+  }
+  result.degree = lhs.degree + rhs.degree;
+  std::fill(std::begin(result.coefficients), std::end(result.coefficients),
+            0.0);
+  for (std::size_t i = 0; i <= lhs.degree; ++i) {
+    for (std::size_t j = 0; j <= rhs.degree; ++j) {
+      result.coefficients[i + j] += lhs.coefficients[i] * rhs.coefficients[j];
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replaces polynomial subexpressions with OpCode::kPolynomial.
+ *
+ * The first pass collects the coefficients of every subexpression that is a
+ * polynomial, as defined by Apply. A polynomial is absorbed by its parent if
+ * the parent is a polynomial too, so only the largest ones are replaced. A
+ * rational function such as (x^2 + 1) / (x^2 - 1) is therefore evaluated as
+ * a quotient of two polynomials. The second pass emits the variable followed
+ * by OpCode::kPolynomial and the coefficients in place of the code of every
+ * polynomial that IsSpecialized. As Apply only collects sums of terms in
+ * descending powers and expressions in Horner's form, the results differ
+ * from those of the original code only by rounding, and where the terms
+ * overflow, by an infinity in place of their NaN difference.
+ *
+ * @param code The simplified code without temporaries.
+ */
+void Optimizer::SpecializePolynomials(std::vector<Instruction>& code) {
+  std::vector<Polynomial> polynomials(code.size());
+  std::vector<char> valid(code.size()), absorbed(code.size());
+  std::vector<std::size_t> operands;
+  bool specialized = false;
+
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    const Instruction& instruction = code[i];
+    if (instruction.op == OpCode::kNumber) {
+      polynomials[i] = Polynomial::Constant(instruction.value);
+      valid[i] = true;
+    } else if (instruction.op == OpCode::kVariable) {
+      polynomials[i] =
+          Polynomial::Variable(static_cast<std::size_t>(instruction.value));
+      valid[i] = true;
+    } else {
+      std::size_t rhs = kNone;
+      if (IsBinary(instruction.op)) {
+        rhs = operands.back();
+        operands.pop_back();
+      }
+      std::size_t lhs = operands.back();
+      operands.pop_back();
+      valid[i] = valid[lhs] && (rhs == kNone || valid[rhs]) &&
+                 Apply(instruction, polynomials[lhs],
+                       polynomials[rhs == kNone ? lhs : rhs], polynomials[i]);
+      if (valid[i]) {
+        absorbed[lhs] = true;
+        if (rhs != kNone) {
+          absorbed[rhs] = true;
+        }
+      }
+    }
+    operands.push_back(i);
+  }
+
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    valid[i] = valid[i] && !absorbed[i] && polynomials[i].IsSpecialized();
+    specialized = specialized || valid[i];
+  }
+  if (!specialized) {
+    return;
+  }
+
+  std::vector<Instruction> specialized_code;
+  std::vector<std::size_t> begins;
+  for (std::size_t i = 0; i < code.size(); ++i) {
+    const Instruction& instruction = code[i];
+    std::size_t begin = specialized_code.size();
+    if (IsBinary(instruction.op)) {
+      begins.pop_back();
+    }
+    if (!IsLeaf(instruction.op)) {
+      begin = begins.back();
+      begins.pop_back();
+    }
+
+    if (valid[i]) {
+      const Polynomial& polynomial = polynomials[i];
+      specialized_code.resize(begin);
+      specialized_code.push_back(
+          {OpCode::kVariable, static_cast<double>(polynomial.slot)});
+      specialized_code.push_back(
+          {OpCode::kPolynomial, static_cast<double>(polynomial.degree)});
+      for (std::size_t k = polynomial.degree + 1; k-- > 0;) {
+        specialized_code.push_back(
+            {OpCode::kCoefficient, polynomial.coefficients[k]});
+      }
+    } else {
+      specialized_code.push_back(instruction);
+    }
+    begins.push_back(begin);
+  }
+  code = std::move(specialized_code);
+}
+
+/**
+ * @brief Computes every repeated subexpression of a Program only once.
+ *
+ * The first pass hash-conses the expression tree into a DAG: every
+ * instruction is mapped to the node of the value it produces, and identical
+ * subtrees, including the operands of + and * in swapped order, map to the
+ * same node. A node referenced more than once in the DAG is a shared
+ * subexpression. The second pass emits the code again; after the first
+ * occurrence of a shared subexpression an OpCode::kStore saves its value, and
+ * the code of every later occurrence is replaced with an OpCode::kLoad.
+ * Literals and variables are cheaper to push than to load and are never
+ * shared. A polynomial is a single node identified by its coefficients.
+ * Since the operands are evaluated in the original order, the results are
+ * identical to those of the original code.
+ *
+ * @param program The Program to be rewritten; its stack depth is recomputed
+ * and includes the temporaries.
+ */
+void Optimizer::ShareSubexpressions(Program& program) {
+  std::unordered_map<Node, std::size_t, NodeHash> nodes;
+  std::unordered_map<std::string, std::uint64_t> polynomials;
+  std::vector<std::size_t> ids(program.code.size());
+  std::vector<std::size_t> uses;
+  std::vector<std::size_t> operands;
+
+  for (std::size_t i = 0; i < program.code.size(); ++i) {
+    const Instruction& instruction = program.code[i];
+    Node node = {instruction.op, 0, kNone, kNone};
+    std::memcpy(&node.bits, &instruction.value, sizeof(node.bits));
+    if (instruction.op == OpCode::kPolynomial) {
+      std::string key;
+      for (std::size_t k = 0; k < Length(instruction); ++k) {
+        key.append(reinterpret_cast<const char*>(&program.code[i + k].value),
+                   sizeof(double));
+      }
+      node.bits = polynomials.emplace(key, polynomials.size()).first->second;
+    }
+    if (IsBinary(instruction.op)) {
+      node.rhs = operands.back();
+      operands.pop_back();
+      node.lhs = operands.back();
+      operands.pop_back();
+      if ((node.op == OpCode::kAdd || node.op == OpCode::kMul) &&
+          node.rhs < node.lhs) {
+        std::swap(node.lhs, node.rhs);
+      }
+    } else if (!IsLeaf(instruction.op)) {
+      node.lhs = operands.back();
+      operands.pop_back();
+    }
+
+    auto [it, inserted] = nodes.emplace(node, uses.size());
+    if (inserted) {
+      uses.push_back(0);
+      for (std::size_t operand : {node.lhs, node.rhs}) {
+        if (operand != kNone) {
+          ++uses[operand];
+        }
+      }
+    }
+    ids[i] = it->second;
+    operands.push_back(it->second);
+    i += Length(instruction) - 1;
+  }
+
+  std::vector<Instruction> code;
+  std::vector<std::size_t> begins;
+  std::vector<std::size_t> temporaries(uses.size(), kNone);
+  std::size_t count = 0;
+
+  for (std::size_t i = 0; i < program.code.size(); ++i) {
+    const Instruction& instruction = program.code[i];
+    std::size_t begin = code.size();
+    if (IsBinary(instruction.op)) {
+      begins.pop_back();
+    }
+    if (!IsLeaf(instruction.op)) {
+      begin = begins.back();
+      begins.pop_back();
+    }
+
+    std::size_t& temporary = temporaries[ids[i]];
+    if (temporary != kNone) {
+      code.resize(begin);
+      code.push_back({OpCode::kLoad, static_cast<double>(temporary)});
+    } else {
+      code.insert(code.end(), &instruction,
+                  &instruction + Length(instruction));
+      if (uses[ids[i]] > 1 && !IsLeaf(instruction.op)) {
+        temporary = count++;
+        code.push_back({OpCode::kStore, static_cast<double>(temporary)});
+      }
+    }
+    begins.push_back(begin);
+    i += Length(instruction) - 1;
+  }
+
+  std::size_t depth = StackDepth(code);
+  for (Instruction& instruction : code) {
+    if (instruction.op == OpCode::kStore || instruction.op == OpCode::kLoad) {
+      instruction.value += static_cast<double>(depth);
+    }
+  }
+  program.code = std::move(code);
+  program.depth = depth + count;
+}
+
+/**
+ * @brief Computes the maximum depth of the operand stack.
+ *
+ * @param code The instructions of a valid Program.
+ * @return The maximum number of operands simultaneously on the stack.
+ */
+std::size_t Optimizer::StackDepth(const std::vector<Instruction>& code) {
+  std::size_t depth = 0;
+  std::size_t max_depth = 0;
+  for (const Instruction& instruction : code) {
+    if (IsLeaf(instruction.op)) {
+      max_depth = std::max(max_depth, ++depth);
+    } else if (IsBinary(instruction.op)) {
+      --depth;
+    }
+  }
+  return max_depth;
+}
+
+}  // namespace s21
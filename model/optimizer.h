@@ -0,0 +1,139 @@
+#ifndef SMARTCALC_MODEL_OPTIMIZER_H_
+#define SMARTCALC_MODEL_OPTIMIZER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "program.h"
+
+namespace s21 {
+
+/**
+ * @class Optimizer
+ * @brief A class for simplifying compiled mathematical expressions.
+ *
+ * Optimizer rewrites a valid Program into an equivalent one with fewer
+ * instructions. It folds subexpressions that do not depend on the variable
+ * into literals, removes operations that do not change their operand (such as
+ * x*1, x-0, x^1 or a double negation), and replaces small integer powers with
+ * multiplications. Polynomials in a single variable that are written as a
+ * sum of terms in descending powers, such as 3*x^4 - 2*x^3 + x - 7, or in
+ * Horner's form are collected into their coefficients and evaluated by
+ * Horner's scheme with OpCode::kPolynomial. Finally it merges repeated
+ * subexpressions into a directed acyclic graph, so that each of them is
+ * computed once and then reused from a temporary.
+ */
+class Optimizer {
+ public:
+  static constexpr long kMaxPowInt = 4;
+  static constexpr std::size_t kMaxDegree = 16;
+
+  /**
+   * @struct Polynomial
+   * @brief A polynomial in a single variable with constant coefficients.
+   *
+   * coefficients[k] is the coefficient of the k-th power of the variable in
+   * the given slot, or 0 above the degree. The degree is the one of the
+   * expression the polynomial was collected from, so the leading coefficients
+   * may be zero. Constants have the degree 0 and no slot.
+   */
+  struct Polynomial {
+    static constexpr std::size_t kNoSlot =
+        std::numeric_limits<std::size_t>::max();
+
+    std::size_t slot = kNoSlot;
+    std::size_t degree = 0;
+    double coefficients[kMaxDegree + 1] = {};
+
+    static Polynomial Constant(double value);
+    static Polynomial Variable(std::size_t slot);
+    std::size_t CountTerms() const;
+    bool IsPower() const;
+    bool IsSpecialized() const;
+    double Evaluate(double x) const;
+  };
+
+  static Program Optimize(const Program& program);
+  static bool IsInteger(double value);
+  static double Apply(const Instruction& instruction, double lhs,
+                      double rhs = 0.0);
+  static bool Apply(const Instruction& instruction, const Polynomial& lhs,
+                    const Polynomial& rhs, Polynomial& result);
+
+ private:
+  /**
+   * @struct Operand
+   * @brief Describes an operand on the stack during optimization.
+   *
+   * Every operand corresponds to a contiguous range of the optimized code that
+   * starts at the given position and ends either at the start of the next
+   * operand or at the end of the code. Constant operands are always a single
+   * OpCode::kNumber instruction.
+   */
+  struct Operand {
+    std::size_t begin;
+    bool constant;
+    double value;
+  };
+
+  /**
+   * @struct Node
+   * @brief A distinct subexpression in the expression DAG.
+   *
+   * Nodes are identified by their instruction and the identifiers of their
+   * operands, which are kNone where absent. Literals are compared by their bit
+   * patterns, so that 0 and -0 stay distinct.
+   */
+  struct Node {
+    OpCode op;
+    std::uint64_t bits;
+    std::size_t lhs;
+    std::size_t rhs;
+
+    bool operator==(const Node& other) const {
+      return op == other.op && bits == other.bits && lhs == other.lhs &&
+             rhs == other.rhs;
+    }
+  };
+
+  /**
+   * @struct NodeHash
+   * @brief Hash function for the nodes of the expression DAG.
+   */
+  struct NodeHash {
+    std::size_t operator()(const Node& node) const {
+      std::size_t hash = std::hash<std::uint64_t>()(node.bits);
+      for (std::size_t part : {static_cast<std::size_t>(node.op), node.lhs,
+                               node.rhs}) {
+        hash ^= part + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+
+  static constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+  static void OptimizeUnary(const Instruction& instruction,
+                            std::vector<Instruction>& code,
+                            std::vector<Operand>& operands);
+  static void OptimizeBinary(const Instruction& instruction,
+                             std::vector<Instruction>& code,
+                             std::vector<Operand>& operands);
+  static void EmitConstant(double value, std::size_t begin,
+                           std::vector<Instruction>& code,
+                           std::vector<Operand>& operands);
+  static bool Multiply(const Polynomial& lhs, const Polynomial& rhs,
+                       Polynomial& result);
+  static void SpecializePolynomials(std::vector<Instruction>& code);
+  static void ShareSubexpressions(Program& program);
+  static std::size_t StackDepth(const std::vector<Instruction>& code);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_OPTIMIZER_H_
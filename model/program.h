@@ -0,0 +1,191 @@
+#ifndef SMARTCALC_MODEL_PROGRAM_H_
+#define SMARTCALC_MODEL_PROGRAM_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+enum class OpCode : unsigned char {
+  kNumber,
+  kVariable,
+  kNegate,
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+  kPow,
+  kMod,
+  kPowInt,
+  kSin,
+  kCos,
+  kTan,
+  kAsin,
+  kAcos,
+  kAtan,
+  kSqrt,
+  kLn,
+  kLog,
+  kStore,
+  kLoad,
+  kPolynomial,
+  kCoefficient
+};
+
+/**
+ * @struct Instruction
+ * @brief A single instruction of a compiled expression.
+ *
+ * Every instruction consists of an opcode and an optional operand. Numeric
+ * literals are decoded once at compile time and stored in the value field, so
+ * evaluation never has to look at the source text again. For OpCode::kPowInt
+ * the value field holds the integer exponent and for OpCode::kVariable the
+ * slot of the variable. OpCode::kStore copies the top of the stack into a
+ * temporary without removing it and OpCode::kLoad pushes a copy of a
+ * temporary; for both the value field holds the index of the temporary in the
+ * operand buffer. OpCode::kPolynomial replaces its operand t with the value of
+ * a polynomial in t; its value field holds the degree n, and it is followed
+ * by n + 1 OpCode::kCoefficient instructions with the coefficients from the
+ * highest power down to the constant term, which are not executed on their
+ * own.
+ */
+struct Instruction {
+  OpCode op;
+  double value;
+};
+
+/**
+ * @struct Program
+ * @brief A compiled mathematical expression.
+ *
+ * Program stores the instructions of an expression in Reverse Polish Notation
+ * together with the maximum depth of the operand stack reached while
+ * executing them. The depth is computed at compile time, which allows the
+ * evaluator to work on a preallocated flat operand buffer. Subexpressions
+ * that occur more than once are computed only once and kept in temporaries,
+ * which occupy the buffer above the highest operand and are included in the
+ * depth. The names of the variables are listed in the order of their slots;
+ * a Program without names reads at most the variable in slot 0.
+ */
+struct Program {
+  std::vector<Instruction> code;
+  std::size_t depth = 0;
+  std::vector<std::string> variables;
+};
+
+/**
+ * @struct ProgramView
+ * @brief A non-owning reference to the instructions of a compiled expression.
+ *
+ * ProgramView holds what the evaluators need to execute a Program: its
+ * instructions, the depth of its operand buffer and the number of its
+ * variables. It is implicitly created from a Program and also refers to
+ * programs stored elsewhere, such as in a memory-mapped ProgramLibrary,
+ * which are then executed in place. The referenced instructions must outlive
+ * the view.
+ */
+struct ProgramView {
+  ProgramView() = default;
+  ProgramView(const Instruction* code, std::size_t length, std::size_t depth,
+              std::size_t variables)
+      : code(code), length(length), depth(depth), variables(variables) {}
+  ProgramView(const Program& program)  // NOLINT(runtime/explicit)
+      : code(program.code.data()),
+        length(program.code.size()),
+        depth(program.depth),
+        variables(program.variables.size()) {}
+
+  const Instruction* code = nullptr;
+  std::size_t length = 0;
+  std::size_t depth = 0;
+  std::size_t variables = 0;
+};
+
+/**
+ * @brief Checks if an opcode takes two operands from the stack.
+ *
+ * @param op The opcode to be checked.
+ * @return True for binary operators, False otherwise.
+ */
+inline bool IsBinary(OpCode op) {
+  return op == OpCode::kAdd || op == OpCode::kSub || op == OpCode::kMul ||
+         op == OpCode::kDiv || op == OpCode::kPow || op == OpCode::kMod;
+}
+
+/**
+ * @brief Checks if an opcode pushes a value without consuming operands.
+ *
+ * @param op The opcode to be checked.
+ * @return True for literals, variables and temporaries, False otherwise.
+ */
+inline bool IsLeaf(OpCode op) {
+  return op == OpCode::kNumber || op == OpCode::kVariable ||
+         op == OpCode::kLoad;
+}
+
+/**
+ * @brief Counts the instructions of an operation, including the coefficients
+ * that follow an OpCode::kPolynomial.
+ *
+ * @param instruction The first instruction of the operation.
+ * @return The number of instructions to skip to reach the next operation.
+ */
+inline std::size_t Length(const Instruction& instruction) {
+  return instruction.op == OpCode::kPolynomial
+             ? static_cast<std::size_t>(instruction.value) + 2
+             : 1;
+}
+
+/**
+ * @brief Raises a number to an integer power by repeated squaring.
+ *
+ * Used for OpCode::kPowInt. Compared to std::pow the result is computed with
+ * plain multiplications and may differ from it by a few units in the last
+ * place for exponents other than 0, 1 and 2.
+ *
+ * @param base The number to be raised to the power.
+ * @param exponent The integer exponent.
+ * @return base raised to the power of exponent.
+ */
+template <class T>
+inline T PowInt(T base, long exponent) {
+  unsigned long n = std::labs(exponent);
+  T result = 1;
+  while (n) {
+    if (n & 1) {
+      result *= base;
+    }
+    n >>= 1;
+    if (n) {
+      base *= base;
+    }
+  }
+  return exponent < 0 ? T(1) / result : result;
+}
+
+/**
+ * @brief Evaluates the polynomial of an OpCode::kPolynomial instruction by
+ * Horner's scheme.
+ *
+ * Every step multiplies and then adds with separate roundings, so the scalar,
+ * vector and native evaluators produce the same results.
+ *
+ * @param coefficients The OpCode::kCoefficient instructions following the
+ * OpCode::kPolynomial, from the highest power down.
+ * @param degree The degree of the polynomial.
+ * @param x The argument.
+ * @return The value of the polynomial at x.
+ */
+template <class T>
+inline T Horner(const Instruction* coefficients, std::size_t degree, T x) {
+  T result = static_cast<T>(coefficients[0].value);
+  for (std::size_t i = 1; i <= degree; ++i) {
+    result = result * x + static_cast<T>(coefficients[i].value);
+  }
+  return result;
+}
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_PROGRAM_H_
@@ -0,0 +1,203 @@
+#include "program_cache.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructor of the ProgramCache class.
+ *
+ * @param capacity The maximum number of compiled expressions kept in the
+ * cache. A capacity of 0 disables caching.
+ */
+ProgramCache::ProgramCache(std::size_t capacity) : capacity_(capacity) {}
+
+/**
+ * @brief Returns the compiled form of an expression.
+ *
+ * The expression is first looked up by its exact text and then by its
+ * canonical form. If neither is found, the expression is compiled outside of
+ * the lock, so a slow compilation does not block lookups by other threads,
+ * and the result is inserted as the most recently used entry. Invalid
+ * expressions are not cached. The same text compiled with different
+ * VariableTables yields different entries.
+ *
+ * @param expression The mathematical expression.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled expression.
+ * @throws std::logic_error if the expression is invalid.
+ */
+std::shared_ptr<const Program> ProgramCache::Get(
+    const std::string& expression, const VariableTable& variables) {
+  Error error;
+  std::shared_ptr<const Program> program = Get(expression, error, variables);
+  if (!error.IsOk()) {
+    throw std::logic_error(error.message);
+  }
+  return program;
+}
+
+/**
+ * @brief Returns the compiled form of an expression without throwing.
+ *
+ * Works like the throwing overload, but reports an invalid expression through
+ * the error.
+ *
+ * @param expression The mathematical expression.
+ * @param error Receives the reason if the expression is invalid.
+ * @param variables The variables that may appear in the expression.
+ * @return The compiled expression, or nullptr on error.
+ */
+std::shared_ptr<const Program> ProgramCache::Get(
+    const std::string& expression, Error& error,
+    const VariableTable& variables) {
+  error = Error();
+  std::string scope = Scope(variables);
+  std::string text = scope + expression;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto alias = aliases_.find(text);
+    if (alias != aliases_.end()) {
+      return Hit(alias->second);
+    }
+  }
+
+  std::string canonical =
+      scope + MathCalc::Canonicalize(expression, error, variables);
+  if (!error.IsOk()) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = canonical_.find(canonical);
+    if (entry != canonical_.end()) {
+      AddAlias(entry->second, text);
+      return Hit(entry->second);
+    }
+  }
+
+  Program compiled = MathCalc::Compile(expression, error, variables);
+  if (!error.IsOk()) {
+    return nullptr;
+  }
+  auto program = std::make_shared<const Program>(std::move(compiled));
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++misses_;
+  if (capacity_ == 0) {
+    return program;
+  }
+  auto entry = canonical_.find(canonical);
+  if (entry != canonical_.end()) {
+    AddAlias(entry->second, text);
+    entries_.splice(entries_.begin(), entries_, entry->second);
+    return entry->second->program;
+  }
+  entries_.push_front({canonical, program, {}});
+  canonical_.emplace(std::move(canonical), entries_.begin());
+  AddAlias(entries_.begin(), text);
+  Shrink();
+  return program;
+}
+
+/**
+ * @brief Changes the maximum number of compiled expressions in the cache.
+ *
+ * Evicts the least recently used entries if the cache holds more than the new
+ * capacity.
+ *
+ * @param capacity The new capacity. A capacity of 0 disables caching.
+ */
+void ProgramCache::SetCapacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  Shrink();
+}
+
+/**
+ * @brief Returns the maximum number of compiled expressions in the cache.
+ */
+std::size_t ProgramCache::GetCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+/**
+ * @brief Returns the counters of the cache.
+ *
+ * @return The number of hits, misses and evictions since construction or the
+ * last call to Clear, together with the current size and capacity.
+ */
+ProgramCache::Statistics ProgramCache::GetStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {hits_, misses_, evictions_, entries_.size(), capacity_};
+}
+
+/**
+ * @brief Removes all entries and resets the counters.
+ */
+void ProgramCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  canonical_.clear();
+  aliases_.clear();
+  hits_ = misses_ = evictions_ = 0;
+}
+
+/**
+ * @brief Returns the prefix of the keys of expressions compiled with a
+ * VariableTable.
+ *
+ * Variable names consist of letters and underscores, so the separators cannot
+ * occur in them.
+ */
+std::string ProgramCache::Scope(const VariableTable& variables) {
+  std::string scope;
+  for (const std::string& name : variables.GetNames()) {
+    scope += name + ',';
+  }
+  return scope + ';';
+}
+
+/**
+ * @brief Records a hit and marks an entry as the most recently used one.
+ *
+ * Must be called with the mutex locked.
+ */
+std::shared_ptr<const Program> ProgramCache::Hit(Iterator entry) {
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, entry);
+  return entry->program;
+}
+
+/**
+ * @brief Remembers the exact text of an expression for an entry.
+ *
+ * At most kMaxAliases texts are remembered per entry, so that many spelling
+ * variants of one expression cannot grow the cache without bound. Must be
+ * called with the mutex locked.
+ */
+void ProgramCache::AddAlias(Iterator entry, const std::string& expression) {
+  if (entry->aliases.size() < kMaxAliases &&
+      aliases_.emplace(expression, entry).second) {
+    entry->aliases.push_back(expression);
+  }
+}
+
+/**
+ * @brief Evicts the least recently used entries until the size of the cache
+ * does not exceed its capacity.
+ *
+ * Must be called with the mutex locked.
+ */
+void ProgramCache::Shrink() {
+  while (entries_.size() > capacity_) {
+    Entry& entry = entries_.back();
+    for (const std::string& alias : entry.aliases) {
+      aliases_.erase(alias);
+    }
+    canonical_.erase(entry.canonical);
+    entries_.pop_back();
+    ++evictions_;
+  }
+}
+
+}  // namespace s21
@@ -0,0 +1,91 @@
+#ifndef SMARTCALC_MODEL_PROGRAM_CACHE_H_
+#define SMARTCALC_MODEL_PROGRAM_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "error.h"
+#include "math_calc.h"
+#include "program.h"
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @class ProgramCache
+ * @brief A thread-safe LRU cache of compiled expressions.
+ *
+ * ProgramCache maps expressions to their compiled Programs and keeps at most
+ * a given number of them, evicting the least recently used one when full.
+ * Entries are keyed by the canonical form of the expression (see
+ * MathCalc::Canonicalize) together with the names of its variables, so
+ * spelling variants of the same expression share a single entry. The exact
+ * texts that led to an entry are remembered as aliases, which lets repeated
+ * lookups of the same text skip tokenization.
+ * Programs are handed out as shared pointers to constant data, so they stay
+ * valid after eviction and can be executed by several threads at once.
+ */
+class ProgramCache {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 4096;
+  static constexpr std::size_t kMaxAliases = 4;
+
+  /**
+   * @struct Statistics
+   * @brief Counters describing the efficiency of the cache.
+   */
+  struct Statistics {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t size = 0;
+    std::size_t capacity = 0;
+  };
+
+  explicit ProgramCache(std::size_t capacity = kDefaultCapacity);
+
+  std::shared_ptr<const Program> Get(
+      const std::string& expression,
+      const VariableTable& variables = VariableTable());
+  std::shared_ptr<const Program> Get(
+      const std::string& expression, Error& error,
+      const VariableTable& variables = VariableTable());
+  void SetCapacity(std::size_t capacity);
+  std::size_t GetCapacity() const;
+  Statistics GetStatistics() const;
+  void Clear();
+
+ private:
+  /**
+   * @struct Entry
+   * @brief A compiled expression stored in the cache.
+   */
+  struct Entry {
+    std::string canonical;
+    std::shared_ptr<const Program> program;
+    std::vector<std::string> aliases;
+  };
+
+  using Iterator = std::list<Entry>::iterator;
+
+  static std::string Scope(const VariableTable& variables);
+  std::shared_ptr<const Program> Hit(Iterator entry);
+  void AddAlias(Iterator entry, const std::string& expression);
+  void Shrink();
+
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, Iterator> canonical_;
+  std::unordered_map<std::string, Iterator> aliases_;
+  std::size_t capacity_;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  std::size_t evictions_ = 0;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_PROGRAM_CACHE_H_
@@ -0,0 +1,516 @@
+#include "program_library.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace s21 {
+
+static_assert(sizeof(Instruction) == 16 && offsetof(Instruction, value) == 8,
+              "The library format requires 16-byte instructions");
+static_assert(std::is_trivially_copyable_v<Instruction>,
+              "Instructions are executed directly from the file");
+
+/**
+ * @brief Constructor of the ProgramLibrary class.
+ *
+ * Maps the file into memory and validates its header, its sections and the
+ * code of every program. On systems without mmap the file is read into an
+ * aligned buffer instead.
+ *
+ * @param path The path of a file written by ProgramLibrary::Builder.
+ * @throws std::runtime_error if the file cannot be read or is not a valid
+ * library of this version.
+ */
+ProgramLibrary::ProgramLibrary(const std::string& path) {
+  Map(path);
+  try {
+    Validate();
+  } catch (...) {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapped_) {
+      munmap(const_cast<unsigned char*>(data_), size_);
+    }
+#endif
+    throw;
+  }
+}
+
+/**
+ * @brief Destructor of the ProgramLibrary class.
+ *
+ * Unmaps the file. Views returned by GetProgram become invalid.
+ */
+ProgramLibrary::~ProgramLibrary() {
+#if defined(__unix__) || defined(__APPLE__)
+  if (mapped_) {
+    munmap(const_cast<unsigned char*>(data_), size_);
+  }
+#endif
+}
+
+/**
+ * @brief Returns the number of programs in the library.
+ */
+std::size_t ProgramLibrary::GetSize() const { return header_->count; }
+
+/**
+ * @brief Finds a program by name with a binary search.
+ *
+ * @param name The name the program was added with.
+ * @return The index of the program, or kNotFound.
+ */
+std::size_t ProgramLibrary::Find(std::string_view name) const {
+  const Entry* end = entries_ + header_->count;
+  const Entry* entry =
+      std::lower_bound(entries_, end, name, [this](const Entry& lhs,
+                                                   std::string_view rhs) {
+        return GetString(lhs.name) < rhs;
+      });
+  if (entry == end || GetString(entry->name) != name) {
+    return kNotFound;
+  }
+  return static_cast<std::size_t>(entry - entries_);
+}
+
+/**
+ * @brief Returns the name of a program.
+ *
+ * @param index The index of the program; programs are sorted by name.
+ * @return A view of the name, valid as long as the library.
+ * @throws std::out_of_range if the index is out of range.
+ */
+std::string_view ProgramLibrary::GetName(std::size_t index) const {
+  return GetString(GetEntry(index).name);
+}
+
+/**
+ * @brief Returns the names of the variables of a program in slot order.
+ *
+ * @param index The index of the program.
+ * @return Views of the names, valid as long as the library.
+ * @throws std::out_of_range if the index is out of range.
+ */
+std::vector<std::string_view> ProgramLibrary::GetVariables(
+    std::size_t index) const {
+  const Entry& entry = GetEntry(index);
+  std::vector<std::string_view> names;
+  names.reserve(entry.variable_count);
+  for (std::uint64_t i = 0; i < entry.variable_count; ++i) {
+    names.push_back(GetString(variables_[entry.first_variable + i]));
+  }
+  return names;
+}
+
+/**
+ * @brief Returns a program for execution in place.
+ *
+ * The view points into the mapped file and can be passed to every
+ * evaluation method of MathCalc and VectorEvaluator taking a ProgramView.
+ *
+ * @param index The index of the program.
+ * @return A view of the program, valid as long as the library.
+ * @throws std::out_of_range if the index is out of range.
+ */
+ProgramView ProgramLibrary::GetProgram(std::size_t index) const {
+  const Entry& entry = GetEntry(index);
+  return ProgramView(instructions_ + entry.code_offset,
+                     static_cast<std::size_t>(entry.code_length),
+                     static_cast<std::size_t>(entry.depth),
+                     static_cast<std::size_t>(entry.variable_count));
+}
+
+/**
+ * @brief Copies a program out of the library.
+ *
+ * Needed only by components that take a Program, such as JitProgram or the
+ * Solver.
+ *
+ * @param index The index of the program.
+ * @return A copy of the program with the names of its variables.
+ * @throws std::out_of_range if the index is out of range.
+ */
+Program ProgramLibrary::Load(std::size_t index) const {
+  ProgramView view = GetProgram(index);
+  Program program;
+  program.code.assign(view.code, view.code + view.length);
+  program.depth = view.depth;
+  for (std::string_view name : GetVariables(index)) {
+    program.variables.emplace_back(name);
+  }
+  return program;
+}
+
+/**
+ * @brief Rounds an offset up to the alignment of the sections.
+ */
+std::uint64_t ProgramLibrary::Align(std::uint64_t offset) {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/**
+ * @brief Maps a file read-only into memory, or reads it where mmap is not
+ * available.
+ */
+void ProgramLibrary::Map(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < 0) {
+    close(fd);
+    throw std::runtime_error("Cannot read " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ < sizeof(Header)) {
+    close(fd);
+    throw std::runtime_error("Invalid program library");
+  }
+  void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    throw std::runtime_error("Cannot map " + path);
+  }
+  data_ = static_cast<const unsigned char*>(memory);
+  mapped_ = true;
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  size_ = static_cast<std::size_t>(file.tellg());
+  if (size_ < sizeof(Header)) {
+    throw std::runtime_error("Invalid program library");
+  }
+  buffer_.resize((size_ + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char*>(buffer_.data()), size_)) {
+    throw std::runtime_error("Cannot read " + path);
+  }
+  data_ = reinterpret_cast<const unsigned char*>(buffer_.data());
+#endif
+  header_ = reinterpret_cast<const Header*>(data_);
+}
+
+/**
+ * @brief Checks that the mapped file is a consistent library.
+ *
+ * The sections must follow each other in order at aligned offsets and end
+ * within the file, every name must lie within the strings section and the
+ * code of every program must be executable with its declared stack depth.
+ */
+void ProgramLibrary::Validate() {
+  const Header& header = *header_;
+  if (header.magic != kMagic || header.byte_order != kByteOrder) {
+    throw std::runtime_error("Invalid program library");
+  }
+  if (header.version != kVersion) {
+    throw std::runtime_error("Unsupported program library version");
+  }
+
+  std::uint64_t entries_end =
+      header.entries_offset + std::uint64_t{header.count} * sizeof(Entry);
+  std::uint64_t variables_end =
+      header.variables_offset + header.variables * sizeof(Name);
+  std::uint64_t instructions_end =
+      header.instructions_offset + header.instructions * sizeof(Instruction);
+  std::uint64_t limit = size_;
+  if (header.size != size_ || header.entries_offset != Align(sizeof(Header)) ||
+      header.variables_offset != Align(entries_end) ||
+      header.instructions_offset != Align(variables_end) ||
+      header.strings_offset != Align(instructions_end) ||
+      header.strings_offset > limit || header.variables > limit ||
+      header.instructions > limit) {
+    throw std::runtime_error("Invalid program library");
+  }
+
+  entries_ = reinterpret_cast<const Entry*>(data_ + header.entries_offset);
+  variables_ = reinterpret_cast<const Name*>(data_ + header.variables_offset);
+  instructions_ = reinterpret_cast<const Instruction*>(
+      data_ + header.instructions_offset);
+
+  std::uint64_t strings = size_ - header.strings_offset;
+  auto valid_name = [strings](const Name& name) {
+    return name.offset <= strings && name.length <= strings - name.offset;
+  };
+  for (std::uint64_t i = 0; i < header.variables; ++i) {
+    if (!valid_name(variables_[i])) {
+      throw std::runtime_error("Invalid program library");
+    }
+  }
+  for (std::uint32_t i = 0; i < header.count; ++i) {
+    const Entry& entry = entries_[i];
+    if (!valid_name(entry.name) || entry.first_variable > header.variables ||
+        entry.variable_count > header.variables - entry.first_variable ||
+        entry.code_offset > header.instructions ||
+        entry.code_length > header.instructions - entry.code_offset ||
+        (i > 0 && GetString(entries_[i - 1].name) >= GetString(entry.name))) {
+      throw std::runtime_error("Invalid program library");
+    }
+    ValidateCode(entry, instructions_ + entry.code_offset);
+  }
+}
+
+/**
+ * @brief Checks that the code of a program keeps its operands and
+ * temporaries within its stack depth and reads only existing variables.
+ *
+ * Every OpCode::kPolynomial must be followed by its coefficients, and a
+ * coefficient anywhere else is rejected.
+ */
+void ProgramLibrary::ValidateCode(const Entry& entry, const Instruction* code) {
+  auto fail = [] { throw std::runtime_error("Invalid program library code"); };
+  auto index_below = [](double value, std::uint64_t limit) {
+    return value >= 0.0 && value < static_cast<double>(limit) &&
+           Optimizer::IsInteger(value);
+  };
+  std::uint64_t slots = std::max<std::uint64_t>(entry.variable_count, 1);
+  std::uint64_t top = 0;
+
+  for (std::uint64_t i = 0; i < entry.code_length; ++i) {
+    const Instruction& instruction = code[i];
+    switch (instruction.op) {
+      case OpCode::kNumber:
+        ++top;
+        break;
+      case OpCode::kVariable:
+        if (!index_below(instruction.value, slots)) {
+          fail();
+        }
+        ++top;
+        break;
+      case OpCode::kLoad:
+        if (!index_below(instruction.value, entry.depth)) {
+          fail();
+        }
+        ++top;
+        break;
+      case OpCode::kStore:
+        if (top < 1 || !index_below(instruction.value, entry.depth)) {
+          fail();
+        }
+        break;
+      case OpCode::kAdd:
+      case OpCode::kSub:
+      case OpCode::kMul:
+      case OpCode::kDiv:
+      case OpCode::kPow:
+      case OpCode::kMod:
+        if (top < 2) {
+          fail();
+        }
+        --top;
+        break;
+      case OpCode::kPowInt:
+        if (top < 1 || !Optimizer::IsInteger(instruction.value) ||
+            std::fabs(instruction.value) >
+                static_cast<double>(std::numeric_limits<int>::max())) {
+          fail();
+        }
+        break;
+      case OpCode::kPolynomial:
+        if (top < 1 ||
+            !index_below(instruction.value, entry.code_length - i - 1)) {
+          fail();
+        }
+        for (std::uint64_t end =
+                 i + 1 + static_cast<std::uint64_t>(instruction.value);
+             i < end;) {
+          if (code[++i].op != OpCode::kCoefficient) {
+            fail();
+          }
+        }
+        break;
+      case OpCode::kNegate:
+      case OpCode::kSin:
+      case OpCode::kCos:
+      case OpCode::kTan:
+      case OpCode::kAsin:
+      case OpCode::kAcos:
+      case OpCode::kAtan:
+      case OpCode::kSqrt:
+      case OpCode::kLn:
+      case OpCode::kLog:
+        if (top < 1) {
+          fail();
+        }
+        break;
+      default:
+        fail();
+    }
+    if (top > entry.depth) {
+      fail();
+    }
+  }
+  if (top != 1) {
+    fail();
+  }
+}
+
+/**
+ * @brief Returns a name stored in the strings section.
+ */
+std::string_view ProgramLibrary::GetString(const Name& name) const {
+  return std::string_view(
+      reinterpret_cast<const char*>(data_ + header_->strings_offset) +
+          name.offset,
+      static_cast<std::size_t>(name.length));
+}
+
+/**
+ * @brief Returns the entry of a program.
+ *
+ * @throws std::out_of_range if the index is out of range.
+ */
+const ProgramLibrary::Entry& ProgramLibrary::GetEntry(std::size_t index) const {
+  if (index >= header_->count) {
+    throw std::out_of_range("Invalid program index");
+  }
+  return entries_[index];
+}
+
+/**
+ * @brief Adds a compiled expression to the library.
+ *
+ * @param name The name the program is found by; names must be unique.
+ * @param program A valid compiled expression.
+ */
+void ProgramLibrary::Builder::Add(const std::string& name,
+                                  const Program& program) {
+  programs_.emplace_back(name, program);
+}
+
+/**
+ * @brief Compiles an expression and adds it to the library.
+ *
+ * @param name The name the program is found by; names must be unique.
+ * @param expression The mathematical expression.
+ * @param variables The variables that may appear in the expression.
+ * @throws std::logic_error if the expression is invalid.
+ */
+void ProgramLibrary::Builder::Add(const std::string& name,
+                                  const std::string& expression,
+                                  const VariableTable& variables) {
+  programs_.emplace_back(name, MathCalc::Compile(expression, variables));
+}
+
+/**
+ * @brief Returns the number of programs added so far.
+ */
+std::size_t ProgramLibrary::Builder::GetSize() const {
+  return programs_.size();
+}
+
+/**
+ * @brief Writes the added programs as a library file.
+ *
+ * The file is assembled in memory and written with a single call. Padding
+ * between sections and within instructions is zero, so the same programs
+ * always produce the same file.
+ *
+ * @param path The path of the file to be written.
+ * @throws std::invalid_argument if two programs have the same name.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void ProgramLibrary::Builder::Write(const std::string& path) const {
+  std::vector<const std::pair<std::string, Program>*> order;
+  order.reserve(programs_.size());
+  for (const auto& program : programs_) {
+    order.push_back(&program);
+  }
+  std::sort(order.begin(), order.end(),
+            [](const auto* lhs, const auto* rhs) {
+              return lhs->first < rhs->first;
+            });
+  for (std::size_t i = 1; i < order.size(); ++i) {
+    if (order[i - 1]->first == order[i]->first) {
+      throw std::invalid_argument("Duplicate program name: " +
+                                  order[i]->first);
+    }
+  }
+  if (order.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::invalid_argument("Too many programs");
+  }
+
+  Header header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.byte_order = kByteOrder;
+  header.count = static_cast<std::uint32_t>(order.size());
+  std::uint64_t strings_size = 0;
+  for (const auto* program : order) {
+    header.variables += program->second.variables.size();
+    header.instructions += program->second.code.size();
+    strings_size += program->first.size();
+    for (const std::string& variable : program->second.variables) {
+      strings_size += variable.size();
+    }
+  }
+  header.entries_offset = Align(sizeof(Header));
+  header.variables_offset =
+      Align(header.entries_offset + header.count * sizeof(Entry));
+  header.instructions_offset =
+      Align(header.variables_offset + header.variables * sizeof(Name));
+  header.strings_offset = Align(header.instructions_offset +
+                                header.instructions * sizeof(Instruction));
+  header.size = header.strings_offset + strings_size;
+
+  std::vector<unsigned char> bytes(header.size);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  unsigned char* entries = bytes.data() + header.entries_offset;
+  unsigned char* variables = bytes.data() + header.variables_offset;
+  unsigned char* instructions = bytes.data() + header.instructions_offset;
+  unsigned char* strings = bytes.data() + header.strings_offset;
+  std::uint64_t string_offset = 0;
+  std::uint64_t variable_index = 0;
+  std::uint64_t code_offset = 0;
+  auto add_string = [&](const std::string& text) {
+    Name name{string_offset, text.size()};
+    std::memcpy(strings + string_offset, text.data(), text.size());
+    string_offset += text.size();
+    return name;
+  };
+
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const Program& program = order[i]->second;
+    Entry entry{};
+    entry.name = add_string(order[i]->first);
+    entry.first_variable = variable_index;
+    entry.variable_count = program.variables.size();
+    entry.code_offset = code_offset;
+    entry.code_length = program.code.size();
+    entry.depth = program.depth;
+    std::memcpy(entries + i * sizeof(Entry), &entry, sizeof(entry));
+    for (const std::string& variable : program.variables) {
+      Name name = add_string(variable);
+      std::memcpy(variables + variable_index++ * sizeof(Name), &name,
+                  sizeof(name));
+    }
+    for (const Instruction& instruction : program.code) {
+      unsigned char* record =
+          instructions + code_offset++ * sizeof(Instruction);
+      record[0] = static_cast<unsigned char>(instruction.op);
+      std::memcpy(record + offsetof(Instruction, value), &instruction.value,
+                  sizeof(instruction.value));
+    }
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.write(reinterpret_cast<const char*>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()))) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+}  // namespace s21
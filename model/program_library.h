@@ -0,0 +1,152 @@
+#ifndef SMARTCALC_MODEL_PROGRAM_LIBRARY_H_
+#define SMARTCALC_MODEL_PROGRAM_LIBRARY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "math_calc.h"
+#include "program.h"
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @class ProgramLibrary
+ * @brief A read-only file of compiled expressions evaluated in place.
+ *
+ * A ProgramLibrary is written once by a ProgramLibrary::Builder and then
+ * memory-mapped by any number of processes. Loading only validates the file,
+ * without copying or decoding the programs: GetProgram returns a ProgramView
+ * that points into the mapping and is executed directly by MathCalc and
+ * VectorEvaluator, so opening a library of tens of thousands of expressions
+ * takes about as long as reading its pages.
+ *
+ * The file is laid out in native byte order as a Header, followed by one
+ * Entry per program sorted by name, the name references of the variables,
+ * the instructions of all programs and finally the texts of the names:
+ *
+ * | Section      | Contents                                        |
+ * |--------------|-------------------------------------------------|
+ * | Header       | magic, version, byte order, counts, offsets     |
+ * | Entries      | name, variables, depth and code of each program |
+ * | Variables    | offset and length of every variable name        |
+ * | Instructions | 16 bytes each: opcode, 7 zero bytes, value      |
+ * | Strings      | names of the programs and of their variables    |
+ *
+ * Sections start at multiples of 16 bytes. The instructions have the layout
+ * of Instruction, which is checked at compile time. A file with another
+ * magic, version or byte order, or with sections, instructions or stack
+ * usage inconsistent with its header, is rejected with a std::runtime_error,
+ * so a truncated or corrupt file can never be executed.
+ */
+class ProgramLibrary {
+ public:
+  static constexpr std::uint32_t kMagic = 0x4c504353;  // "SCPL"
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kByteOrder = 0x01020304;
+  static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+  class Builder;
+
+  explicit ProgramLibrary(const std::string& path);
+  ~ProgramLibrary();
+
+  ProgramLibrary(const ProgramLibrary&) = delete;
+  ProgramLibrary& operator=(const ProgramLibrary&) = delete;
+
+  std::size_t GetSize() const;
+  std::size_t Find(std::string_view name) const;
+  std::string_view GetName(std::size_t index) const;
+  std::vector<std::string_view> GetVariables(std::size_t index) const;
+  ProgramView GetProgram(std::size_t index) const;
+  Program Load(std::size_t index) const;
+
+ private:
+  /**
+   * @struct Header
+   * @brief The first bytes of a library file.
+   */
+  struct Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t count;
+    std::uint64_t variables;
+    std::uint64_t instructions;
+    std::uint64_t entries_offset;
+    std::uint64_t variables_offset;
+    std::uint64_t instructions_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t size;
+    std::uint64_t reserved;
+  };
+
+  /**
+   * @struct Name
+   * @brief The position of a name in the strings section.
+   */
+  struct Name {
+    std::uint64_t offset;
+    std::uint64_t length;
+  };
+
+  /**
+   * @struct Entry
+   * @brief The description of a single program.
+   */
+  struct Entry {
+    Name name;
+    std::uint64_t first_variable;
+    std::uint64_t variable_count;
+    std::uint64_t code_offset;
+    std::uint64_t code_length;
+    std::uint64_t depth;
+    std::uint64_t reserved;
+  };
+
+  static constexpr std::size_t kAlignment = 16;
+
+  static std::uint64_t Align(std::uint64_t offset);
+  void Map(const std::string& path);
+  void Validate();
+  static void ValidateCode(const Entry& entry, const Instruction* code);
+  std::string_view GetString(const Name& name) const;
+  const Entry& GetEntry(std::size_t index) const;
+
+  const unsigned char* data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped_ = false;
+  std::vector<std::uint64_t> buffer_;
+  const Header* header_ = nullptr;
+  const Entry* entries_ = nullptr;
+  const Name* variables_ = nullptr;
+  const Instruction* instructions_ = nullptr;
+};
+
+/**
+ * @class ProgramLibrary::Builder
+ * @brief Collects compiled expressions and writes them as a ProgramLibrary.
+ *
+ * Every program is stored under a unique name. The Builder keeps copies of
+ * the programs until Write, which sorts them by name, lays out the sections
+ * and writes the file in one pass.
+ */
+class ProgramLibrary::Builder {
+ public:
+  void Add(const std::string& name, const Program& program);
+  void Add(const std::string& name, const std::string& expression,
+           const VariableTable& variables = VariableTable());
+  std::size_t GetSize() const;
+  void Write(const std::string& path) const;
+
+ private:
+  std::vector<std::pair<std::string, Program>> programs_;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_PROGRAM_LIBRARY_H_
@@ -0,0 +1,217 @@
+#include "solver.h"
+
+namespace s21 {
+
+/**
+ * @brief Finds the roots and extrema of a compiled expression in a range.
+ *
+ * Every grid point where the function or its derivative is exactly zero is
+ * a root or an extremum itself, unless the second derivative shows that the
+ * zero of the derivative is only rounding noise. Sign changes by jumps, such
+ * as those across poles, are neither roots nor extrema.
+ *
+ * @param program A compiled expression with at most one variable.
+ * @param options The parameters of the search.
+ * @return The roots and extrema found in [options.x_min, options.x_max].
+ * @throws std::logic_error if the range is empty or not finite, or if the
+ * expression has more than one variable.
+ */
+Solver::Result Solver::Solve(const Program& program, const Options& options) {
+  if (!(options.x_min < options.x_max) || !std::isfinite(options.x_min) ||
+      !std::isfinite(options.x_max)) {
+    throw std::logic_error("Invalid search range");
+  }
+
+  std::size_t cells = std::max<std::size_t>(options.cells, 1);
+  double step = (options.x_max - options.x_min) / cells;
+  std::vector<double> x(cells + 1);
+  std::vector<Dual> f(cells + 1);
+  Search search = {program, options, 0.0, 0.0, {}};
+  for (std::size_t i = 0; i <= cells; ++i) {
+    x[i] = i == cells ? options.x_max
+                      : options.x_min + static_cast<double>(i) * step;
+    f[i] = DualEvaluator::Evaluate(program, x[i]);
+    if (std::isfinite(f[i].value)) {
+      search.scale = std::max(search.scale, std::abs(f[i].value));
+    }
+    if (std::isfinite(f[i].first)) {
+      search.slope = std::max(search.slope, std::abs(f[i].first));
+    }
+  }
+
+  for (std::size_t i = 0; i <= cells; ++i) {
+    if (f[i].value == 0.0) {
+      search.result.roots.push_back(x[i]);
+    }
+    if (f[i].first == 0.0 && std::isfinite(f[i].second) &&
+        std::abs(f[i].second) * step * step >
+            options.tolerance * std::abs(f[i].value)) {
+      search.result.extrema.push_back({x[i], f[i].value, f[i].second < 0.0});
+    }
+    if (i < cells) {
+      SearchCell(search, x[i], f[i], x[i + 1], f[i + 1], 0);
+    }
+  }
+
+  Deduplicate(search.result.roots, search.result.extrema, options.tolerance);
+  return search.result;
+}
+
+/**
+ * @brief Searches one cell of the grid for roots and extrema.
+ *
+ * A cell is bisected, up to kMaxDepth times, as long as its interval bound
+ * contains zero, which separates roots closer than the grid step. In the
+ * final cells the sign changes of the function and its derivative are
+ * searched. Sign changes of the derivative that are negligible compared to
+ * the function are rounding noise of a constant and are ignored. An extremum
+ * where the function takes the opposite sign of both ends brackets a root on
+ * either side, and one where it is negligible is a root of even
+ * multiplicity.
+ *
+ * @param search The state of the search.
+ * @param a The start of the cell.
+ * @param fa The value and derivatives at a.
+ * @param b The end of the cell.
+ * @param fb The value and derivatives at b.
+ * @param depth The number of bisections that led to the cell.
+ */
+void Solver::SearchCell(Search& search, double a, const Dual& fa, double b,
+                        const Dual& fb, int depth) {
+  Result& result = search.result;
+  if (!std::isfinite(fa.value) || !std::isfinite(fb.value)) {
+    return;
+  }
+  if (depth < kMaxDepth) {
+    IntervalEvaluator::Interval bound =
+        IntervalEvaluator::Evaluate(search.program, {a, b, true});
+    if (!bound.IsEmpty() && bound.lower <= 0.0 && bound.upper >= 0.0) {
+      double m = a + (b - a) / 2;
+      Dual fm = DualEvaluator::Evaluate(search.program, m);
+      if (fm.value == 0.0) {
+        result.roots.push_back(m);
+      }
+      SearchCell(search, a, fa, m, fm, depth + 1);
+      SearchCell(search, m, fm, b, fb, depth + 1);
+      return;
+    }
+  }
+
+  double x = 0.0;
+  Dual fx;
+  double magnitude = std::max(std::abs(fa.value), std::abs(fb.value));
+  if (HasSignChange(fa.value, fb.value) &&
+      FindZero(search, a, fa, b, fb, false, x, fx)) {
+    result.roots.push_back(x);
+  }
+  if (HasSignChange(fa.first, fb.first) &&
+      std::max(std::abs(fa.first), std::abs(fb.first)) * (b - a) >
+          search.options.tolerance * magnitude &&
+      FindZero(search, a, fa, b, fb, true, x, fx)) {
+    result.extrema.push_back({x, fx.value, fa.first > 0.0});
+    double extremum = x;
+    Dual f_extremum = fx;
+    if (HasSignChange(fa.value, f_extremum.value) &&
+        HasSignChange(f_extremum.value, fb.value)) {
+      if (FindZero(search, a, fa, extremum, f_extremum, false, x, fx)) {
+        result.roots.push_back(x);
+      }
+      if (FindZero(search, extremum, f_extremum, b, fb, false, x, fx)) {
+        result.roots.push_back(x);
+      }
+    } else if (std::abs(f_extremum.value) <=
+               search.options.tolerance * magnitude) {
+      result.roots.push_back(extremum);
+    }
+  }
+}
+
+/**
+ * @brief Locates a zero of the function or its derivative in a bracket.
+ *
+ * Newton steps are taken while they stay in the bracket, which shrinks
+ * around the zero with every evaluation; otherwise the bracket is bisected.
+ * A zero is only accepted if the function is smaller in magnitude there than
+ * at both ends or negligible compared to its magnitude on the grid, which
+ * rejects sign changes across poles and jumps.
+ *
+ * @param search The state of the search.
+ * @param a The end of the bracket.
+ * @param fa The value and derivatives at a.
+ * @param b The other end of the bracket, where the sign is opposite.
+ * @param fb The value and derivatives at b.
+ * @param derivative True to find a zero of the first derivative.
+ * @param x The zero.
+ * @param fx The value and derivatives at x.
+ * @return True if a zero was found.
+ */
+bool Solver::FindZero(Search& search, double a, const Dual& fa, double b,
+                      const Dual& fb, bool derivative, double& x, Dual& fx) {
+  auto g = [derivative](const Dual& f) {
+    return derivative ? f.first : f.value;
+  };
+  auto slope = [derivative](const Dual& f) {
+    return derivative ? f.second : f.first;
+  };
+  double tolerance = search.options.tolerance;
+  bool negative_a = g(fa) < 0.0;
+
+  x = a + (b - a) / 2;
+  fx = DualEvaluator::Evaluate(search.program, x);
+  for (std::size_t i = 0; i < search.options.iterations && g(fx) != 0.0;
+       ++i) {
+    if ((g(fx) < 0.0) == negative_a) {
+      a = x;
+    } else {
+      b = x;
+    }
+    double next = x - g(fx) / slope(fx);
+    if (!(next >= std::min(a, b) && next <= std::max(a, b))) {
+      next = a + (b - a) / 2;
+    }
+    double limit = tolerance * std::max(1.0, std::abs(next));
+    bool converged = std::abs(next - x) <= limit || std::abs(b - a) <= limit;
+    x = next;
+    fx = DualEvaluator::Evaluate(search.program, x);
+    if (converged) {
+      break;
+    }
+  }
+
+  double residual = std::abs(g(fx));
+  return residual <= std::min(std::abs(g(fa)), std::abs(g(fb))) ||
+         residual <= tolerance * (derivative ? search.slope : search.scale);
+}
+
+/**
+ * @brief Checks if two finite values have strictly opposite signs.
+ */
+bool Solver::HasSignChange(double a, double b) {
+  return std::isfinite(a) && std::isfinite(b) &&
+         ((a < 0.0 && b > 0.0) || (a > 0.0 && b < 0.0));
+}
+
+/**
+ * @brief Sorts the results and merges points found more than once.
+ */
+void Solver::Deduplicate(std::vector<double>& roots,
+                         std::vector<Extremum>& extrema, double tolerance) {
+  auto close = [tolerance](double lhs, double rhs) {
+    return std::abs(lhs - rhs) <=
+           4 * tolerance * std::max({1.0, std::abs(lhs), std::abs(rhs)});
+  };
+  std::sort(roots.begin(), roots.end());
+  roots.erase(std::unique(roots.begin(), roots.end(), close), roots.end());
+  std::sort(extrema.begin(), extrema.end(),
+            [](const Extremum& lhs, const Extremum& rhs) {
+              return lhs.x < rhs.x;
+            });
+  extrema.erase(std::unique(extrema.begin(), extrema.end(),
+                            [&close](const Extremum& lhs,
+                                     const Extremum& rhs) {
+                              return close(lhs.x, rhs.x);
+                            }),
+                extrema.end());
+}
+
+}  // namespace s21
@@ -0,0 +1,96 @@
+#ifndef SMARTCALC_MODEL_SOLVER_H_
+#define SMARTCALC_MODEL_SOLVER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "dual_evaluator.h"
+#include "interval_evaluator.h"
+#include "program.h"
+
+namespace s21 {
+
+/**
+ * @class Solver
+ * @brief A class for finding the roots and extrema of an expression.
+ *
+ * Solver scans a range with a uniform grid, evaluating the expression and its
+ * first two derivatives at every grid point with the DualEvaluator. Every cell
+ * where the function or its derivative changes sign brackets a root or an
+ * extremum, which is then located with Newton's method safeguarded by
+ * bisection. Cells are bisected a few times in search of roots that the grid
+ * missed, unless the IntervalEvaluator proves that the function has no root
+ * there.
+ */
+class Solver {
+ public:
+  /**
+   * @struct Options
+   * @brief Structure for holding the parameters of a search.
+   *
+   * The tolerance is relative to the magnitude of x. Roots of even
+   * multiplicity are recognized at extrema whose value is within the
+   * tolerance relative to the values around them.
+   */
+  struct Options {
+    double x_min = -10.0;
+    double x_max = 10.0;
+    std::size_t cells = 1000;
+    double tolerance = 1e-12;
+    std::size_t iterations = 100;
+  };
+
+  /**
+   * @struct Extremum
+   * @brief A local minimum or maximum of the function.
+   */
+  struct Extremum {
+    double x;
+    double y;
+    bool maximum;
+  };
+
+  /**
+   * @struct Result
+   * @brief The roots and extrema in increasing order of x.
+   */
+  struct Result {
+    std::vector<double> roots;
+    std::vector<Extremum> extrema;
+  };
+
+  static Result Solve(const Program& program, const Options& options);
+
+ private:
+  using Dual = DualEvaluator::Dual;
+
+  /**
+   * @struct Search
+   * @brief The state shared by the cells of one search.
+   *
+   * The scales are the largest magnitudes of the function and its derivative
+   * on the grid.
+   */
+  struct Search {
+    const Program& program;
+    const Options& options;
+    double scale;
+    double slope;
+    Result result;
+  };
+
+  static constexpr int kMaxDepth = 6;
+
+  static void SearchCell(Search& search, double a, const Dual& fa, double b,
+                         const Dual& fb, int depth);
+  static bool FindZero(Search& search, double a, const Dual& fa, double b,
+                       const Dual& fb, bool derivative, double& x, Dual& fx);
+  static bool HasSignChange(double a, double b);
+  static void Deduplicate(std::vector<double>& roots,
+                          std::vector<Extremum>& extrema, double tolerance);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_SOLVER_H_
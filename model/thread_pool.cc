@@ -0,0 +1,232 @@
+#include "thread_pool.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructor of the ThreadPool class.
+ *
+ * Starts threads - 1 worker threads; the thread calling ParallelFor is always
+ * the first participant of a loop.
+ *
+ * @param threads The maximum number of threads running a loop, at least 1.
+ */
+ThreadPool::ThreadPool(std::size_t threads)
+    : queues_(std::make_unique<Queue[]>(std::max<std::size_t>(threads, 1))) {
+  for (std::size_t i = 1; i < threads; ++i) {
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+/**
+ * @brief Destructor of the ThreadPool class.
+ *
+ * Stops and joins all worker threads.
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+/**
+ * @brief Returns the pool shared by all range calculations.
+ *
+ * The pool is created on first use with one thread per hardware thread.
+ *
+ * @return The shared pool.
+ */
+ThreadPool& ThreadPool::Shared() {
+  static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u));
+  return pool;
+}
+
+/**
+ * @brief Returns the maximum number of threads running a loop.
+ *
+ * @return The number of worker threads plus the calling thread.
+ */
+std::size_t ThreadPool::Size() const { return workers_.size() + 1; }
+
+/**
+ * @brief Runs a task for every iteration of a loop and waits for all of them.
+ *
+ * The iterations are split into equal contiguous ranges, one per thread, and
+ * balanced by work stealing. Iterations run in an unspecified order, so the
+ * task must only write to data owned by its iteration. Loops submitted from
+ * several threads at once are run one after another. If some iterations
+ * throw, the remaining ones still run and the first exception is rethrown.
+ *
+ * @param count The number of iterations, less than 2^32.
+ * @param task The function called with the index of every iteration.
+ * @param threads The number of threads to use, or 0 to use the whole pool.
+ * @throws std::length_error if count does not fit into 32 bits.
+ */
+void ThreadPool::ParallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& task,
+                             std::size_t threads) {
+  if (static_cast<std::uint64_t>(count) > UINT32_MAX) {
+    throw std::length_error("Too many iterations for a parallel loop");
+  }
+  threads = threads == 0 ? Size() : std::min(threads, Size());
+  threads = std::min(threads, count);
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+  for (std::size_t i = 0; i < threads; ++i) {
+    queues_[i].range.store(Pack(count * i / threads, count * (i + 1) / threads),
+                           std::memory_order_relaxed);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    participants_ = threads;
+    running_ = threads - 1;
+    error_ = nullptr;
+    ++generation_;
+  }
+  start_.notify_all();
+
+  Participate(0);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    task_ = nullptr;
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Packs a range of iterations into a single word.
+ */
+std::uint64_t ThreadPool::Pack(std::uint64_t begin, std::uint64_t end) {
+  return begin << 32 | end;
+}
+
+/**
+ * @brief The main loop of a worker thread.
+ *
+ * Waits for a new loop and participates in it if the loop uses enough
+ * threads.
+ *
+ * @param index The index of the worker, starting from 1.
+ */
+void ThreadPool::WorkerLoop(std::size_t index) {
+  std::uint64_t generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    start_.wait(lock, [&] { return stop_ || generation_ != generation; });
+    if (stop_) {
+      return;
+    }
+    generation = generation_;
+    if (index >= participants_) {
+      continue;
+    }
+    lock.unlock();
+    Participate(index);
+    lock.lock();
+    if (--running_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+/**
+ * @brief Runs iterations of the current loop until none are left.
+ *
+ * @param index The index of the participating thread.
+ */
+void ThreadPool::Participate(std::size_t index) {
+  std::size_t item;
+  while (Pop(index, item) || Steal(index, item)) {
+    try {
+      (*task_)(item);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Takes the first iteration from the own range of a thread.
+ *
+ * @param index The index of the participating thread.
+ * @param item Receives the iteration.
+ * @return True if an iteration was taken, False if the range is empty.
+ */
+bool ThreadPool::Pop(std::size_t index, std::size_t& item) {
+  std::atomic<std::uint64_t>& range = queues_[index].range;
+  std::uint64_t current = range.load(std::memory_order_acquire);
+
+  while (true) {
+    std::uint64_t begin = current >> 32;
+    std::uint64_t end = current & UINT32_MAX;
+    if (begin >= end) {
+      return false;
+    }
+    if (range.compare_exchange_weak(current, Pack(begin + 1, end),
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      item = begin;
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Steals the second half of the range of another thread.
+ *
+ * The first stolen iteration is returned and the rest becomes the new range
+ * of the thief. Threads are visited starting from the next one, so thieves
+ * spread over different victims.
+ *
+ * @param index The index of the participating thread, whose range is empty.
+ * @param item Receives the first stolen iteration.
+ * @return True if an iteration was stolen, False if all ranges are empty.
+ */
+bool ThreadPool::Steal(std::size_t index, std::size_t& item) {
+  for (std::size_t i = 1; i < participants_; ++i) {
+    std::atomic<std::uint64_t>& range =
+        queues_[(index + i) % participants_].range;
+    std::uint64_t current = range.load(std::memory_order_acquire);
+
+    while (true) {
+      std::uint64_t begin = current >> 32;
+      std::uint64_t end = current & UINT32_MAX;
+      if (begin >= end) {
+        break;
+      }
+      std::uint64_t middle = begin + (end - begin) / 2;
+      if (range.compare_exchange_weak(current, Pack(begin, middle),
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+        queues_[index].range.store(Pack(middle + 1, end),
+                                   std::memory_order_release);
+        item = middle;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace s21
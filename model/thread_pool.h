@@ -0,0 +1,79 @@
+#ifndef SMARTCALC_MODEL_THREAD_POOL_H_
+#define SMARTCALC_MODEL_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class ThreadPool
+ * @brief A work-stealing pool of threads for data-parallel loops.
+ *
+ * ThreadPool runs the iterations of a loop on a fixed set of worker threads
+ * and the calling thread. The iterations are dealt out as contiguous ranges,
+ * one per participating thread; a thread that runs out of work steals half of
+ * the remaining range of another one, so uneven iterations are balanced
+ * without a central queue. The pool is created once and reused by every call,
+ * and a single loop may use any number of its threads.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  static ThreadPool& Shared();
+
+  std::size_t Size() const;
+  void ParallelFor(std::size_t count,
+                   const std::function<void(std::size_t)>& task,
+                   std::size_t threads = 0);
+
+ private:
+  /**
+   * @struct Queue
+   * @brief The range of iterations owned by a participating thread.
+   *
+   * The first and the past-the-end iteration are packed into a single atomic
+   * word, the first one in the upper half, so that the owner and the thieves
+   * can update the range with a single compare-and-swap. The structure is
+   * aligned to a cache line to avoid false sharing between threads.
+   */
+  struct alignas(64) Queue {
+    std::atomic<std::uint64_t> range{0};
+  };
+
+  static std::uint64_t Pack(std::uint64_t begin, std::uint64_t end);
+  void WorkerLoop(std::size_t index);
+  void Participate(std::size_t index);
+  bool Pop(std::size_t index, std::size_t& item);
+  bool Steal(std::size_t index, std::size_t& item);
+
+  std::vector<std::thread> workers_;
+  std::unique_ptr<Queue[]> queues_;
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  const std::function<void(std::size_t)>* task_ = nullptr;
+  std::size_t participants_ = 0;
+  std::size_t running_ = 0;
+  std::uint64_t generation_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_THREAD_POOL_H_
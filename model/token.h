@@ -1,7 +1,7 @@
 #ifndef SMARTCALC_MODEL_TOKEN_H_
 #define SMARTCALC_MODEL_TOKEN_H_
 
-#include <string>
+#include <string_view>
 
 namespace s21 {
 
@@ -22,18 +22,23 @@ enum class TokenType {
  * Token is used to encapsulate individual elements of a mathematical
  * expression, such as numbers, variables, operators, brackets, and functions.
  * It provides methods for querying the type, value, and priority of the token.
+ * A token refers to its text in the expression without copying it, so it is
+ * only valid as long as the expression, and numbers are decoded once when
+ * they are parsed.
  *
  * The class is designed to work in conjunction with the MathCalc class for
  * parsing, converting, and evaluating mathematical expressions.
  */
 class Token {
  public:
-  Token(TokenType type, const std::string& token, short priority = 0)
-      : type_(type), token_(token), priority_(priority) {}
+  Token(TokenType type, std::string_view token, short priority = 0,
+        double value = 0.0)
+      : type_(type), token_(token), priority_(priority), value_(value) {}
 
   TokenType GetType() const { return type_; }
-  const std::string& GetToken() const { return token_; }
+  std::string_view GetToken() const { return token_; }
   short GetPriority() const { return priority_; }
+  double GetValue() const { return value_; }
 
   bool IsNumber() const { return type_ == TokenType::kNumber; }
   bool IsVariable() const { return type_ == TokenType::kVariable; }
@@ -47,8 +52,9 @@ class Token {
 
  private:
   TokenType type_;
-  std::string token_;
+  std::string_view token_;
   short priority_;
+  double value_;
 };
 }  // namespace s21
 
@@ -0,0 +1,95 @@
+#include "variable_table.h"
+
+namespace s21 {
+
+/**
+ * @brief Constructs a table with the single variable "x".
+ */
+VariableTable::VariableTable() : names_{"x"} {}
+
+/**
+ * @brief Constructs a table with the given variables.
+ *
+ * @param names The names of the variables in the order of their slots.
+ * @throws std::logic_error if a name is invalid or repeated.
+ */
+VariableTable::VariableTable(std::initializer_list<std::string> names)
+    : VariableTable(std::vector<std::string>(names)) {}
+
+/**
+ * @brief Constructs a table with the given variables.
+ *
+ * @param names The names of the variables in the order of their slots.
+ * @throws std::logic_error if a name is invalid or repeated.
+ */
+VariableTable::VariableTable(const std::vector<std::string>& names) {
+  for (const std::string& name : names) {
+    Add(name);
+  }
+}
+
+/**
+ * @brief Adds a variable to the table.
+ *
+ * A name consists of letters and underscores and starts with a letter. It
+ * must differ from the names of functions and operators, which is checked
+ * when an expression is compiled.
+ *
+ * @param name The name of the variable.
+ * @return The slot of the new variable.
+ * @throws std::logic_error if the name is invalid or already in the table.
+ */
+std::size_t VariableTable::Add(const std::string& name) {
+  if (!ValidateName(name)) {
+    throw std::logic_error("Invalid variable name: " + name);
+  }
+  if (Find(name) != kNotFound) {
+    throw std::logic_error("Duplicate variable: " + name);
+  }
+  names_.push_back(name);
+  return names_.size() - 1;
+}
+
+/**
+ * @brief Looks up the slot of a variable.
+ *
+ * @param name The name of the variable.
+ * @return The slot of the variable, or kNotFound if it is not in the table.
+ */
+std::size_t VariableTable::Find(std::string_view name) const {
+  for (std::size_t slot = 0; slot < names_.size(); ++slot) {
+    if (names_[slot] == name) {
+      return slot;
+    }
+  }
+  return kNotFound;
+}
+
+/**
+ * @brief Returns the number of variables in the table.
+ */
+std::size_t VariableTable::GetSize() const { return names_.size(); }
+
+/**
+ * @brief Returns the names of the variables in the order of their slots.
+ */
+const std::vector<std::string>& VariableTable::GetNames() const {
+  return names_;
+}
+
+/**
+ * @brief Checks if a string is a syntactically valid variable name.
+ */
+bool VariableTable::ValidateName(const std::string& name) {
+  if (name.empty() || !std::isalpha(static_cast<unsigned char>(name[0]))) {
+    return false;
+  }
+  for (char ch : name) {
+    if (!std::isalpha(static_cast<unsigned char>(ch)) && ch != '_') {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace s21
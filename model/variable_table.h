@@ -0,0 +1,43 @@
+#ifndef SMARTCALC_MODEL_VARIABLE_TABLE_H_
+#define SMARTCALC_MODEL_VARIABLE_TABLE_H_
+
+#include <cctype>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace s21 {
+
+/**
+ * @class VariableTable
+ * @brief The variables that may appear in an expression.
+ *
+ * VariableTable assigns every variable name a slot index in the order in
+ * which the names were added. Expressions are compiled against a table, which
+ * resolves every variable to its slot once, so that evaluation reads the
+ * values of the variables from an array indexed by slot and never looks at
+ * their names. A default constructed table holds the single variable "x".
+ */
+class VariableTable {
+ public:
+  static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+  VariableTable();
+  VariableTable(std::initializer_list<std::string> names);
+  explicit VariableTable(const std::vector<std::string>& names);
+
+  std::size_t Add(const std::string& name);
+  std::size_t Find(std::string_view name) const;
+  std::size_t GetSize() const;
+  const std::vector<std::string>& GetNames() const;
+
+ private:
+  static bool ValidateName(const std::string& name);
+
+  std::vector<std::string> names_;
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_VARIABLE_TABLE_H_
@@ -0,0 +1,227 @@
+#include "vector_evaluator.h"
+
+namespace s21 {
+
+/**
+ * @brief Detects the widest instruction set supported by the processor.
+ *
+ * The result is computed on the first call and cached.
+ *
+ * @return The instruction set used by Evaluate by default.
+ */
+VectorEvaluator::Isa VectorEvaluator::DetectIsa() {
+  static const Isa isa = [] {
+    if (IsSupported(Isa::kAvx512)) {
+      return Isa::kAvx512;
+    }
+    if (IsSupported(Isa::kAvx2)) {
+      return Isa::kAvx2;
+    }
+    return Isa::kSse2;
+  }();
+  return isa;
+}
+
+/**
+ * @brief Checks if an instruction set can be used on this processor.
+ *
+ * On processors other than x86 only Isa::kSse2 is reported as supported, and
+ * it selects a portable implementation of the same algorithms.
+ *
+ * @param isa The instruction set to be checked.
+ * @return True if Evaluate can be called with the instruction set.
+ */
+bool VectorEvaluator::IsSupported(Isa isa) {
+#if defined(__x86_64__) || defined(__i386__)
+  switch (isa) {
+    case Isa::kSse2:
+      return true;
+    case Isa::kAvx2:
+      return __builtin_cpu_supports("avx2");
+    case Isa::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  return isa == Isa::kSse2;
+#endif
+}
+
+/**
+ * @brief Executes a Program for an array of values of the variable using the
+ * widest supported instruction set.
+ *
+ * @param program A valid compiled expression with at most one variable.
+ * @param x The values of the variable.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of values.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program, const double* x,
+                               double* y, std::size_t size) {
+  Evaluate(program, x, y, size, DetectIsa());
+}
+
+/**
+ * @brief Executes a Program for an array of values of the variable using the
+ * given instruction set.
+ *
+ * @param program A valid compiled expression with at most one variable.
+ * @param x The values of the variable.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of values.
+ * @param isa An instruction set for which IsSupported returns True.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program, const double* x,
+                               double* y, std::size_t size, Isa isa) {
+  if (program.variables > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  Execute(program, &x, 1, y, size, isa);
+}
+
+/**
+ * @brief Executes a Program for columns of values of its variables using the
+ * widest supported instruction set.
+ *
+ * @param program A valid compiled expression.
+ * @param columns One column of size values per variable of the Program, in
+ * the order of their slots.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of rows.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program,
+                               const double* const* columns, double* y,
+                               std::size_t size) {
+  Evaluate(program, columns, y, size, DetectIsa());
+}
+
+/**
+ * @brief Executes a Program for columns of values of its variables using the
+ * given instruction set.
+ *
+ * The values of a variable are read from a single contiguous column, so every
+ * block of rows is loaded with plain vector loads.
+ *
+ * @param program A valid compiled expression.
+ * @param columns One column of size values per variable of the Program, in
+ * the order of their slots.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of rows.
+ * @param isa An instruction set for which IsSupported returns True.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program,
+                               const double* const* columns, double* y,
+                               std::size_t size, Isa isa) {
+  Execute(program, columns, program.variables, y, size, isa);
+}
+
+/**
+ * @brief Executes a Program for an array of values of the variable in single
+ * precision using the widest supported instruction set.
+ *
+ * @param program A valid compiled expression with at most one variable.
+ * @param x The values of the variable.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of values.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program, const float* x,
+                               float* y, std::size_t size) {
+  Evaluate(program, x, y, size, DetectIsa());
+}
+
+/**
+ * @brief Executes a Program for an array of values of the variable in single
+ * precision using the given instruction set.
+ *
+ * The constants of the Program are rounded to float, so the results are those
+ * of the expression with every value and operation in single precision.
+ *
+ * @param program A valid compiled expression with at most one variable.
+ * @param x The values of the variable.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of values.
+ * @param isa An instruction set for which IsSupported returns True.
+ * @throws std::logic_error if the expression has more than one variable.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program, const float* x,
+                               float* y, std::size_t size, Isa isa) {
+  if (program.variables > 1) {
+    throw std::logic_error("Expression has more than one variable");
+  }
+  Execute(program, &x, 1, y, size, isa);
+}
+
+/**
+ * @brief Executes a Program for columns of values of its variables in single
+ * precision using the widest supported instruction set.
+ *
+ * @param program A valid compiled expression.
+ * @param columns One column of size values per variable of the Program, in
+ * the order of their slots.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of rows.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program,
+                               const float* const* columns, float* y,
+                               std::size_t size) {
+  Evaluate(program, columns, y, size, DetectIsa());
+}
+
+/**
+ * @brief Executes a Program for columns of values of its variables in single
+ * precision using the given instruction set.
+ *
+ * @param program A valid compiled expression.
+ * @param columns One column of size values per variable of the Program, in
+ * the order of their slots.
+ * @param y The output buffer, which receives size results.
+ * @param size The number of rows.
+ * @param isa An instruction set for which IsSupported returns True.
+ */
+void VectorEvaluator::Evaluate(const ProgramView& program,
+                               const float* const* columns, float* y,
+                               std::size_t size, Isa isa) {
+  Execute(program, columns, program.variables, y, size, isa);
+}
+
+/**
+ * @brief Runs the kernel of an instruction set on a scratch buffer for the
+ * variables and the operand stack.
+ *
+ * The scratch buffer belongs to the calling thread and only grows, so
+ * concurrent evaluations never share it and repeated ones do not allocate.
+ */
+template <class T>
+void VectorEvaluator::Execute(const ProgramView& program,
+                              const T* const* columns, std::size_t variables,
+                              T* y, std::size_t size, Isa isa) {
+  if (size == 0) {
+    return;
+  }
+
+  thread_local std::vector<Block> scratch;
+  std::size_t blocks = (variables + program.depth) * kBlocksPerOperand;
+  if (scratch.size() < blocks) {
+    scratch.resize(blocks);
+  }
+  const Instruction* code = program.code;
+  std::size_t length = program.length;
+
+  switch (isa) {
+    case Isa::kSse2:
+      EvaluateSse2(code, length, columns, variables, y, size, scratch.data());
+      break;
+    case Isa::kAvx2:
+      EvaluateAvx2(code, length, columns, variables, y, size, scratch.data());
+      break;
+    case Isa::kAvx512:
+      EvaluateAvx512(code, length, columns, variables, y, size,
+                     scratch.data());
+      break;
+  }
+}
+
+}  // namespace s21
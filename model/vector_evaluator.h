@@ -0,0 +1,92 @@
+#ifndef SMARTCALC_MODEL_VECTOR_EVALUATOR_H_
+#define SMARTCALC_MODEL_VECTOR_EVALUATOR_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "program.h"
+
+namespace s21 {
+
+/**
+ * @class VectorEvaluator
+ * @brief A class for evaluating compiled expressions on many values at once.
+ *
+ * VectorEvaluator executes a Program for an array of values of the variable,
+ * or for columns of values of several variables, using the widest vector
+ * instruction set supported by the processor. The
+ * instruction set is detected once at run time, so a single binary runs on
+ * any x86-64 processor and uses AVX2 or AVX-512 where available. The results
+ * are identical for every instruction set and do not depend on the position
+ * of a value in the input; their accuracy is documented in VectorMath.
+ *
+ * The float overloads run the same algorithms on vectors of floats, which
+ * hold twice as many lanes, for callers that can trade precision for speed.
+ */
+class VectorEvaluator {
+ public:
+  enum class Isa { kSse2, kAvx2, kAvx512 };
+
+  static Isa DetectIsa();
+  static bool IsSupported(Isa isa);
+  static void Evaluate(const ProgramView& program, const double* x, double* y,
+                       std::size_t size);
+  static void Evaluate(const ProgramView& program, const double* x, double* y,
+                       std::size_t size, Isa isa);
+  static void Evaluate(const ProgramView& program, const double* const* columns,
+                       double* y, std::size_t size);
+  static void Evaluate(const ProgramView& program, const double* const* columns,
+                       double* y, std::size_t size, Isa isa);
+  static void Evaluate(const ProgramView& program, const float* x, float* y,
+                       std::size_t size);
+  static void Evaluate(const ProgramView& program, const float* x, float* y,
+                       std::size_t size, Isa isa);
+  static void Evaluate(const ProgramView& program, const float* const* columns,
+                       float* y, std::size_t size);
+  static void Evaluate(const ProgramView& program, const float* const* columns,
+                       float* y, std::size_t size, Isa isa);
+
+ private:
+  /**
+   * @struct Block
+   * @brief A unit of the scratch buffer aligned for the widest vector type.
+   */
+  struct alignas(64) Block {
+    double values[8];
+  };
+
+  static constexpr std::size_t kBlocksPerOperand = 4;
+
+  template <class T>
+  static void Execute(const ProgramView& program, const T* const* columns,
+                      std::size_t variables, T* y, std::size_t size, Isa isa);
+
+  static void EvaluateSse2(const Instruction* code, std::size_t length,
+                           const double* const* columns,
+                           std::size_t variables, double* y,
+                           std::size_t size, void* scratch);
+  static void EvaluateSse2(const Instruction* code, std::size_t length,
+                           const float* const* columns,
+                           std::size_t variables, float* y,
+                           std::size_t size, void* scratch);
+  static void EvaluateAvx2(const Instruction* code, std::size_t length,
+                           const double* const* columns,
+                           std::size_t variables, double* y,
+                           std::size_t size, void* scratch);
+  static void EvaluateAvx2(const Instruction* code, std::size_t length,
+                           const float* const* columns,
+                           std::size_t variables, float* y,
+                           std::size_t size, void* scratch);
+  static void EvaluateAvx512(const Instruction* code, std::size_t length,
+                             const double* const* columns,
+                             std::size_t variables, double* y,
+                             std::size_t size, void* scratch);
+  static void EvaluateAvx512(const Instruction* code, std::size_t length,
+                             const float* const* columns,
+                             std::size_t variables, float* y,
+                             std::size_t size, void* scratch);
+};
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_VECTOR_EVALUATOR_H_
@@ -0,0 +1,31 @@
+#include "vector_evaluator.h"
+#include "vector_kernel.h"
+
+namespace s21 {
+
+/**
+ * @brief Executes a Program with AVX2 vectors.
+ *
+ * This translation unit is compiled with -mavx2 on x86 and must only be
+ * called after checking VectorEvaluator::IsSupported.
+ */
+void VectorEvaluator::EvaluateAvx2(const Instruction* code, std::size_t length,
+                                   const double* const* columns,
+                                   std::size_t variables, double* y,
+                                   std::size_t size, void* scratch) {
+  VectorKernel<Double4>::Execute(code, length, columns, variables, y, size,
+                                 scratch);
+}
+
+/**
+ * @brief Executes a Program with single precision AVX2 vectors.
+ */
+void VectorEvaluator::EvaluateAvx2(const Instruction* code, std::size_t length,
+                                   const float* const* columns,
+                                   std::size_t variables, float* y,
+                                   std::size_t size, void* scratch) {
+  VectorKernel<Float8>::Execute(code, length, columns, variables, y, size,
+                                scratch);
+}
+
+}  // namespace s21
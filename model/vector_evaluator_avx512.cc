@@ -0,0 +1,33 @@
+#include "vector_evaluator.h"
+#include "vector_kernel.h"
+
+namespace s21 {
+
+/**
+ * @brief Executes a Program with AVX-512 vectors.
+ *
+ * This translation unit is compiled with -mavx512f on x86 and must only be
+ * called after checking VectorEvaluator::IsSupported.
+ */
+void VectorEvaluator::EvaluateAvx512(const Instruction* code,
+                                     std::size_t length,
+                                     const double* const* columns,
+                                     std::size_t variables, double* y,
+                                     std::size_t size, void* scratch) {
+  VectorKernel<Double8>::Execute(code, length, columns, variables, y, size,
+                                 scratch);
+}
+
+/**
+ * @brief Executes a Program with single precision AVX-512 vectors.
+ */
+void VectorEvaluator::EvaluateAvx512(const Instruction* code,
+                                     std::size_t length,
+                                     const float* const* columns,
+                                     std::size_t variables, float* y,
+                                     std::size_t size, void* scratch) {
+  VectorKernel<Float16>::Execute(code, length, columns, variables, y, size,
+                                 scratch);
+}
+
+}  // namespace s21
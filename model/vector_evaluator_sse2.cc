@@ -0,0 +1,32 @@
+#include "vector_evaluator.h"
+#include "vector_kernel.h"
+
+namespace s21 {
+
+/**
+ * @brief Executes a Program with SSE2 vectors.
+ *
+ * SSE2 is part of every x86-64 processor, and on other processors the
+ * vector extensions of the compiler map this type to the native vector unit
+ * or to scalar code.
+ */
+void VectorEvaluator::EvaluateSse2(const Instruction* code, std::size_t length,
+                                   const double* const* columns,
+                                   std::size_t variables, double* y,
+                                   std::size_t size, void* scratch) {
+  VectorKernel<Double2>::Execute(code, length, columns, variables, y, size,
+                                 scratch);
+}
+
+/**
+ * @brief Executes a Program with single precision SSE2 vectors.
+ */
+void VectorEvaluator::EvaluateSse2(const Instruction* code, std::size_t length,
+                                   const float* const* columns,
+                                   std::size_t variables, float* y,
+                                   std::size_t size, void* scratch) {
+  VectorKernel<Float4>::Execute(code, length, columns, variables, y, size,
+                                scratch);
+}
+
+}  // namespace s21
@@ -0,0 +1,272 @@
+#ifndef SMARTCALC_MODEL_VECTOR_KERNEL_H_
+#define SMARTCALC_MODEL_VECTOR_KERNEL_H_
+
+#include "program.h"
+#include "vector_math.h"
+
+namespace s21 {
+
+/**
+ * @class VectorKernel
+ * @brief Block interpreter for compiled expressions.
+ *
+ * VectorKernel executes a Program on blocks of kBlock rows of the variables
+ * at once. Every operand on the stack is a group of kWidth vectors of type V,
+ * so the cost of decoding an instruction is shared by the whole block and the
+ * independent vectors of a group keep the pipelines busy. The template is
+ * instantiated once per instruction set in its own translation unit and only
+ * works on raw pointers, so no code compiled for a wider instruction set can
+ * leak into the rest of the program. For this guarantee the kernel must only
+ * call members of templates instantiated for V and functions of the C
+ * library, not inline functions shared with other translation units, whose
+ * copy from any translation unit may be kept by the linker.
+ */
+template <class V>
+class VectorKernel {
+ public:
+  using Math = VectorMath<V>;
+  using Scalar = typename Math::Scalar;
+
+  static constexpr std::size_t kWidth = 4;
+  static constexpr std::size_t kBlock = Math::kLanes * kWidth;
+
+  static void Execute(const Instruction* code, std::size_t length,
+                      const Scalar* const* columns, std::size_t variables,
+                      Scalar* y, std::size_t size, void* scratch);
+
+ private:
+  static void ExecuteBlock(const Instruction* code, std::size_t length,
+                           const V* input, V* y, V* stack);
+  static bool IsBinary(OpCode op);
+};
+
+/**
+ * @brief Executes a Program for every row of the variable columns.
+ *
+ * For every block the values of all variables are gathered into a group of
+ * vectors per slot. The last incomplete block is padded with the last row,
+ * so every row is computed by the same vector code regardless of its position
+ * in the input.
+ *
+ * @param code The instructions of a valid Program.
+ * @param length The number of instructions.
+ * @param columns The values of the variables, one column of size values per
+ * slot.
+ * @param variables The number of columns.
+ * @param y The output buffer for size results.
+ * @param size The number of rows.
+ * @param scratch A buffer for (variables + depth) * kWidth vectors aligned to
+ * sizeof(V).
+ */
+template <class V>
+void VectorKernel<V>::Execute(const Instruction* code, std::size_t length,
+                              const Scalar* const* columns,
+                              std::size_t variables, Scalar* y,
+                              std::size_t size, void* scratch) {
+  V* input = static_cast<V*>(scratch);
+  V* stack = input + variables * kWidth;
+  V output[kWidth];
+  std::size_t i = 0;
+
+  for (; i + kBlock <= size; i += kBlock) {
+    for (std::size_t slot = 0; slot < variables; ++slot) {
+      __builtin_memcpy(input + slot * kWidth, columns[slot] + i,
+                       kBlock * sizeof(Scalar));
+    }
+    ExecuteBlock(code, length, input, output, stack);
+    __builtin_memcpy(y + i, output, sizeof(output));
+  }
+
+  if (i < size) {
+    for (std::size_t slot = 0; slot < variables; ++slot) {
+      Scalar* padded = reinterpret_cast<Scalar*>(input + slot * kWidth);
+      for (std::size_t j = 0; j < kBlock; ++j) {
+        padded[j] = columns[slot][i + j < size ? i + j : size - 1];
+      }
+    }
+    ExecuteBlock(code, length, input, output, stack);
+    __builtin_memcpy(y + i, output, (size - i) * sizeof(Scalar));
+  }
+}
+
+/**
+ * @brief Executes a Program for a single block of values.
+ */
+template <class V>
+void VectorKernel<V>::ExecuteBlock(const Instruction* code, std::size_t length,
+                                   const V* input, V* y, V* stack) {
+  V* top = stack;
+
+  for (const Instruction* instruction = code; instruction != code + length;
+       ++instruction) {
+    OpCode op = instruction->op;
+
+    if (op == OpCode::kNumber) {
+      V value = Math::Broadcast(instruction->value);
+      for (std::size_t j = 0; j < kWidth; ++j) {
+        top[j] = value;
+      }
+      top += kWidth;
+    } else if (op == OpCode::kVariable) {
+      const V* column =
+          input + static_cast<std::size_t>(instruction->value) * kWidth;
+      for (std::size_t j = 0; j < kWidth; ++j) {
+        top[j] = column[j];
+      }
+      top += kWidth;
+    } else if (op == OpCode::kLoad) {
+      const V* temporary =
+          stack + static_cast<std::size_t>(instruction->value) * kWidth;
+      for (std::size_t j = 0; j < kWidth; ++j) {
+        top[j] = temporary[j];
+      }
+      top += kWidth;
+    } else if (IsBinary(op)) {
+      top -= kWidth;
+      V* lhs = top - kWidth;
+      const V* rhs = top;
+      switch (op) {
+        case OpCode::kAdd:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] += rhs[j];
+          }
+          break;
+        case OpCode::kSub:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] -= rhs[j];
+          }
+          break;
+        case OpCode::kMul:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] *= rhs[j];
+          }
+          break;
+        case OpCode::kDiv:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] /= rhs[j];
+          }
+          break;
+        case OpCode::kPow:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] = Math::Pow(lhs[j], rhs[j]);
+          }
+          break;
+        case OpCode::kMod:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            lhs[j] = Math::Mod(lhs[j], rhs[j]);
+          }
+          break;
+        default:
+          break;
+      }
+    } else {
+      V* operand = top - kWidth;
+      switch (op) {
+        case OpCode::kNegate:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = -operand[j];
+          }
+          break;
+        case OpCode::kPowInt: {
+          long exponent = static_cast<long>(instruction->value);
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::PowInt(operand[j], exponent);
+          }
+          break;
+        }
+        case OpCode::kPolynomial: {
+          std::size_t degree = static_cast<std::size_t>(instruction->value);
+          V x[kWidth];
+          V leading = Math::Broadcast(instruction[1].value);
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            x[j] = operand[j];
+            operand[j] = leading;
+          }
+          for (std::size_t k = 2; k <= degree + 1; ++k) {
+            V coefficient = Math::Broadcast(instruction[k].value);
+            for (std::size_t j = 0; j < kWidth; ++j) {
+              operand[j] = operand[j] * x[j] + coefficient;
+            }
+          }
+          instruction += degree + 1;
+          break;
+        }
+        case OpCode::kSin:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Sin(operand[j]);
+          }
+          break;
+        case OpCode::kCos:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Cos(operand[j]);
+          }
+          break;
+        case OpCode::kTan:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Tan(operand[j]);
+          }
+          break;
+        case OpCode::kAsin:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Asin(operand[j]);
+          }
+          break;
+        case OpCode::kAcos:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Acos(operand[j]);
+          }
+          break;
+        case OpCode::kAtan:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Atan(operand[j]);
+          }
+          break;
+        case OpCode::kSqrt:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Sqrt(operand[j]);
+          }
+          break;
+        case OpCode::kLn:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Ln(operand[j]);
+          }
+          break;
+        case OpCode::kLog:
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            operand[j] = Math::Log(operand[j]);
+          }
+          break;
+        case OpCode::kStore: {
+          V* temporary =
+              stack + static_cast<std::size_t>(instruction->value) * kWidth;
+          for (std::size_t j = 0; j < kWidth; ++j) {
+            temporary[j] = operand[j];
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+  }
+
+  for (std::size_t j = 0; j < kWidth; ++j) {
+    y[j] = stack[j];
+  }
+}
+
+/**
+ * @brief Checks if an opcode takes two operands from the stack.
+ *
+ * This is s21::IsBinary, repeated as a member of the kernel so that it is
+ * compiled separately for every instruction set.
+ */
+template <class V>
+bool VectorKernel<V>::IsBinary(OpCode op) {
+  return op == OpCode::kAdd || op == OpCode::kSub || op == OpCode::kMul ||
+         op == OpCode::kDiv || op == OpCode::kPow || op == OpCode::kMod;
+}
+
+}  // namespace s21
+
+#endif  // SMARTCALC_MODEL_VECTOR_KERNEL_H_
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "adaptive_sampler.h"
+#include "math_calc.h"
+
+using namespace s21;
+
+namespace {
+AdaptiveSampler::Result Sample(const std::string& expression,
+                               AdaptiveSampler::Options options = {}) {
+  return AdaptiveSampler::Sample(MathCalc::Compile(expression), options);
+}
+
+std::size_t CountPoints(const AdaptiveSampler::Result& result) {
+  std::size_t points = 0;
+  for (const AdaptiveSampler::Series& series : result.series) {
+    EXPECT_EQ(series.x.size(), series.y.size());
+    EXPECT_TRUE(std::is_sorted(series.x.begin(), series.x.end()));
+    points += series.x.size();
+  }
+  return points;
+}
+}  // namespace
+
+TEST(AdaptiveSamplerTest, Line) {
+  AdaptiveSampler::Result result = Sample("2x + 1");
+  ASSERT_EQ(result.series.size(), 1);
+  EXPECT_EQ(result.evaluations, 2 * 128 + 1);
+  EXPECT_EQ(CountPoints(result), result.evaluations);
+  const AdaptiveSampler::Series& series = result.series.front();
+  EXPECT_DOUBLE_EQ(series.x.front(), -10.0);
+  EXPECT_DOUBLE_EQ(series.x.back(), 10.0);
+  for (std::size_t i = 0; i < series.x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(series.y[i], 2 * series.x[i] + 1);
+  }
+}
+
+TEST(AdaptiveSamplerTest, Curvature) {
+  AdaptiveSampler::Options options;
+  AdaptiveSampler::Result result = Sample("sin(x) + x ^ 2 / 20", options);
+  ASSERT_EQ(result.series.size(), 1);
+  EXPECT_LT(result.evaluations, options.budget / 4);
+
+  const AdaptiveSampler::Series& series = result.series.front();
+  double scale_x = options.width / (options.x_max - options.x_min);
+  double scale_y = options.height / (options.y_max - options.y_min);
+  for (std::size_t i = 0; i + 1 < series.x.size(); ++i) {
+    for (double t : {0.25, 0.5, 0.75}) {
+      double x = series.x[i] + t * (series.x[i + 1] - series.x[i]);
+      double chord = series.y[i] + t * (series.y[i + 1] - series.y[i]);
+      double error = std::abs(sin(x) + x * x / 20 - chord) * scale_y;
+      ASSERT_LT(error, 2 * options.tolerance) << "x = " << x;
+    }
+    EXPECT_GT((series.x[i + 1] - series.x[i]) * scale_x, options.resolution);
+  }
+}
+
+TEST(AdaptiveSamplerTest, Asymptotes) {
+  AdaptiveSampler::Result result = Sample("tan(x)");
+  ASSERT_EQ(result.series.size(), 7);
+  for (std::size_t i = 0; i < result.series.size(); ++i) {
+    const AdaptiveSampler::Series& series = result.series[i];
+    if (i > 0) {
+      EXPECT_LT(series.y.front(), -10.0);
+    }
+    if (i + 1 < result.series.size()) {
+      EXPECT_GT(series.y.back(), 10.0);
+      double pole = (static_cast<double>(i) - 2.5) * M_PI;
+      EXPECT_NEAR(series.x.back(), pole, 1e-3);
+    }
+  }
+}
+
+TEST(AdaptiveSamplerTest, Jumps) {
+  AdaptiveSampler::Options options;
+  options.x_min = -0.5;
+  options.x_max = 3.5;
+  AdaptiveSampler::Result result = Sample("x mod 1", options);
+  ASSERT_EQ(result.series.size(), 4);
+  for (std::size_t i = 1; i < result.series.size(); ++i) {
+    EXPECT_NEAR(result.series[i].x.front(), static_cast<double>(i), 1e-3);
+    EXPECT_NEAR(result.series[i - 1].y.back(), 1.0, 1e-2);
+  }
+}
+
+TEST(AdaptiveSamplerTest, Undefined) {
+  AdaptiveSampler::Result result = Sample("sqrt(x) + sqrt(4 - x)");
+  ASSERT_EQ(result.series.size(), 1);
+  EXPECT_NEAR(result.series.front().x.front(), 0.0, 1e-3);
+  EXPECT_NEAR(result.series.front().x.back(), 4.0, 1e-3);
+
+  result = Sample("ln(x - 20)");
+  EXPECT_TRUE(result.series.empty());
+  EXPECT_EQ(result.evaluations, 2 * 128 + 1);
+}
+
+TEST(AdaptiveSamplerTest, Culling) {
+  AdaptiveSampler::Options options;
+  options.x_min = -1000.0;
+  options.x_max = 1000.0;
+  AdaptiveSampler::Result culled = Sample("sqrt(sin(x)) + 20", options);
+  EXPECT_EQ(culled.evaluations, 2 * 128 + 1);
+
+  options.cull = false;
+  AdaptiveSampler::Result plain = Sample("sqrt(sin(x)) + 20", options);
+  EXPECT_GT(plain.evaluations, 10 * culled.evaluations);
+
+  options.x_min = -2.0;
+  options.x_max = 2.0;
+  AdaptiveSampler::Result visible = Sample("sqrt(x + 3) + 5", options);
+  AdaptiveSampler::Result undefined = Sample("sqrt(x) + 5", options);
+  options.cull = true;
+  EXPECT_EQ(Sample("sqrt(x + 3) + 5", options).evaluations,
+            visible.evaluations);
+  EXPECT_LT(Sample("sqrt(x) + 5", options).evaluations,
+            undefined.evaluations);
+}
+
+TEST(AdaptiveSamplerTest, NarrowDip) {
+  // All samples of the initial grid are above the view, except in the dip
+  // to y = 5 at x = 0.04, whose width is about 0.02.
+  AdaptiveSampler::Options options;
+  for (bool cull : {true, false}) {
+    options.cull = cull;
+    AdaptiveSampler::Result result =
+        Sample("20 - 15 / (1 + 10000 * (x - 0.04) ^ 2)", options);
+    ASSERT_EQ(result.series.size(), 1) << cull;
+    const AdaptiveSampler::Series& series = result.series.front();
+    EXPECT_LT(*std::min_element(series.y.begin(), series.y.end()), 5.1)
+        << cull;
+    EXPECT_LE(result.evaluations, options.budget);
+  }
+
+  options.cull = true;
+  EXPECT_EQ(Sample("20 + x ^ 2", options).evaluations, 2 * 128 + 1);
+}
+
+TEST(AdaptiveSamplerTest, Budget) {
+  AdaptiveSampler::Options options;
+  options.x_min = -1.0;
+  options.x_max = 1.0;
+  options.y_min = -1.5;
+  options.y_max = 1.5;
+  for (std::size_t budget : {1, 3, 100, 1000, 5000}) {
+    options.budget = budget;
+    AdaptiveSampler::Result result = Sample("sin(1 / x)", options);
+    EXPECT_LE(result.evaluations, std::max<std::size_t>(budget, 3));
+    EXPECT_LE(CountPoints(result), result.evaluations);
+  }
+
+  options.x_max = -2.0;
+  EXPECT_THROW(Sample("x", options), std::logic_error);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "batch_evaluator.h"
+
+using namespace s21;
+
+namespace {
+std::vector<std::string> Lines(const std::string& text) {
+  std::vector<std::string> lines;
+  std::stringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+}  // namespace
+
+TEST(BatchEvaluatorTest, Records) {
+  std::stringstream input(
+      "1 + 2\n"
+      "x ^ 2,3\n"
+      "x ^ 2,-0.5\r\n"
+      "2 & 3\n"
+      "x ^ 2,abc\n"
+      "sqrt(x), 16 \n"
+      "x,1,2\n"
+      "\n"
+      "ln(x),0\n");
+  std::stringstream output;
+  BatchEvaluator::Options options;
+  options.threads = 2;
+  options.batch_size = 2;
+  BatchEvaluator::Statistics statistics =
+      BatchEvaluator(options).Run(input, output);
+
+  std::vector<std::string> lines = Lines(output.str());
+  ASSERT_EQ(lines.size(), 9);
+  EXPECT_EQ(lines[0], "3");
+  EXPECT_EQ(lines[1], "9");
+  EXPECT_EQ(lines[2], "0.25");
+  EXPECT_EQ(lines[3], "error: Invalid character: &");
+  EXPECT_EQ(lines[4], "error: Invalid variable values");
+  EXPECT_EQ(lines[5], "4");
+  EXPECT_EQ(lines[6], "error: Invalid variable values");
+  EXPECT_EQ(lines[7].rfind("error: ", 0), 0);
+  EXPECT_EQ(lines[8], "-inf");
+  EXPECT_EQ(statistics.records, 9);
+  EXPECT_EQ(statistics.errors, 4);
+}
+
+TEST(BatchEvaluatorTest, Variables) {
+  std::stringstream input(
+      "p * (1 + r) ^ t;100;0.1;2\n"
+      "p - t;5;0;3\n"
+      "p * q;1;2;3\n");
+  std::stringstream output;
+  BatchEvaluator::Options options;
+  options.variables = {"p", "r", "t"};
+  options.separator = ';';
+  BatchEvaluator(options).Run(input, output);
+
+  std::vector<std::string> lines = Lines(output.str());
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_DOUBLE_EQ(std::stod(lines[0]), 100 * 1.1 * 1.1);
+  EXPECT_EQ(lines[1], "2");
+  EXPECT_EQ(lines[2], "error: Invalid token: q");
+}
+
+TEST(BatchEvaluatorTest, Spaces) {
+  std::stringstream input(
+      "x * y,3 ,4\n"
+      "x * y, 3 , 4\n"
+      "x - y,\t3\t,\t4\t\n");
+  std::stringstream output;
+  BatchEvaluator::Options options;
+  options.variables = {"x", "y"};
+  BatchEvaluator(options).Run(input, output);
+
+  std::vector<std::string> lines = Lines(output.str());
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], "12");
+  EXPECT_EQ(lines[1], "12");
+  EXPECT_EQ(lines[2], "-1");
+}
+
+TEST(BatchEvaluatorTest, Order) {
+  std::string text;
+  std::vector<double> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::string expression =
+        i % 3 ? "sin(x) * x" : "x / 7 + " + std::to_string(i % 11);
+    std::string value = std::to_string(i * 0.37 - 1000);
+    text += expression + "," + value + "\n";
+    expected.push_back(MathCalc::Calculate(expression, std::stod(value)));
+  }
+
+  for (std::size_t threads : {1, 3}) {
+    std::stringstream input(text);
+    std::stringstream output;
+    BatchEvaluator::Options options;
+    options.threads = threads;
+    options.batch_size = 333;
+    BatchEvaluator::Statistics statistics =
+        BatchEvaluator(options).Run(input, output);
+
+    EXPECT_EQ(statistics.records, expected.size());
+    EXPECT_EQ(statistics.errors, 0);
+    std::vector<std::string> lines = Lines(output.str());
+    ASSERT_EQ(lines.size(), expected.size());
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+      ASSERT_NEAR(std::stod(lines[i]), expected[i],
+                  std::abs(expected[i]) * 1e-14)
+          << i;
+    }
+  }
+}
+
+TEST(BatchEvaluatorTest, Empty) {
+  std::stringstream input;
+  std::stringstream output;
+  BatchEvaluator::Statistics statistics = BatchEvaluator().Run(input, output);
+  EXPECT_EQ(output.str(), "");
+  EXPECT_EQ(statistics.records, 0);
+}
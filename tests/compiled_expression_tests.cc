@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "compiled_expression.h"
+
+using namespace s21;
+
+TEST(CompiledExpressionTest, Create) {
+  auto expression = CompiledExpression::Create("2xcos(3x) + -x ^ 2 mod 7");
+  EXPECT_EQ(expression->GetExpression(), "2xcos(3x) + -x ^ 2 mod 7");
+  EXPECT_EQ(expression->GetVariables(), std::vector<std::string>{"x"});
+  for (double x : {-3.5, 0.0, 0.25, 25.0}) {
+    EXPECT_EQ(expression->Calculate(x),
+              MathCalc::Calculate(expression->GetProgram(), x));
+  }
+
+  auto [x, y] = expression->Calculate(-2.0, 3.0, 11);
+  auto [x_single, y_single] =
+      expression->Calculate(-2.0, 3.0, 11, MathCalc::Precision::kSingle);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(y[i], expression->Calculate(x[i]), 1e-12);
+    EXPECT_NEAR(y_single[i], y[i], 1e-4);
+  }
+
+  auto sum = CompiledExpression::Create("a + 2b", VariableTable{"a", "b"});
+  EXPECT_DOUBLE_EQ(sum->Calculate({1.0, 2.0}), 5.0);
+  std::vector<double> a = {1.0, 2.0, 3.0}, b = {0.5, 0.25, 0.0};
+  const double* columns[] = {a.data(), b.data()};
+  std::vector<double> result(3);
+  sum->Calculate(columns, result.data(), result.size());
+  EXPECT_EQ(result, (std::vector<double>{2.0, 2.5, 3.0}));
+
+  EXPECT_THROW(CompiledExpression::Create("2 +"), std::logic_error);
+  Error error;
+  EXPECT_EQ(CompiledExpression::Create("2 +", error), nullptr);
+  EXPECT_EQ(error.code, ErrorCode::kMissingOperand);
+  EXPECT_NE(CompiledExpression::Create("2 + x", error), nullptr);
+  EXPECT_TRUE(error.IsOk());
+}
+
+TEST(CompiledExpressionTest, SharedBetweenThreads) {
+  auto shallow = CompiledExpression::Create("sin(x) * x + 1");
+  auto deep = CompiledExpression::Create(
+      "((((x + 1) * (x + 2) + 3) * (x + 4) + 5) * (x + 6) + 7) / (x + 8)");
+  std::vector<double> expected_shallow, expected_deep;
+  for (int i = 0; i < 1000; ++i) {
+    expected_shallow.push_back(shallow->Calculate(i * 0.01));
+    expected_deep.push_back(deep->Calculate(i * 0.01));
+  }
+  auto [x, expected_range] = deep->Calculate(-1.0, 1.0, 5000);
+
+  std::vector<std::thread> workers;
+  std::vector<int> failures(8);
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    workers.emplace_back([&, t] {
+      for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+          failures[t] += shallow->Calculate(i * 0.01) != expected_shallow[i];
+          failures[t] += deep->Calculate(i * 0.01) != expected_deep[i];
+        }
+        failures[t] += deep->Calculate(-1.0, 1.0, 5000).second !=
+                       expected_range;
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (int failure : failures) {
+    EXPECT_EQ(failure, 0);
+  }
+}
+
+TEST(CompiledExpressionTest, MathCalcIsReentrant) {
+  const MathCalc calc("sqrt(x) + ln(x + 1)");
+  double expected = calc.Calculate(2.0);
+  std::vector<std::thread> workers;
+  std::vector<int> failures(4);
+  for (std::size_t t = 0; t < failures.size(); ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < 10000; ++i) {
+        failures[t] += calc.Calculate(2.0) != expected;
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (int failure : failures) {
+    EXPECT_EQ(failure, 0);
+  }
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "credit_portfolio.h"
+
+using namespace s21;
+
+namespace {
+/**
+ * @brief Columns of a random portfolio of both credit types.
+ */
+struct Portfolio {
+  std::vector<double> sums;
+  std::vector<double> rates;
+  std::vector<int> terms;
+  std::vector<CreditCalc::CreditType> types;
+
+  explicit Portfolio(std::size_t size) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> sum(1000.0, 5000000.0);
+    std::uniform_real_distribution<double> rate(0.1, 30.0);
+    std::uniform_int_distribution<int> term(1, 360);
+    std::bernoulli_distribution differentiated(0.3);
+    for (std::size_t i = 0; i < size; ++i) {
+      sums.push_back(std::round(sum(generator) * 100.0) / 100.0);
+      rates.push_back(std::round(rate(generator) * 100.0) / 100.0);
+      terms.push_back(term(generator));
+      types.push_back(differentiated(generator)
+                          ? CreditCalc::CreditType::kDifferentiated
+                          : CreditCalc::CreditType::kAnnuity);
+    }
+  }
+
+  CreditPortfolio::Loans GetLoans() const {
+    return {sums.data(), rates.data(), terms.data(), types.data(),
+            sums.size()};
+  }
+
+  CreditCalc::CreditInfo GetInfo(std::size_t i) const {
+    return {sums[i], rates[i], terms[i], types[i]};
+  }
+};
+}  // namespace
+
+TEST(CreditPortfolioTest, Summarize) {
+  Portfolio portfolio(3000);
+  std::size_t size = portfolio.sums.size();
+  std::vector<double> total_payments(size), total_interests(size),
+      first_payments(size), last_payments(size);
+  CreditPortfolio::Summaries summaries{total_payments.data(),
+                                       total_interests.data(),
+                                       first_payments.data(),
+                                       last_payments.data()};
+
+  for (std::size_t threads : {1, 0}) {
+    CreditPortfolio::Summarize(portfolio.GetLoans(), summaries, threads);
+    for (std::size_t i = 0; i < size; ++i) {
+      CreditCalc::Summary summary =
+          CreditCalc::Summarize(portfolio.GetInfo(i));
+      EXPECT_EQ(total_payments[i], summary.total_payment);
+      EXPECT_EQ(total_interests[i], summary.total_interest);
+      EXPECT_EQ(first_payments[i], summary.first_payment);
+      EXPECT_EQ(last_payments[i], summary.last_payment);
+    }
+  }
+
+  std::vector<double> only_totals(size);
+  CreditPortfolio::Summarize(portfolio.GetLoans(), {only_totals.data()});
+  EXPECT_EQ(only_totals, total_payments);
+}
+
+TEST(CreditPortfolioTest, Aggregate) {
+  Portfolio portfolio(5000);
+  CreditPortfolio::Totals totals =
+      CreditPortfolio::Aggregate(portfolio.GetLoans(), 1);
+
+  double total_payment = 0.0, total_interest = 0.0, sum = 0.0;
+  std::size_t payments = 0;
+  for (std::size_t i = 0; i < portfolio.sums.size(); ++i) {
+    CreditCalc::Summary summary = CreditCalc::Summarize(portfolio.GetInfo(i));
+    total_payment += summary.total_payment;
+    total_interest += summary.total_interest;
+    sum += portfolio.sums[i];
+    payments += portfolio.terms[i];
+  }
+  EXPECT_EQ(totals.loans, portfolio.sums.size());
+  EXPECT_EQ(totals.payments, payments);
+  EXPECT_NEAR(totals.sum, sum, 1e-12 * sum);
+  EXPECT_NEAR(totals.total_payment, total_payment, 1e-12 * total_payment);
+  EXPECT_NEAR(totals.total_interest, total_interest, 1e-12 * total_payment);
+
+  for (std::size_t threads : {0, 2, 3}) {
+    CreditPortfolio::Totals parallel =
+        CreditPortfolio::Aggregate(portfolio.GetLoans(), threads);
+    EXPECT_EQ(parallel.loans, totals.loans);
+    EXPECT_EQ(parallel.payments, totals.payments);
+    EXPECT_EQ(parallel.sum, totals.sum);
+    EXPECT_EQ(parallel.total_payment, totals.total_payment);
+    EXPECT_EQ(parallel.total_interest, totals.total_interest);
+  }
+}
+
+TEST(CreditPortfolioTest, Calculate) {
+  Portfolio portfolio(800);
+  CreditPortfolio::Loans loans = portfolio.GetLoans();
+  std::vector<std::size_t> offsets = CreditPortfolio::GetOffsets(loans);
+  ASSERT_EQ(offsets.size(), loans.size + 1);
+  std::vector<double> payments(offsets.back()), principals(offsets.back()),
+      interests(offsets.back()), balances(offsets.back());
+
+  for (std::size_t threads : {1, 0}) {
+    CreditPortfolio::Calculate(loans, offsets.data(),
+                               {payments.data(), principals.data(),
+                                interests.data(), balances.data()},
+                               threads);
+    for (std::size_t i = 0; i < loans.size; ++i) {
+      CreditCalc::CreditInfo info = portfolio.GetInfo(i);
+      CreditCalc::PaymentPlan plan = CreditCalc::Calculate(info);
+      ASSERT_EQ(offsets[i + 1] - offsets[i], plan.payments.size());
+      double error = info.type == CreditCalc::CreditType::kAnnuity
+                         ? 1e-13 * info.sum * plan.payments.size()
+                         : 0.0;
+      for (std::size_t k = 0; k < plan.payments.size(); ++k) {
+        EXPECT_EQ(payments[offsets[i] + k], plan.payments[k]);
+        EXPECT_NEAR(principals[offsets[i] + k], plan.principals[k], error);
+        EXPECT_NEAR(interests[offsets[i] + k], plan.interests[k], error);
+        EXPECT_NEAR(balances[offsets[i] + k], plan.balances[k], error);
+      }
+    }
+  }
+
+  std::vector<double> only_balances(offsets.back());
+  CreditPortfolio::Schedules schedules;
+  schedules.balances = only_balances.data();
+  CreditPortfolio::Calculate(loans, offsets.data(), schedules);
+  EXPECT_EQ(only_balances, balances);
+}
+
+TEST(CreditPortfolioTest, InvalidLoan) {
+  Portfolio portfolio(2000);
+  portfolio.terms[1500] = 0;
+  CreditPortfolio::Loans loans = portfolio.GetLoans();
+  std::vector<double> totals(loans.size, -1.0);
+
+  EXPECT_THROW(CreditPortfolio::GetOffsets(loans), std::invalid_argument);
+  EXPECT_THROW(CreditPortfolio::Aggregate(loans), std::invalid_argument);
+  EXPECT_THROW(CreditPortfolio::Summarize(loans, {totals.data()}),
+               std::invalid_argument);
+  EXPECT_EQ(totals, std::vector<double>(loans.size, -1.0));
+}
+
+TEST(CreditPortfolioTest, EmptyPortfolio) {
+  CreditPortfolio::Loans loans{nullptr, nullptr, nullptr, nullptr, 0};
+  EXPECT_EQ(CreditPortfolio::GetOffsets(loans),
+            std::vector<std::size_t>(1, 0));
+  CreditPortfolio::Totals totals = CreditPortfolio::Aggregate(loans);
+  EXPECT_EQ(totals.loans, 0u);
+  EXPECT_EQ(totals.total_payment, 0.0);
+  CreditPortfolio::Calculate(loans, nullptr, {});
+}
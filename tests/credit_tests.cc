@@ -48,3 +48,60 @@ TEST(CreditCalcTest, DifferentiatedCredit) {
   EXPECT_NEAR(overpayment, 355833.33, 1e-2);
   EXPECT_NEAR(total_payment, 3155833.33, 1e-2);
 }
+
+TEST(CreditCalcTest, Summary) {
+  for (auto type : {CreditCalc::CreditType::kAnnuity,
+                    CreditCalc::CreditType::kDifferentiated}) {
+    for (CreditCalc::CreditInfo info :
+         {CreditCalc::CreditInfo{2800000.0, 5.0, 60, type},
+          CreditCalc::CreditInfo{1234567.89, 7.3, 37, type},
+          CreditCalc::CreditInfo{999.99, 0.01, 1, type},
+          CreditCalc::CreditInfo{15000000.0, 12.75, 600, type}}) {
+      auto plan = CreditCalc::Calculate(info);
+      auto summary = CreditCalc::Summarize(info);
+      double total_payment =
+          std::accumulate(plan.payments.begin(), plan.payments.end(), 0.0);
+      double total_interest =
+          std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
+
+      EXPECT_EQ(std::round(summary.total_payment * 100.0),
+                std::round(total_payment * 100.0));
+      EXPECT_NEAR(summary.total_interest, total_interest,
+                  1e-9 * total_payment);
+      EXPECT_EQ(summary.first_payment, plan.payments.front());
+      EXPECT_EQ(summary.last_payment, plan.payments.back());
+      EXPECT_EQ(CreditCalc::GetBalance(info, 0), info.sum);
+      for (int month = 1; month <= info.term; ++month) {
+        EXPECT_EQ(CreditCalc::GetPayment(info, month),
+                  plan.payments[month - 1]);
+        EXPECT_EQ(CreditCalc::GetBalance(info, month),
+                  plan.balances[month - 1]);
+      }
+    }
+  }
+
+  CreditCalc::CreditInfo info{2800000.0, 5.0, 60,
+                              CreditCalc::CreditType::kDifferentiated};
+  EXPECT_EQ(CreditCalc::GetBalance(info, 60), 0.0);
+  EXPECT_THROW(CreditCalc::GetPayment(info, 0), std::out_of_range);
+  EXPECT_THROW(CreditCalc::GetBalance(info, 61), std::out_of_range);
+  info.term = 0;
+  EXPECT_THROW(CreditCalc::Summarize(info), std::invalid_argument);
+}
+
+TEST(CreditCalcTest, Dates) {
+  CreditCalc::CreditInfo info{100000.0, 10.0, 25,
+                              CreditCalc::CreditType::kAnnuity};
+
+  auto plan = CreditCalc::Calculate(info);
+  Date today = Date::Today();
+  ASSERT_EQ(plan.dates.size(), 25);
+  EXPECT_EQ(plan.dates.front(), today);
+  for (int i = 0; i < 25; ++i) {
+    Date month(today.GetYear(), today.GetMonth() + i, 1);
+    EXPECT_EQ(plan.dates[i].GetYear(), month.GetYear());
+    EXPECT_EQ(plan.dates[i].GetMonth(), month.GetMonth());
+    EXPECT_EQ(plan.dates[i].GetDay(),
+              std::min(today.GetDay(), month.DaysInMonth()));
+  }
+}
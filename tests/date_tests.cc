@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <ctime>
+
+#include "date.h"
+
+using namespace s21;
+
+static_assert(Date(1970, 1, 1).GetDays() == 0);
+static_assert(Date(2000, 3, 1).GetDays() == 11017);
+static_assert(Date(2023, 11, 31) == Date(2023, 12, 1));
+static_assert(Date::FromDays(-1).GetYear() == 1969);
+
+TEST(DateTest, MatchesTimegm) {
+  for (int year : {1601, 1900, 1969, 1970, 2000, 2023, 2024, 2100, 2400}) {
+    for (int month = 1; month <= 12; ++month) {
+      for (int day = 1; day <= Date::DaysInMonth(year, month); ++day) {
+        std::tm time = {};
+        time.tm_year = year - 1900;
+        time.tm_mon = month - 1;
+        time.tm_mday = day;
+        Date date(year, month, day);
+        ASSERT_EQ(date.GetDays(), timegm(&time) / (24 * 60 * 60));
+        ASSERT_EQ(date.GetYear(), year);
+        ASSERT_EQ(date.GetMonth(), month);
+        ASSERT_EQ(date.GetDay(), day);
+      }
+    }
+  }
+}
+
+TEST(DateTest, RoundTrip) {
+  for (int days = -1000000; days <= 1000000; ++days) {
+    Date date = Date::FromDays(days);
+    ASSERT_EQ(Date(date.GetYear(), date.GetMonth(), date.GetDay()), date);
+  }
+}
+
+TEST(DateTest, Normalization) {
+  EXPECT_EQ(Date(2023, 13, 1), Date(2024, 1, 1));
+  EXPECT_EQ(Date(2024, 0, 1), Date(2023, 12, 1));
+  EXPECT_EQ(Date(2024, -11, 1), Date(2023, 1, 1));
+  EXPECT_EQ(Date(2024, 2, 30), Date(2024, 3, 1));
+  EXPECT_EQ(Date(2024, 3, 0), Date(2024, 2, 29));
+  EXPECT_EQ(Date(2024, 1, 1) - Date(2023, 1, 1), 365);
+  EXPECT_EQ(Date(2025, 1, 1) - Date(2024, 1, 1), 366);
+}
+
+TEST(DateTest, Arithmetic) {
+  EXPECT_EQ(Date(2023, 10, 31).AddMonths(1), Date(2023, 12, 1));
+  EXPECT_EQ(Date(2023, 10, 30).AddMonths(14), Date(2024, 12, 30));
+  EXPECT_EQ(Date(2024, 1, 31).AddMonths(1, 31), Date(2024, 2, 29));
+  EXPECT_EQ(Date(2024, 2, 29).AddMonths(1, 31), Date(2024, 3, 31));
+  EXPECT_EQ(Date(2024, 2, 29).AddMonths(12, 29), Date(2025, 2, 28));
+  EXPECT_EQ(Date(2023, 12, 31).AddDays(1), Date(2024, 1, 1));
+  EXPECT_EQ(Date(2024, 2, 15).DaysInMonth(), 29);
+  EXPECT_EQ(Date(1900, 2, 15).DaysInMonth(), 28);
+  EXPECT_EQ(Date(2000, 6, 1).DaysInYear(), 366);
+  EXPECT_EQ(Date(2100, 6, 1).DaysInYear(), 365);
+  EXPECT_LT(Date(2023, 12, 31), Date(2024, 1, 1));
+}
+
+TEST(DateTest, Parse) {
+  EXPECT_EQ(Date::Parse("02-10-2023"), Date(2023, 10, 2));
+  EXPECT_EQ(Date::Parse("2-3-2024"), Date(2024, 3, 2));
+  EXPECT_EQ(Date::Parse("29-02-2024"), Date(2024, 2, 29));
+  for (const char* text : {"", "02-10", "02/10/2023", "31-02-2023",
+                           "29-02-2023", "01-13-2023", "00-01-2023",
+                           "02-10-2023x", "002-10-2023", "aa-bb-cccc"}) {
+    EXPECT_THROW(Date::Parse(text), std::runtime_error) << text;
+  }
+}
+
+TEST(DateTest, Format) {
+  EXPECT_EQ(Date(2023, 10, 2).ToString(), "02-10-2023");
+  EXPECT_EQ(Date::Parse("31-12-1999").ToString(), "31-12-1999");
+  EXPECT_EQ(Date(2023, 10, 2).Format("%B %Y"), "October 2023");
+  EXPECT_EQ(Date(2023, 10, 2).Format("%A %d %b"), "Monday 02 Oct");
+  EXPECT_EQ(Date(1970, 1, 1).Format("%A"), "Thursday");
+  EXPECT_EQ(Date(1969, 12, 31).Format("%A %j"), "Wednesday 365");
+}
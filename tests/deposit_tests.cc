@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <map>
 
 #include "deposit_calc.h"
 
@@ -8,15 +9,15 @@ using namespace s21;
 
 TEST(DepositCalcTest, OneMonth) {
   DepositCalc::DepositInfo info{
-      870000.00, 1,  "02-10-2023",
+      870000.00, 1,  Date::Parse("02-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kMonthly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "02-10-2023");
-  EXPECT_EQ(plan.dates.back(), "02-11-2023");
+  EXPECT_EQ(plan.dates.front().ToString(), "02-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "02-11-2023");
   EXPECT_EQ(plan.dates.size(), 2);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 6650.14, 1e-2);
@@ -30,15 +31,15 @@ TEST(DepositCalcTest, OneMonth) {
 
 TEST(DepositCalcTest, TwoMonths) {
   DepositCalc::DepositInfo info{
-      870000.00, 2,  "03-10-2023",
+      870000.00, 2,  Date::Parse("03-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kMonthly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "03-10-2023");
-  EXPECT_EQ(plan.dates.back(), "03-12-2023");
+  EXPECT_EQ(plan.dates.front().ToString(), "03-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "03-12-2023");
   EXPECT_EQ(plan.dates.size(), 3);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 6484.81, 1e-2);
@@ -52,15 +53,15 @@ TEST(DepositCalcTest, TwoMonths) {
 
 TEST(DepositCalcTest, TwentyMonths) {
   DepositCalc::DepositInfo info{
-      870000.00, 12, "03-10-2023",
+      870000.00, 12, Date::Parse("03-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kMonthly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "03-10-2023");
-  EXPECT_EQ(plan.dates.back(), "03-10-2024");
+  EXPECT_EQ(plan.dates.front().ToString(), "03-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "03-10-2024");
   EXPECT_EQ(plan.dates.size(), 13);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 6969.09, 1e-2);
@@ -74,15 +75,15 @@ TEST(DepositCalcTest, TwentyMonths) {
 
 TEST(DepositCalcTest, SixtyMonths) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "31-10-2023",
+      870000.00, 60, Date::Parse("31-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kMonthly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "31-10-2023");
-  EXPECT_EQ(plan.dates.back(), "31-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "31-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "31-10-2028");
   EXPECT_EQ(plan.dates.size(), 61);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 9975.40, 1e-2);
@@ -96,15 +97,15 @@ TEST(DepositCalcTest, SixtyMonths) {
 
 TEST(DepositCalcTest, QuarterlyPayments) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kQuarterly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 21);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 30035.64, 1e-2);
@@ -118,15 +119,15 @@ TEST(DepositCalcTest, QuarterlyPayments) {
 
 TEST(DepositCalcTest, SemiannuallyPayments) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kSemiAnnually,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 11);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 58182.95, 1e-2);
@@ -140,15 +141,15 @@ TEST(DepositCalcTest, SemiannuallyPayments) {
 
 TEST(DepositCalcTest, AnnuallyPayments) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kAnnually,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 6);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 110578.14, 1e-2);
@@ -162,15 +163,15 @@ TEST(DepositCalcTest, AnnuallyPayments) {
 
 TEST(DepositCalcTest, WeeklyPayments) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kWeekly,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 262);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 2343.77, 1e-2);
@@ -184,15 +185,15 @@ TEST(DepositCalcTest, WeeklyPayments) {
 
 TEST(DepositCalcTest, DailyPayments) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kDaily,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 1828);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 335.43, 1e-2);
@@ -206,15 +207,15 @@ TEST(DepositCalcTest, DailyPayments) {
 
 TEST(DepositCalcTest, AtMaturity) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kAtMaturity,
       true,      {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 2);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 391536.34, 1e-2);
@@ -228,15 +229,15 @@ TEST(DepositCalcTest, AtMaturity) {
 
 TEST(DepositCalcTest, NoCapitalize) {
   DepositCalc::DepositInfo info{
-      870000.00, 60, "30-10-2023",
+      870000.00, 60, Date::Parse("30-10-2023"),
       9,         13, DepositCalc::PaymentPeriod::kDaily,
       false,     {}, {}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 1828);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 213.93, 1e-2);
@@ -252,23 +253,23 @@ TEST(DepositCalcTest, Transactions) {
   DepositCalc::DepositInfo info{
       870000.00,
       60,
-      "30-10-2023",
+      Date::Parse("30-10-2023"),
       9,
       13,
       DepositCalc::PaymentPeriod::kMonthly,
       true,
-      {DepositCalc::Transaction{DepositCalc::Regularity::kOneTime, "31-12-2023",
-                                100000},
-       DepositCalc::Transaction{DepositCalc::Regularity::kMonthly, "31-10-2023",
-                                200000}},
+      {DepositCalc::Transaction{DepositCalc::Regularity::kOneTime,
+                                Date::Parse("31-12-2023"), 100000},
+       DepositCalc::Transaction{DepositCalc::Regularity::kMonthly,
+                                Date::Parse("31-10-2023"), 200000}},
       {DepositCalc::Transaction{DepositCalc::Regularity::kBiMonthly,
-                                "29-02-2024", 150000}}};
+                                Date::Parse("29-02-2024"), 150000}}};
 
   auto plan = DepositCalc::Calculate(info);
   double interest =
       std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  EXPECT_EQ(plan.dates.front(), "30-10-2023");
-  EXPECT_EQ(plan.dates.back(), "30-10-2028");
+  EXPECT_EQ(plan.dates.front().ToString(), "30-10-2023");
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2028");
   EXPECT_EQ(plan.dates.size(), 145);
   EXPECT_NEAR(plan.interests.front(), 0.0, 1e-2);
   EXPECT_NEAR(plan.interests.back(), 81088.51, 1e-2);
@@ -284,20 +285,176 @@ TEST(DepositCalcTest, PlanToString) {
   DepositCalc::DepositInfo info{
       870000.00,
       60,
-      "30-10-2023",
+      Date::Parse("30-10-2023"),
       9,
       13,
       DepositCalc::PaymentPeriod::kAnnually,
       true,
-      {DepositCalc::Transaction{DepositCalc::Regularity::kOneTime, "31-12-2023",
-                                100000},
-       DepositCalc::Transaction{DepositCalc::Regularity::kMonthly, "31-10-2023",
-                                200000}},
+      {DepositCalc::Transaction{DepositCalc::Regularity::kOneTime,
+                                Date::Parse("31-12-2023"), 100000},
+       DepositCalc::Transaction{DepositCalc::Regularity::kMonthly,
+                                Date::Parse("31-10-2023"), 200000}},
       {DepositCalc::Transaction{DepositCalc::Regularity::kBiMonthly,
-                                "29-02-2024", 150000}}};
+                                Date::Parse("29-02-2024"), 150000}}};
 
   auto plan = DepositCalc::Calculate(info);
 
   // std::cout << DepositCalc::PlanToString(plan, info) << "\n";
   // std::cout << DepositCalc::TaxToString(plan.tax_info) << "\n";
 }
+
+TEST(DepositCalcTest, PlanGenerator) {
+  DepositCalc::DepositInfo info{
+      870000.00,
+      360,
+      Date::Parse("30-10-2023"),
+      9,
+      13,
+      DepositCalc::PaymentPeriod::kDaily,
+      true,
+      {DepositCalc::Transaction{DepositCalc::Regularity::kMonthly,
+                                Date::Parse("31-10-2023"), 1000}},
+      {}};
+
+  auto plan = DepositCalc::Calculate(info);
+  DepositCalc::PlanGenerator generator(info);
+  DepositCalc::Row row;
+  std::size_t count = 0;
+  double interest = 0.0;
+  while (generator.Next(row)) {
+    ASSERT_LT(count, plan.dates.size());
+    EXPECT_EQ(row.date, plan.dates[count]);
+    EXPECT_EQ(row.interest, plan.interests[count]);
+    EXPECT_EQ(row.transaction, plan.transactions[count]);
+    EXPECT_EQ(row.balance, plan.balances[count]);
+    interest += row.interest;
+    ++count;
+  }
+  EXPECT_EQ(count, plan.dates.size());
+  EXPECT_EQ(plan.dates.size(), 10958 + 1 + 360);
+  EXPECT_EQ(plan.dates.back().ToString(), "30-10-2053");
+  EXPECT_EQ(interest, std::accumulate(plan.interests.begin(),
+                                      plan.interests.end(), 0.0));
+
+  DepositCalc::Row last = row;
+  EXPECT_FALSE(generator.Next(row));
+  EXPECT_EQ(row.date, last.date);
+  EXPECT_EQ(row.balance, last.balance);
+}
+
+TEST(DepositCalcTest, PlanGeneratorEarlyStop) {
+  DepositCalc::DepositInfo info{
+      870000.00, 360, Date::Parse("30-10-2023"),
+      9,         13,  DepositCalc::PaymentPeriod::kDaily,
+      false,     {},  {}};
+
+  DepositCalc::PlanGenerator generator(info);
+  DepositCalc::Row row;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(generator.Next(row));
+    EXPECT_EQ(row.date, Date(2023, 10, 30 + i));
+    EXPECT_EQ(row.transaction, i == 0 ? info.sum : 0.0);
+    EXPECT_EQ(row.balance, info.sum);
+  }
+  EXPECT_NEAR(row.interest, 214.52, 1e-2);
+}
+
+TEST(DepositCalcTest, TaxCalculator) {
+  DepositCalc::TaxCalculator empty(13);
+  EXPECT_TRUE(empty.Finish().empty());
+
+  DepositCalc::TaxCalculator tax(13);
+  tax.Add({Date(2023, 10, 30), 0.0, 100.0, 100.0});
+  tax.Add({Date(2023, 12, 31), 100000.0, 0.0, 100100.0});
+  tax.Add({Date(2024, 1, 1), 80000.0, 0.0, 180100.0});
+  tax.Add({Date(2024, 6, 1), 20000.0, 0.0, 200100.0});
+  tax.Add({Date(2025, 6, 1), 0.0, 0.0, 200100.0});
+  tax.Add({Date(2026, 6, 1), 1000.0, 0.0, 201100.0});
+
+  auto tax_info = tax.Finish();
+  ASSERT_EQ(tax_info.size(), 3);
+  EXPECT_EQ(tax_info[0].year, 2023);
+  EXPECT_NEAR(tax_info[0].income, 100000.0, 1e-9);
+  EXPECT_NEAR(tax_info[0].deduction_income, 25000.0, 1e-9);
+  EXPECT_NEAR(tax_info[0].tax_sum, 3250.0, 1e-9);
+  EXPECT_EQ(tax_info[0].pay_before, Date(2024, 12, 1));
+  EXPECT_EQ(tax_info[1].year, 2024);
+  EXPECT_NEAR(tax_info[1].income, 100000.0, 1e-9);
+  EXPECT_NEAR(tax_info[1].tax_sum, 3250.0, 1e-9);
+  EXPECT_EQ(tax_info[2].year, 2026);
+  EXPECT_NEAR(tax_info[2].income, 1000.0, 1e-9);
+  EXPECT_NEAR(tax_info[2].tax_sum, 0.0, 1e-9);
+}
+
+TEST(DepositCalcTest, SameDayTransactions) {
+  DepositCalc::DepositInfo info{
+      100000.00,
+      12,
+      Date(2024, 1, 1),
+      9,
+      13,
+      DepositCalc::PaymentPeriod::kAtMaturity,
+      true,
+      {DepositCalc::Transaction{DepositCalc::Regularity::kOneTime,
+                                Date(2024, 1, 1), 500},
+       DepositCalc::Transaction{DepositCalc::Regularity::kMonthly,
+                                Date(2024, 1, 31), 1000},
+       DepositCalc::Transaction{DepositCalc::Regularity::kQuarterly,
+                                Date(2024, 4, 30), 2000}},
+      {DepositCalc::Transaction{DepositCalc::Regularity::kAnnually,
+                                Date(2024, 4, 30), 3000}}};
+
+  auto plan = DepositCalc::Calculate(info);
+  ASSERT_EQ(plan.dates.size(), 17);
+  EXPECT_EQ(plan.dates[0], Date(2024, 1, 1));
+  EXPECT_NEAR(plan.transactions[0], 100500.0, 1e-9);
+  EXPECT_EQ(plan.dates[1], Date(2024, 1, 1));
+  EXPECT_NEAR(plan.transactions[1], 0.0, 1e-9);
+  EXPECT_EQ(plan.dates[3], Date(2024, 2, 29));
+  EXPECT_EQ(plan.dates[5], Date(2024, 4, 30));
+  EXPECT_NEAR(plan.transactions[5], 0.0, 1e-9);
+  EXPECT_EQ(plan.dates[8], Date(2024, 7, 30));
+  EXPECT_NEAR(plan.transactions[8], 2000.0, 1e-9);
+  EXPECT_EQ(plan.dates[9], Date(2024, 7, 31));
+  EXPECT_NEAR(plan.transactions[9], 1000.0, 1e-9);
+  EXPECT_EQ(plan.dates[15], Date(2024, 12, 31));
+  EXPECT_EQ(plan.dates[16], Date(2025, 1, 1));
+  EXPECT_NEAR(plan.transactions[16], 0.0, 1e-9);
+  EXPECT_NEAR(plan.balances[16], 115500.0 + plan.interests[16], 1e-9);
+}
+
+TEST(DepositCalcTest, StandingOrders) {
+  DepositCalc::DepositInfo info{
+      100000.00, 60, Date(2024, 1, 1), 9, 13,
+      DepositCalc::PaymentPeriod::kMonthly, false, {}, {}};
+  std::map<Date, double> expected;
+  const int steps[] = {0, 1, 2, 3, 6, 12};
+  for (int i = 0; i < 300; ++i) {
+    Date start(2024, 1 + i % 7, 1 + i % 31);
+    auto regularity = static_cast<DepositCalc::Regularity>(i % 6);
+    info.replenishments.push_back({regularity, start, 10.0 + i});
+    Date date = start;
+    for (int k = 1; date <= Date(2029, 1, 1); ++k) {
+      expected[date] += 10.0 + i;
+      if (steps[i % 6] == 0) {
+        break;
+      }
+      date = start.AddMonths(k * steps[i % 6], start.GetDay());
+    }
+  }
+
+  DepositCalc::PlanGenerator generator(info);
+  DepositCalc::Row row;
+  auto it = expected.begin();
+  bool first = true;
+  while (generator.Next(row)) {
+    double sum = first ? info.sum : 0.0;
+    if (it != expected.end() && it->first == row.date) {
+      sum += it->second;
+      ++it;
+    }
+    ASSERT_NEAR(row.transaction, sum, 1e-9) << row.date.ToString();
+    first = false;
+  }
+  EXPECT_TRUE(it == expected.end());
+}
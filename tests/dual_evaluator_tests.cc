@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+
+#include "dual_evaluator.h"
+#include "math_calc.h"
+
+using namespace s21;
+
+namespace {
+struct Case {
+  const char* expression;
+  std::function<double(double)> first;
+  std::function<double(double)> second;
+};
+}  // namespace
+
+TEST(DualEvaluatorTest, Derivatives) {
+  const Case cases[] = {
+      {"x ^ 3 - 2x", [](double x) { return 3 * x * x - 2; },
+       [](double x) { return 6 * x; }},
+      {"sin(2x) * cos(x)",
+       [](double x) {
+         return 2 * std::cos(2 * x) * std::cos(x) -
+                std::sin(2 * x) * std::sin(x);
+       },
+       [](double x) {
+         return -5 * std::sin(2 * x) * std::cos(x) -
+                4 * std::cos(2 * x) * std::sin(x);
+       }},
+      {"ln(x) + log(x)", [](double x) { return (1 + 1 / std::log(10)) / x; },
+       [](double x) { return -(1 + 1 / std::log(10)) / (x * x); }},
+      {"x ^ x",
+       [](double x) { return std::pow(x, x) * (std::log(x) + 1); },
+       [](double x) {
+         return std::pow(x, x) *
+                (std::pow(std::log(x) + 1, 2) + 1 / x);
+       }},
+      {"sqrt(x) + x ^ 1.5", [](double x) {
+         return 0.5 / std::sqrt(x) + 1.5 * std::sqrt(x);
+       },
+       [](double x) {
+         return -0.25 / (x * std::sqrt(x)) + 0.75 / std::sqrt(x);
+       }},
+      {"tan(x / 2)",
+       [](double x) { return 0.5 / std::pow(std::cos(x / 2), 2); },
+       [](double x) {
+         return 0.5 * std::tan(x / 2) / std::pow(std::cos(x / 2), 2);
+       }},
+      {"asin(x / 3) - acos(x / 4)",
+       [](double x) {
+         return 1 / std::sqrt(9 - x * x) + 1 / std::sqrt(16 - x * x);
+       },
+       [](double x) {
+         return x / std::pow(9 - x * x, 1.5) + x / std::pow(16 - x * x, 1.5);
+       }},
+      {"atan(x) / (1 + x ^ 2)",
+       [](double x) {
+         return (1 - 2 * x * std::atan(x)) / std::pow(1 + x * x, 2);
+       },
+       [](double x) {
+         double d = 1 + x * x;
+         return (std::atan(x) * (6 * x * x - 2) - 6 * x) /
+                std::pow(d, 3);
+       }},
+      {"2 ^ x + x mod 0.7",
+       [](double x) { return std::exp2(x) * std::log(2) + 1; },
+       [](double x) { return std::exp2(x) * std::pow(std::log(2), 2); }},
+      {"x ^ -2", [](double x) { return -2 / (x * x * x); },
+       [](double x) { return 6 / (x * x * x * x); }},
+      {"sin(x) ^ 2 + 2sin(x)cos(x) + cos(x) ^ 2",
+       [](double x) { return 2 * std::cos(2 * x); },
+       [](double x) { return -4 * std::sin(2 * x); }},
+  };
+
+  std::mt19937_64 generator(5);
+  std::uniform_real_distribution<double> distribution(0.1, 2.5);
+  for (const Case& c : cases) {
+    Program program = MathCalc::Compile(c.expression);
+    for (int i = 0; i < 100; ++i) {
+      double x = distribution(generator);
+      DualEvaluator::Dual dual = DualEvaluator::Evaluate(program, x);
+      EXPECT_EQ(dual.value, MathCalc::Calculate(program, x)) << c.expression;
+      double first = c.first(x);
+      double second = c.second(x);
+      EXPECT_NEAR(dual.first, first, 1e-12 * std::max(1.0, std::abs(first)))
+          << c.expression << " at " << x;
+      EXPECT_NEAR(dual.second, second,
+                  1e-11 * std::max(1.0, std::abs(second)))
+          << c.expression << " at " << x;
+    }
+  }
+}
+
+TEST(DualEvaluatorTest, Constants) {
+  DualEvaluator::Dual dual =
+      DualEvaluator::Evaluate(MathCalc::Compile("sqrt(0) + ln(0) * 0 + x"), 2);
+  EXPECT_EQ(dual.first, 1.0);
+  EXPECT_EQ(dual.second, 0.0);
+
+  dual = DualEvaluator::Evaluate(MathCalc::Compile("7"), 1.0);
+  EXPECT_EQ(dual.value, 7.0);
+  EXPECT_EQ(dual.first, 0.0);
+}
+
+TEST(DualEvaluatorTest, Range) {
+  Program program = MathCalc::Compile("x ^ 2");
+  auto [x, dy] = DualEvaluator::Differentiate(program, -1.0, 1.0, 21);
+  ASSERT_EQ(x.size(), 21);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(dy[i], 2 * x[i]);
+  }
+  EXPECT_THROW(DualEvaluator::Evaluate(MathCalc::Compile("x + y", {"x", "y"}),
+                                       1.0),
+               std::logic_error);
+}
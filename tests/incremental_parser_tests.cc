@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "incremental_parser.h"
+
+using namespace s21;
+
+namespace {
+
+void ExpectSameAsMathCalc(IncrementalParser& parser,
+                          const std::string& expression, double x,
+                          bool same_code = true) {
+  Error error;
+  double result = parser.Update(expression, x, error);
+  Error expected_error;
+  Program program = MathCalc::Compile(expression, expected_error);
+  ASSERT_EQ(error.IsOk(), expected_error.IsOk())
+      << '"' << expression << "\" " << error.message;
+  if (same_code) {
+    EXPECT_EQ(error.code, expected_error.code) << '"' << expression << '"';
+    EXPECT_EQ(error.message, expected_error.message)
+        << '"' << expression << '"';
+  }
+  if (error.IsOk()) {
+    double expected = MathCalc::Calculate(program, x);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << '"' << expression << '"';
+    } else {
+      EXPECT_EQ(result, expected) << '"' << expression << "\" at " << x;
+      EXPECT_EQ(std::signbit(result), std::signbit(expected))
+          << '"' << expression << "\" at " << x;
+    }
+  }
+}
+
+std::string RandomExpression(std::mt19937& random, int depth) {
+  const char* leaves[] = {"x", "x ^ 2", "3x",  "0",     "1",
+                          "2", "0.5",   "1e3", "1e200", "-0"};
+  const char* binary[] = {" + ", " - ", " * ", " / ", " ^ ", " mod "};
+  const char* unary[] = {"-", "+", "sin", "sqrt", "ln", "atan"};
+  std::uniform_int_distribution<int> kind(0, 9);
+  int k = depth > 0 ? kind(random) : 0;
+  if (k < 3) {
+    return leaves[random() % std::size(leaves)];
+  }
+  if (k < 5) {
+    return std::string(unary[random() % std::size(unary)]) + "(" +
+           RandomExpression(random, depth - 1) + ")";
+  }
+  return "(" + RandomExpression(random, depth - 1) +
+         binary[random() % std::size(binary)] +
+         RandomExpression(random, depth - 1) + ")";
+}
+
+}  // namespace
+
+TEST(IncrementalParserTest, Typing) {
+  const std::string expressions[] = {
+      "2 + 3 * 4",
+      "-(2 + x) * 3 mod 2.5",
+      "sin(x)^2 + cos(x)^2",
+      "2^3^2 - 1.5e-3 * x^3",
+      "sqrt(ln(x) + log(100)) / atan(1)",
+      "2x(x + 1)(x - 1) + 3xcos(x)",
+      "asin(0.5) + acos(-0.5) * tan(x)",
+      "10 mod 3 mod 2 + +x - -x",
+      "1.5e+3 / 2e2 + .5",
+      "3x^4 - 2x^3 + x - 7",
+      "-(x^2 - x) * 2 + sin(x^5 / 3 + 1) / (x^2 + 1)^2",
+  };
+  for (const std::string& expression : expressions) {
+    IncrementalParser parser;
+    for (std::size_t length = 0; length <= expression.length(); ++length) {
+      ExpectSameAsMathCalc(parser, expression.substr(0, length), 1.25);
+    }
+    for (std::size_t length = expression.length(); length-- > 0;) {
+      ExpectSameAsMathCalc(parser, expression.substr(0, length), 1.25);
+    }
+  }
+}
+
+TEST(IncrementalParserTest, HugePowers) {
+  const std::string expressions[] = {
+      "2^1e20", "1^1e300", "0^3^3^3", "10^(-2^4^4)", "x^1e20 + (2x)^3^3",
+  };
+  for (const std::string& expression : expressions) {
+    IncrementalParser parser;
+    for (std::size_t length = 0; length <= expression.length(); ++length) {
+      ExpectSameAsMathCalc(parser, expression.substr(0, length), 1.25);
+    }
+  }
+}
+
+TEST(IncrementalParserTest, Errors) {
+  IncrementalParser parser;
+  Error error;
+  parser.Update("2 + (x", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidBrackets);
+  EXPECT_EQ(error.position, 4);
+  EXPECT_DOUBLE_EQ(parser.Update("2 + (x)", 1.0, error), 3.0);
+  EXPECT_TRUE(error.IsOk());
+  parser.Update("2 + (x))", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidBrackets);
+  EXPECT_EQ(error.position, 7);
+  parser.Update("2 + (x)) * 5", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidBrackets);
+  parser.Update("2 + 5!", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidCharacter);
+  EXPECT_EQ(error.position, 5);
+  parser.Update("x 5", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kMissingOperator);
+  EXPECT_DOUBLE_EQ(parser.Update("x        ", 1.0, error), 1.0);
+  parser.Update("x        5", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kMissingOperator);
+  EXPECT_EQ(error.position, 1);
+  parser.Update("sin()", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kMissingOperand);
+  EXPECT_EQ(error.message, "Not enough operands for function: sin");
+  parser.Update("", 1.0, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidExpression);
+  EXPECT_DOUBLE_EQ(parser.Update("x", 1.0, error), 1.0);
+  EXPECT_TRUE(error.IsOk());
+}
+
+TEST(IncrementalParserTest, Variable) {
+  IncrementalParser parser;
+  Error error;
+  EXPECT_DOUBLE_EQ(parser.Update("2x + 1", 3.0, error), 7.0);
+  EXPECT_DOUBLE_EQ(parser.Update("2x + 1", 4.0, error), 9.0);
+  EXPECT_DOUBLE_EQ(parser.Update("2x + 10", 4.0, error), 18.0);
+  EXPECT_TRUE(error.IsOk());
+}
+
+TEST(IncrementalParserTest, RandomEdits) {
+  const std::string pieces[] = {
+      "1",    "7",    "0",   ".",    "e",    "x",    " ",   "(",
+      ")",    "+",    "-",   "*",    "/",    "^",    "mod", " mod ",
+      "sin(", "cos(", "ln(", "sqrt(", "asin(", "atan(", "s",  "in"};
+  std::mt19937 random(12345);
+  std::uniform_int_distribution<std::size_t> piece(0, std::size(pieces) - 1);
+  std::uniform_int_distribution<int> action(0, 9);
+
+  IncrementalParser parser;
+  std::string expression;
+  for (int i = 0; i < 20000; ++i) {
+    int kind = action(random);
+    if (kind < 3 && !expression.empty()) {
+      expression.resize(expression.length() -
+                        std::min<std::size_t>(expression.length(), kind + 1));
+    } else if (kind == 3) {
+      expression = "2x";
+    } else {
+      expression += pieces[piece(random)];
+    }
+    ExpectSameAsMathCalc(parser, expression, 0.75, false);
+  }
+}
+
+TEST(IncrementalParserTest, RandomExpressions) {
+  IncrementalParser parser;
+  for (double x : {0.0, -0.0, 0.75, -3.0}) {
+    ExpectSameAsMathCalc(parser, "(1e3 + 0) / (0 + -x)", x);
+    ExpectSameAsMathCalc(parser, "1 / (x * -1 - 0)", x);
+    ExpectSameAsMathCalc(parser, "1 / (-0 + x * 0)", x);
+  }
+
+  std::mt19937 random(2024);
+  for (int i = 0; i < 5000; ++i) {
+    std::string expression = RandomExpression(random, 5);
+    for (double x : {0.0, -0.0, 0.75, -3.0, 1e300}) {
+      ExpectSameAsMathCalc(parser, expression, x);
+    }
+  }
+}
+
+TEST(IncrementalParserTest, LongExpression) {
+  IncrementalParser parser;
+  Error error;
+  std::string expression = "0";
+  for (int i = 0; i < 20000; ++i) {
+    expression += " + 1";
+    parser.Update(expression.substr(0, expression.length() - 1), 0.0, error);
+    EXPECT_EQ(error.code, ErrorCode::kMissingOperand);
+    EXPECT_DOUBLE_EQ(parser.Update(expression, 0.0, error), i + 1.0);
+  }
+  EXPECT_TRUE(error.IsOk());
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "interval_evaluator.h"
+#include "math_calc.h"
+
+using namespace s21;
+
+namespace {
+using Interval = IntervalEvaluator::Interval;
+
+Interval Bound(const std::string& expression, double lower, double upper) {
+  return IntervalEvaluator::Evaluate(MathCalc::Compile(expression),
+                                     {lower, upper, true});
+}
+}  // namespace
+
+TEST(IntervalEvaluatorTest, Enclosure) {
+  const char* expressions[] = {
+      "x ^ 2 + 3x - 1",
+      "(x - 1) / (x + 1) * (x - 2) / (x + 2) - x * x * x",
+      "2xcos(3x) + -x ^ 2 mod 7",
+      "sqrt(x) + sin(x) * cos(x) - ln(x + 1)",
+      "tan(x) - asin(x / 3) * acos(x / 5)",
+      "x ^ 0.5 + x ^ x + 2 ^ x - (x - 2) ^ -3",
+      "log(x) * atan(x) + x mod 1.5",
+      "sin(x) ^ 2 - 2sin(x)cos(x) + cos(x) ^ 2 / (x * x + 1)",
+  };
+  std::mt19937_64 generator(11);
+  std::uniform_real_distribution<double> start(-10.0, 10.0);
+  std::uniform_real_distribution<double> width(0.0, 3.0);
+
+  for (const char* expression : expressions) {
+    Program program = MathCalc::Compile(expression);
+    for (int i = 0; i < 2000; ++i) {
+      double lower = start(generator);
+      double upper = lower + (i % 4 ? width(generator) : 0.0);
+      Interval bound = IntervalEvaluator::Evaluate(program, {lower, upper});
+      for (int k = 0; k <= 16; ++k) {
+        double x = k == 16 ? upper : lower + (upper - lower) * k / 16;
+        double y = MathCalc::Calculate(program, x);
+        if (std::isnan(y)) {
+          ASSERT_FALSE(bound.defined) << expression << " at " << x;
+        } else {
+          ASSERT_GE(y, bound.lower) << expression << " at " << x;
+          ASSERT_LE(y, bound.upper) << expression << " at " << x;
+        }
+      }
+    }
+  }
+}
+
+TEST(IntervalEvaluatorTest, Tightness) {
+  Interval bound = Bound("sin(x)", 0.0, 3.0);
+  EXPECT_EQ(bound.upper, 1.0);
+  EXPECT_NEAR(bound.lower, 0.0, 1e-15);
+  EXPECT_TRUE(bound.defined);
+
+  bound = Bound("cos(x)", 1.0, 2.0);
+  EXPECT_NEAR(bound.lower, std::cos(2.0), 1e-15);
+  EXPECT_NEAR(bound.upper, std::cos(1.0), 1e-15);
+
+  bound = Bound("x ^ 2", -2.0, 1.0);
+  EXPECT_EQ(bound.lower, 0.0);
+  EXPECT_NEAR(bound.upper, 4.0, 1e-14);
+
+  bound = Bound("x mod 7", 8.0, 9.0);
+  EXPECT_EQ(bound.lower, 1.0);
+  EXPECT_EQ(bound.upper, 2.0);
+
+  bound = Bound("x * 0", -1e300, 1e300);
+  EXPECT_NEAR(bound.lower, 0.0, 1e-300);
+  EXPECT_NEAR(bound.upper, 0.0, 1e-300);
+}
+
+TEST(IntervalEvaluatorTest, Domains) {
+  EXPECT_TRUE(Bound("sqrt(x)", -2.0, -1.0).IsEmpty());
+  EXPECT_TRUE(Bound("ln(x)", -2.0, 0.0).IsEmpty());
+  EXPECT_TRUE(Bound("asin(x)", 1.5, 2.0).IsEmpty());
+  EXPECT_TRUE(Bound("acos(x) + 1", -3.0, -2.0).IsEmpty());
+  EXPECT_TRUE(Bound("x mod 0", 1.0, 2.0).IsEmpty());
+
+  Interval bound = Bound("sqrt(x)", -1.0, 4.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_EQ(bound.lower, 0.0);
+  EXPECT_NEAR(bound.upper, 2.0, 1e-15);
+
+  bound = Bound("log(x)", 0.0, 100.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_EQ(bound.lower, -std::numeric_limits<double>::infinity());
+  EXPECT_NEAR(bound.upper, 2.0, 1e-14);
+
+  bound = Bound("acos(x)", -0.5, 3.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_EQ(bound.lower, 0.0);
+
+  bound = Bound("tan(x)", 1.0, 2.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_TRUE(std::isinf(bound.lower) && std::isinf(bound.upper));
+
+  bound = Bound("tan(x)", -1.0, 1.0);
+  EXPECT_TRUE(bound.defined);
+  EXPECT_NEAR(bound.upper, std::tan(1.0), 1e-15);
+
+  bound = Bound("1 / x", 0.0, 2.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_NEAR(bound.lower, 0.5, 1e-15);
+  EXPECT_EQ(bound.upper, std::numeric_limits<double>::infinity());
+
+  EXPECT_FALSE(Bound("x ^ 0.5", -1.0, 1.0).defined);
+  EXPECT_TRUE(Bound("x ^ 3", -1.0, 1.0).defined);
+}
+
+TEST(IntervalEvaluatorTest, DivisionByZero) {
+  double inf = std::numeric_limits<double>::infinity();
+  Interval bound = Bound("atan(x / 0)", 1.0, 2.0);
+  EXPECT_FALSE(bound.defined);
+  EXPECT_LE(bound.lower, std::atan(-inf));
+  EXPECT_GE(bound.upper, std::atan(inf));
+
+  bound = Bound("1 / (x / 0) + 1", 1.0, 2.0);
+  EXPECT_LE(bound.lower, 1.0);
+  EXPECT_GE(bound.upper, 1.0);
+
+  EXPECT_TRUE(Bound("x / 0", 0.0, 0.0).IsEmpty());
+}
+
+TEST(IntervalEvaluatorTest, Variables) {
+  Program program = MathCalc::Compile("x * y - t", {"x", "y", "t"});
+  Interval bound = IntervalEvaluator::Evaluate(
+      program, {{1.0, 2.0}, {-3.0, 4.0}, {0.0, 1.0}});
+  EXPECT_NEAR(bound.lower, -7.0, 1e-14);
+  EXPECT_NEAR(bound.upper, 8.0, 1e-14);
+  EXPECT_THROW(IntervalEvaluator::Evaluate(program, {1.0, 2.0}),
+               std::logic_error);
+  EXPECT_THROW(IntervalEvaluator::Evaluate(program, {{1.0, 2.0}}),
+               std::logic_error);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "jit_program.h"
+
+using namespace s21;
+
+namespace {
+void ExpectIdentical(const std::string& expression,
+                     std::initializer_list<double> values) {
+  Program program = MathCalc::Compile(expression);
+  JitProgram jit(program);
+  EXPECT_EQ(jit.IsNative(), JitProgram::IsSupported());
+  for (double x : values) {
+    double expected = MathCalc::Calculate(program, x);
+    double result = jit.Calculate(x);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << expression << ", x = " << x;
+    } else {
+      EXPECT_EQ(std::memcmp(&result, &expected, sizeof(double)), 0)
+          << expression << ", x = " << x << ": " << result
+          << " != " << expected;
+    }
+  }
+}
+}  // namespace
+
+TEST(JitProgramTest, Arithmetic) {
+  const auto values = {-3.5, -1.0, -0.0, 0.0, 0.1, 1.0, 2.0, 1e300, HUGE_VAL};
+  ExpectIdentical("x", values);
+  ExpectIdentical("42", values);
+  ExpectIdentical("-x", values);
+  ExpectIdentical("x + 1 - 2x * 3 / (x - 7)", values);
+  ExpectIdentical("(x - 1) / (x + 1) - -x * 0.1", values);
+  ExpectIdentical("1 / x - x / 3 - (x - (x - (x - 1)))", values);
+}
+
+TEST(JitProgramTest, Powers) {
+  const auto values = {-3.5, -1.0, 0.0, 0.7, 1.5, 10.0, 1e100};
+  ExpectIdentical("x ^ 2 + x ^ 3 - x ^ 4", values);
+  ExpectIdentical("x ^ -1 + x ^ -2 + x ^ -3", values);
+  ExpectIdentical("x ^ 0.5 + 2 ^ x - x ^ x", values);
+  ExpectIdentical("x mod 3 + 7 mod x - x mod -0.3", values);
+  ExpectIdentical("3x ^ 4 - 2x ^ 3 + x - 7", values);
+  ExpectIdentical("(x ^ 2 + 1) / (x ^ 2 - 1) + sin(x ^ 3 / 3 - x)", values);
+}
+
+TEST(JitProgramTest, Functions) {
+  const auto values = {-2.5, -1.0, -0.3, 0.0, 0.5, 1.0, 3.0, 100.0};
+  ExpectIdentical("sin(x) + cos(x) - tan(x)", values);
+  ExpectIdentical("asin(x) - acos(x) * atan(x)", values);
+  ExpectIdentical("sqrt(x) + ln(x) / log(x)", values);
+  ExpectIdentical("2xcos(3x) + -x ^ 2 mod 7", values);
+  ExpectIdentical("sin(cos(tan(sqrt(ln(log(x + 25))))))", values);
+  ExpectIdentical("sin(x) ^ 2 + 2sin(x)cos(x) + cos(x) ^ 2", values);
+}
+
+TEST(JitProgramTest, DeepStack) {
+  std::string expression = "x";
+  for (int i = 0; i < 40; ++i) {
+    expression = "sin(x + " + std::to_string(i) + " * (" + expression + "))";
+  }
+  ExpectIdentical(expression, {-1.0, 0.0, 0.5, 2.0});
+
+  Program program = MathCalc::Compile(expression);
+  JitProgram jit(program);
+  std::vector<double> x = {-1.0, 0.0, 0.5, 2.0}, y(x.size());
+  jit.Calculate(x.data(), y.data(), x.size());
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_EQ(y[i], MathCalc::Calculate(program, x[i]));
+  }
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <cfloat>
+
 #include "math_calc.h"
 
 using namespace s21;
@@ -212,6 +214,7 @@ TEST(MathCalcTest, Exception) {
   EXPECT_THROW(MathCalc::Calculate("1.2e*cos(34)"), std::logic_error);
   EXPECT_THROW(MathCalc::Calculate("1.2ee-3"), std::logic_error);
   EXPECT_THROW(MathCalc::Calculate(".e1"), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate("1e400"), std::logic_error);
 
   EXPECT_THROW(MathCalc::Calculate("(x))"), std::logic_error);
   EXPECT_THROW(MathCalc::Calculate("((x)"), std::logic_error);
@@ -226,6 +229,10 @@ TEST(MathCalcTest, Exception) {
   EXPECT_THROW(MathCalc::Calculate("2+3)ln)/4"), std::logic_error);
   EXPECT_THROW(MathCalc::Calculate("8 *)*cos(25)"), std::logic_error);
   EXPECT_THROW(MathCalc::Calculate("pow(3, 2)"), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate("2\xE9"), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate("\xB2 + x"), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate("1\xA0+ 2"), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate("1e\xFF"), std::logic_error);
 
   // EXPECT_THROW(MathCalc::Calculate("1 / 0.0"), std::invalid_argument);
   // EXPECT_THROW(MathCalc::Calculate("asin(2)"), std::invalid_argument);
@@ -234,3 +241,163 @@ TEST(MathCalcTest, Exception) {
   // EXPECT_THROW(MathCalc::Calculate("ln(0.0)"), std::invalid_argument);
   // EXPECT_THROW(MathCalc::Calculate("log(-1)"), std::invalid_argument);
 }
+
+TEST(MathCalcTest, ErrorChannel) {
+  struct Case {
+    const char* expression;
+    ErrorCode code;
+    std::size_t position;
+  };
+  const Case cases[] = {
+      {"2 + 5.5.5", ErrorCode::kInvalidNumber, 4},
+      {"5*a", ErrorCode::kInvalidToken, 2},
+      {"5!", ErrorCode::kInvalidCharacter, 1},
+      {"x 55", ErrorCode::kMissingOperator, 1},
+      {"(x))", ErrorCode::kInvalidBrackets, 3},
+      {"((x)", ErrorCode::kInvalidBrackets, 0},
+      {"3*", ErrorCode::kMissingOperand, 1},
+      {"sin()", ErrorCode::kMissingOperand, 0},
+      {"", ErrorCode::kInvalidExpression, 0},
+      {"2 3 +", ErrorCode::kMissingOperator, 1},
+  };
+
+  Error error;
+  for (const Case& c : cases) {
+    Program program = MathCalc::Compile(c.expression, error);
+    EXPECT_EQ(error.code, c.code) << c.expression;
+    EXPECT_EQ(error.position, c.position) << c.expression;
+    EXPECT_TRUE(program.code.empty()) << c.expression;
+    try {
+      MathCalc::Compile(c.expression);
+      ADD_FAILURE() << c.expression;
+    } catch (const std::logic_error& err) {
+      EXPECT_EQ(error.message, err.what());
+    }
+  }
+
+  Program program = MathCalc::Compile("2x", error);
+  EXPECT_TRUE(error.IsOk());
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(program, 3.0), 6.0);
+
+  MathCalc::Compile("sin * 2", error, {"sin"});
+  EXPECT_EQ(error.code, ErrorCode::kInvalidVariable);
+  EXPECT_EQ(MathCalc::Canonicalize("2 & x", error), "");
+  EXPECT_EQ(error.code, ErrorCode::kInvalidCharacter);
+  EXPECT_EQ(error.position, 2);
+}
+
+TEST(MathCalcTest, PointStatus) {
+  std::vector<PointStatus> status;
+  Error error;
+  auto [x, y] =
+      MathCalc::Calculate("sqrt(x) + 1 / (x - 1)", -1.0, 2.0, 7, status, error);
+  EXPECT_TRUE(error.IsOk());
+  ASSERT_EQ(y.size(), 7);
+  const PointStatus expected[] = {
+      PointStatus::kUndefined, PointStatus::kUndefined, PointStatus::kOk,
+      PointStatus::kOk,        PointStatus::kInfinite,  PointStatus::kOk,
+      PointStatus::kOk};
+  ASSERT_EQ(status.size(), 7);
+  for (std::size_t i = 0; i < status.size(); ++i) {
+    EXPECT_EQ(status[i], expected[i]) << x[i];
+  }
+  EXPECT_DOUBLE_EQ(y[6], std::sqrt(2.0) + 1.0);
+
+  auto [x_invalid, y_invalid] =
+      MathCalc::Calculate("sqrt(x", -1.0, 2.0, 7, status, error);
+  EXPECT_EQ(error.code, ErrorCode::kInvalidBrackets);
+  EXPECT_TRUE(x_invalid.empty() && y_invalid.empty() && status.empty());
+
+  Program program = MathCalc::Compile("ln(x)");
+  MathCalc::Calculate(program, 0.0, 1.0, 20000, status, 4);
+  EXPECT_EQ(status.front(), PointStatus::kInfinite);
+  EXPECT_TRUE(std::all_of(status.begin() + 1, status.end(),
+                          [](PointStatus s) { return s == PointStatus::kOk; }));
+}
+
+TEST(MathCalcTest, LongExpression) {
+  std::string product(20000, 'x');
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(product, 1.0), 1.0);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(product + "cos(x)", 0.0), 0.0);
+
+  std::string sum = "0";
+  for (int i = 1; i <= 5000; ++i) {
+    sum += "+" + std::to_string(i) + ".5e-1";
+  }
+  EXPECT_NEAR(MathCalc::Calculate(sum), 5000 * 5001 / 20.0 + 250.0, 1e-6);
+
+  EXPECT_EQ(MathCalc::Calculate("1e-310"), 1e-310);
+}
+
+TEST(MathCalcTest, CompiledExpression) {
+  MathCalc calc("2xcos(3x) + -x ^ 2 mod 7");
+  for (double x : {-3.5, 0.0, 0.25, 25.0}) {
+    EXPECT_DOUBLE_EQ(calc.Calculate(x),
+                     2 * x * cos(3 * x) + fmod(pow(-x, 2), 7));
+  }
+  MathCalc shared("sin(x) ^ 2 + 2sin(x)cos(x) + cos(x) ^ 2 - sin(x)cos(x)");
+  for (double x : {-3.5, 0.0, 0.25, 25.0}) {
+    EXPECT_DOUBLE_EQ(shared.Calculate(x), pow(sin(x), 2) +
+                                              2 * sin(x) * cos(x) +
+                                              pow(cos(x), 2) -
+                                              sin(x) * cos(x));
+  }
+  EXPECT_THROW(MathCalc("2 +"), std::logic_error);
+}
+
+TEST(MathCalcTest, Range) {
+  auto [x, y] = MathCalc::Calculate("sin(x) * x", -2.0, 3.0, 11);
+  ASSERT_EQ(x.size(), 11);
+  ASSERT_EQ(y.size(), 11);
+  EXPECT_DOUBLE_EQ(x.front(), -2.0);
+  EXPECT_DOUBLE_EQ(x.back(), 3.0);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(y[i], sin(x[i]) * x[i]);
+  }
+}
+
+TEST(MathCalcTest, ScalarTypes) {
+  Program program = MathCalc::Compile("2 ^ x + sqrt(x) * atan(x) + ln(x + 1)");
+  for (double x : {0.0, 0.3, 1.0, 7.5, 19.0}) {
+    double expected = MathCalc::Calculate(program, x);
+    EXPECT_EQ(MathCalc::Evaluate(program, x), expected);
+    float single = MathCalc::Evaluate(program, static_cast<float>(x));
+    EXPECT_NEAR(single, expected, 32 * FLT_EPSILON * expected) << x;
+    long double extended =
+        MathCalc::Evaluate(program, static_cast<long double>(x));
+    EXPECT_NEAR(static_cast<double>(extended), expected,
+                4 * DBL_EPSILON * expected)
+        << x;
+  }
+  Program inverse = MathCalc::Compile("1 / x");
+  EXPECT_EQ(MathCalc::Evaluate(inverse, 3.0f), 1.0f / 3);
+  EXPECT_EQ(MathCalc::Evaluate(inverse, 3.0L), 1.0L / 3);
+}
+
+TEST(MathCalcTest, Precision) {
+  Program program = MathCalc::Compile("2 ^ x + sqrt(x) * atan(x) + ln(x + 1)");
+  auto [x, y] = MathCalc::Calculate(program, 0.0, 20.0, 10001);
+  auto [x_single, y_single] = MathCalc::Calculate(
+      program, 0.0, 20.0, 10001, MathCalc::Precision::kSingle, 4);
+  auto [x_double, y_double] = MathCalc::Calculate(
+      program, 0.0, 20.0, 10001, MathCalc::Precision::kDouble);
+  auto [x_extended, y_extended] = MathCalc::Calculate(
+      program, 0.0, 20.0, 10001, MathCalc::Precision::kExtended, 4);
+  ASSERT_EQ(y_single.size(), y.size());
+  ASSERT_EQ(y_extended.size(), y.size());
+  EXPECT_EQ(x_single, x);
+  EXPECT_EQ(x_extended, x);
+  EXPECT_EQ(y_double, y);
+
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_NEAR(y_single[i], y[i], 32 * FLT_EPSILON * y[i]) << x[i];
+    EXPECT_NEAR(y_extended[i], y[i], 4 * DBL_EPSILON * y[i]) << x[i];
+  }
+
+  auto [x_pole, y_pole] =
+      MathCalc::Calculate(MathCalc::Compile("1 / x + sqrt(x)"), -1.0, 1.0, 3,
+                          MathCalc::Precision::kSingle);
+  EXPECT_TRUE(std::isnan(y_pole[0]));
+  EXPECT_TRUE(std::isinf(y_pole[1]));
+  EXPECT_DOUBLE_EQ(y_pole[2], 2.0);
+}
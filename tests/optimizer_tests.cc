@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <sstream>
+
+#include "math_calc.h"
+#include "optimizer.h"
+
+using namespace s21;
+
+namespace {
+Program MakeProgram(std::vector<Instruction> code) {
+  Program program;
+  program.code = std::move(code);
+  return program;
+}
+
+Instruction Number(double value) { return {OpCode::kNumber, value}; }
+Instruction Variable() { return {OpCode::kVariable, 0.0}; }
+Instruction Op(OpCode op) { return {op, 0.0}; }
+
+/**
+ * Builds an unoptimized Program from space-separated tokens in Reverse Polish
+ * Notation, such as "1 x neg 0 + /".
+ */
+Program Rpn(const std::string& text) {
+  const std::map<std::string, OpCode> ops = {
+      {"+", OpCode::kAdd},   {"-", OpCode::kSub}, {"*", OpCode::kMul},
+      {"/", OpCode::kDiv},   {"^", OpCode::kPow}, {"neg", OpCode::kNegate},
+      {"sin", OpCode::kSin}, {"x", OpCode::kVariable}};
+  Program program;
+  std::size_t depth = 0;
+  std::istringstream tokens(text);
+  for (std::string token; tokens >> token;) {
+    auto op = ops.find(token);
+    if (op == ops.end()) {
+      program.code.push_back(Number(std::stod(token)));
+      ++depth;
+    } else {
+      program.code.push_back(Op(op->second));
+      depth += op->second == OpCode::kVariable ? 1 : 0;
+      depth -= IsBinary(op->second) ? 1 : 0;
+    }
+    program.depth = std::max(program.depth, depth);
+  }
+  return program;
+}
+
+/**
+ * Expects an optimized Program to give the same results as the original one,
+ * including the signs of zeros and infinities and NaN.
+ */
+void ExpectSameResults(const std::string& rpn,
+                       std::initializer_list<double> xs) {
+  Program program = Rpn(rpn);
+  Program optimized = Optimizer::Optimize(program);
+  for (double x : xs) {
+    double expected = MathCalc::Calculate(program, x);
+    double result = MathCalc::Calculate(optimized, x);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << rpn << " at " << x;
+    } else {
+      EXPECT_EQ(result, expected) << rpn << " at " << x;
+      EXPECT_EQ(std::signbit(result), std::signbit(expected))
+          << rpn << " at " << x;
+    }
+  }
+}
+}  // namespace
+
+TEST(OptimizerTest, ConstantFolding) {
+  // (3 + 4) ^ 2
+  auto program = Optimizer::Optimize(MakeProgram(
+      {Number(3), Number(4), Op(OpCode::kAdd), Number(2), Op(OpCode::kPow)}));
+  ASSERT_EQ(program.code.size(), 1);
+  EXPECT_EQ(program.code[0].op, OpCode::kNumber);
+  EXPECT_DOUBLE_EQ(program.code[0].value, 49.0);
+  EXPECT_EQ(program.depth, 1);
+
+  // sqrt(2) * ln(10) * x
+  program = Optimizer::Optimize(
+      MakeProgram({Number(2), Op(OpCode::kSqrt), Number(10), Op(OpCode::kLn),
+                   Op(OpCode::kMul), Variable(), Op(OpCode::kMul)}));
+  ASSERT_EQ(program.code.size(), 3);
+  EXPECT_EQ(program.code[0].op, OpCode::kNumber);
+  EXPECT_DOUBLE_EQ(program.code[0].value, sqrt(2) * log(10));
+  EXPECT_EQ(program.code[1].op, OpCode::kVariable);
+  EXPECT_EQ(program.code[2].op, OpCode::kMul);
+  EXPECT_EQ(program.depth, 2);
+}
+
+TEST(OptimizerTest, Identities) {
+  // x * 1 - 0
+  auto program = Optimizer::Optimize(MakeProgram(
+      {Variable(), Number(1), Op(OpCode::kMul), Number(0), Op(OpCode::kSub)}));
+  ASSERT_EQ(program.code.size(), 1);
+  EXPECT_EQ(program.code[0].op, OpCode::kVariable);
+
+  // 1 * (-0 + x) ^ 1
+  program = Optimizer::Optimize(
+      MakeProgram({Number(1), Number(-0.0), Variable(), Op(OpCode::kAdd),
+                   Number(1), Op(OpCode::kPow), Op(OpCode::kMul)}));
+  ASSERT_EQ(program.code.size(), 1);
+  EXPECT_EQ(program.code[0].op, OpCode::kVariable);
+
+  // x + -0 is x even for x = -0, unlike x + 0 and x - -0
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(-0.0), Op(OpCode::kAdd)}));
+  ASSERT_EQ(program.code.size(), 1);
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(-0.0), Op(OpCode::kSub)}));
+  EXPECT_EQ(program.code.size(), 3);
+
+  // --sin(x) / -1
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Op(OpCode::kSin), Op(OpCode::kNegate),
+                   Op(OpCode::kNegate), Number(-1), Op(OpCode::kDiv)}));
+  ASSERT_EQ(program.code.size(), 3);
+  EXPECT_EQ(program.code[1].op, OpCode::kSin);
+  EXPECT_EQ(program.code[2].op, OpCode::kNegate);
+
+  // x ^ 0
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(0), Op(OpCode::kPow)}));
+  ASSERT_EQ(program.code.size(), 1);
+  EXPECT_DOUBLE_EQ(program.code[0].value, 1.0);
+}
+
+TEST(OptimizerTest, SignOfZero) {
+  for (const char* rpn :
+       {"1 x neg 0 + /", "1 0 x neg + /", "1e3 0 + 0 x neg + /",
+        "1 x neg 0 - /", "1 x neg -0 + /", "1 x -1 * /", "1 x 0 neg - /"}) {
+    ExpectSameResults(rpn, {0.0, -0.0, 2.0});
+  }
+  EXPECT_EQ(MathCalc::Calculate("1/(-x+0)", 0.0), HUGE_VAL);
+}
+
+TEST(OptimizerTest, IntegerPower) {
+  auto program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(3), Op(OpCode::kPow)}));
+  ASSERT_EQ(program.code.size(), 2);
+  EXPECT_EQ(program.code[1].op, OpCode::kPowInt);
+  EXPECT_DOUBLE_EQ(program.code[1].value, 3.0);
+
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(2.5), Op(OpCode::kPow)}));
+  ASSERT_EQ(program.code.size(), 3);
+  EXPECT_EQ(program.code[2].op, OpCode::kPow);
+
+  for (double x : {-3.7, -1.0, 0.5, 2.0, 1234.5}) {
+    for (long n = -Optimizer::kMaxPowInt; n <= Optimizer::kMaxPowInt; ++n) {
+      EXPECT_DOUBLE_EQ(PowInt(x, n), pow(x, n));
+    }
+  }
+}
+
+TEST(OptimizerTest, CommonSubexpressions) {
+  // sin(x) ^ 2 + 2 * sin(x) * cos(x) + cos(x) ^ 2
+  auto program = Optimizer::Optimize(MakeProgram(
+      {Variable(), Op(OpCode::kSin), Number(2), Op(OpCode::kPow), Number(2),
+       Variable(), Op(OpCode::kSin), Op(OpCode::kMul), Variable(),
+       Op(OpCode::kCos), Op(OpCode::kMul), Op(OpCode::kAdd), Variable(),
+       Op(OpCode::kCos), Number(2), Op(OpCode::kPow), Op(OpCode::kAdd)}));
+  std::vector<OpCode> expected = {
+      OpCode::kVariable, OpCode::kSin,  OpCode::kStore,    OpCode::kPowInt,
+      OpCode::kNumber,   OpCode::kLoad, OpCode::kMul,      OpCode::kVariable,
+      OpCode::kCos,      OpCode::kStore, OpCode::kMul,     OpCode::kAdd,
+      OpCode::kLoad,     OpCode::kPowInt, OpCode::kAdd};
+  ASSERT_EQ(program.code.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(program.code[i].op, expected[i]) << i;
+  }
+  EXPECT_EQ(program.depth, 5);
+  EXPECT_EQ(program.code[2].value, 3.0);
+  EXPECT_EQ(program.code[5].value, 3.0);
+  EXPECT_EQ(program.code[9].value, 4.0);
+  EXPECT_EQ(program.code[12].value, 4.0);
+
+  // sin(x) * x - x * sin(x) shares the whole product
+  program = Optimizer::Optimize(MakeProgram(
+      {Variable(), Op(OpCode::kSin), Variable(), Op(OpCode::kMul), Variable(),
+       Variable(), Op(OpCode::kSin), Op(OpCode::kMul), Op(OpCode::kSub)}));
+  ASSERT_EQ(program.code.size(), 7);
+  EXPECT_EQ(program.code[4].op, OpCode::kStore);
+  EXPECT_EQ(program.code[5].op, OpCode::kLoad);
+  EXPECT_EQ(program.code[6].op, OpCode::kSub);
+
+  // Repeated variables and literals are not shared
+  program = Optimizer::Optimize(MakeProgram(
+      {Variable(), Number(3), Op(OpCode::kMod), Variable(), Number(3),
+       Op(OpCode::kDiv), Op(OpCode::kAdd)}));
+  ASSERT_EQ(program.code.size(), 7);
+  EXPECT_EQ(program.depth, 3);
+}
+
+TEST(OptimizerTest, Polynomials) {
+  // 3 * x ^ 4 - 2 * x ^ 3 + x - 7
+  auto program = Optimizer::Optimize(MakeProgram(
+      {Number(3), Variable(), Number(4), Op(OpCode::kPow), Op(OpCode::kMul),
+       Number(2), Variable(), Number(3), Op(OpCode::kPow), Op(OpCode::kMul),
+       Op(OpCode::kSub), Variable(), Op(OpCode::kAdd), Number(7),
+       Op(OpCode::kSub)}));
+  ASSERT_EQ(program.code.size(), 7);
+  EXPECT_EQ(program.code[0].op, OpCode::kVariable);
+  EXPECT_EQ(program.code[1].op, OpCode::kPolynomial);
+  EXPECT_EQ(program.code[1].value, 4.0);
+  const double coefficients[] = {3, -2, 0, 1, -7};
+  for (std::size_t k = 0; k < 5; ++k) {
+    EXPECT_EQ(program.code[k + 2].op, OpCode::kCoefficient);
+    EXPECT_EQ(program.code[k + 2].value, coefficients[k]);
+  }
+  EXPECT_EQ(program.depth, 1);
+
+  // (x ^ 2 + 1) / (x ^ 2 - 1) divides two polynomials
+  program = Optimizer::Optimize(MakeProgram(
+      {Variable(), Number(2), Op(OpCode::kPow), Number(1), Op(OpCode::kAdd),
+       Variable(), Number(2), Op(OpCode::kPow), Number(1), Op(OpCode::kSub),
+       Op(OpCode::kDiv)}));
+  ASSERT_EQ(program.code.size(), 11);
+  EXPECT_EQ(program.code[1].op, OpCode::kPolynomial);
+  EXPECT_EQ(program.code[6].op, OpCode::kPolynomial);
+  EXPECT_EQ(program.code[10].op, OpCode::kDiv);
+  EXPECT_EQ(program.depth, 2);
+
+  // sin(x ^ 2 / 2 - x) + cos(x ^ 2 / 2 - x) shares the polynomial
+  std::vector<Instruction> polynomial = {Variable(), Number(2),
+                                         Op(OpCode::kPow), Number(2),
+                                         Op(OpCode::kDiv), Variable(),
+                                         Op(OpCode::kSub)};
+  std::vector<Instruction> code = polynomial;
+  code.push_back(Op(OpCode::kSin));
+  code.insert(code.end(), polynomial.begin(), polynomial.end());
+  code.push_back(Op(OpCode::kCos));
+  code.push_back(Op(OpCode::kAdd));
+  program = Optimizer::Optimize(MakeProgram(code));
+  std::vector<OpCode> expected = {
+      OpCode::kVariable,    OpCode::kPolynomial, OpCode::kCoefficient,
+      OpCode::kCoefficient, OpCode::kCoefficient, OpCode::kStore,
+      OpCode::kSin,         OpCode::kLoad,        OpCode::kCos,
+      OpCode::kAdd};
+  ASSERT_EQ(program.code.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(program.code[i].op, expected[i]) << i;
+  }
+  EXPECT_EQ(program.code[2].value, 0.5);
+  EXPECT_EQ(program.code[3].value, -1.0);
+
+  // A single term and a product of two sums are left as written
+  program = Optimizer::Optimize(MakeProgram(
+      {Number(3), Variable(), Number(7), Op(OpCode::kPow), Op(OpCode::kMul)}));
+  EXPECT_EQ(program.code.size(), 5);
+  program = Optimizer::Optimize(
+      MakeProgram({Variable(), Number(1), Op(OpCode::kAdd), Variable(),
+                   Number(1), Op(OpCode::kSub), Op(OpCode::kMul)}));
+  EXPECT_EQ(program.code.size(), 7);
+}
+
+TEST(OptimizerTest, PolynomialCancellation) {
+  // x * (-x - 1e200 * (x - 3)), (3 + ((x - x) - x ^ 3)) + x * 1e200 and
+  // x * ((1e3 + x) - (x - 1e3)) + 2 would cancel terms when collected
+  ExpectSameResults("x x neg 1e200 x 3 - * - *", {3.0, -2.0, 1e-3});
+  ExpectSameResults("3 x x - x 3 ^ - + x 1e200 * +", {1e300, 2.0});
+  ExpectSameResults("x 1e3 x + x 1e3 - - * 2 +", {1e300, 5.0});
+  ExpectSameResults("x 1e-200 1e-200 x * * * 1 +", {1e300, 2.0});
+  ExpectSameResults("0 x 2 ^ * x +", {1e200, 2.0});
+  ExpectSameResults("x x * neg x 1e200 * 3e200 + +", {-3.0});
+  ExpectSameResults("3e200 1e200 x * + x x * -", {-3.0});
+  EXPECT_EQ(Optimizer::Optimize(Rpn("x x neg 1e200 x 3 - * - *")).code.size(),
+            10);
+
+  // (2 * x + 3) * x + 1 is in Horner's form and gives the same roundings
+  Program program = Optimizer::Optimize(Rpn("2 x * 3 + x * 1 +"));
+  ASSERT_EQ(program.code.size(), 5);
+  EXPECT_EQ(program.code[1].op, OpCode::kPolynomial);
+  ExpectSameResults("2 x * 3 + x * 1 +", {0.1, 3.0, -7.5, 1e300});
+}
+
+TEST(OptimizerTest, PolynomialAlgebra) {
+  using Polynomial = Optimizer::Polynomial;
+  Polynomial x = Polynomial::Variable(0);
+  Polynomial square, sum, product;
+  ASSERT_TRUE(Optimizer::Apply({OpCode::kPowInt, 2.0}, x, x, square));
+  ASSERT_TRUE(Optimizer::Apply(Op(OpCode::kAdd), square,
+                               Polynomial::Constant(3), sum));
+  ASSERT_TRUE(Optimizer::Apply(Op(OpCode::kMul), sum, x, product));
+  EXPECT_EQ(product.degree, 3);
+  EXPECT_EQ(product.CountTerms(), 2);
+  EXPECT_TRUE(product.IsSpecialized());
+  EXPECT_EQ(product.Evaluate(2.0), 14.0);
+
+  Polynomial result;
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kMul), sum, sum, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kDiv), x, x, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kDiv), x, Polynomial::Constant(0),
+                                result));
+  EXPECT_FALSE(Optimizer::Apply({OpCode::kPowInt, -2.0}, x, x, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kSin), x, x, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kAdd), x,
+                                Polynomial::Variable(1), result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kPow), x,
+                                Polynomial::Constant(17), result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kPow), Polynomial::Constant(2),
+                                Polynomial::Constant(1e20), result));
+  EXPECT_FALSE(Optimizer::Apply({OpCode::kPowInt, 3.0},
+                                Polynomial::Constant(2), x, result));
+  EXPECT_TRUE(Optimizer::Apply(Op(OpCode::kPow), x, Polynomial::Constant(16),
+                               result));
+  EXPECT_FALSE(result.IsSpecialized());
+
+  // Terms are never merged, reordered or multiplied out
+  EXPECT_TRUE(square.IsPower());
+  EXPECT_FALSE(sum.IsPower());
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kAdd), sum, square, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kAdd), Polynomial::Constant(3),
+                                square, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kSub), square, sum, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kMul), Polynomial::Constant(2),
+                                sum, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kMul), Polynomial::Constant(0),
+                                square, result));
+  EXPECT_FALSE(Optimizer::Apply(Op(OpCode::kDiv), sum,
+                                Polynomial::Constant(2), result));
+  EXPECT_FALSE(Optimizer::Apply({OpCode::kPowInt, 2.0}, sum, x, result));
+  EXPECT_TRUE(Optimizer::Apply(Op(OpCode::kMul), Polynomial::Constant(-1),
+                               sum, result));
+  EXPECT_EQ(result.Evaluate(2.0), -7.0);
+  EXPECT_TRUE(Optimizer::Apply(Op(OpCode::kPow), sum,
+                               Polynomial::Constant(1), result));
+  EXPECT_EQ(result.Evaluate(2.0), 7.0);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "program_cache.h"
+
+using namespace s21;
+
+TEST(ProgramCacheTest, Canonicalize) {
+  EXPECT_EQ(MathCalc::Canonicalize("2x"), MathCalc::Canonicalize("2 * x"));
+  EXPECT_EQ(MathCalc::Canonicalize("2.0*x"), MathCalc::Canonicalize("2x"));
+  EXPECT_EQ(MathCalc::Canonicalize(" sin( x )mod 3"),
+            MathCalc::Canonicalize("sin(x) mod 3.0"));
+  EXPECT_EQ(MathCalc::Canonicalize("1e2"), MathCalc::Canonicalize("100"));
+  EXPECT_NE(MathCalc::Canonicalize("2x"), MathCalc::Canonicalize("2+x"));
+  EXPECT_NE(MathCalc::Canonicalize("(-x)"), MathCalc::Canonicalize("( -x)"));
+  EXPECT_THROW(MathCalc::Canonicalize("2 & x"), std::logic_error);
+}
+
+TEST(ProgramCacheTest, HitsAndMisses) {
+  ProgramCache cache(8);
+  auto program = cache.Get("2x + 1");
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(*program, 3.0), 7.0);
+  EXPECT_EQ(cache.Get("2x + 1"), program);
+  EXPECT_EQ(cache.Get("2 * x+1"), program);
+  EXPECT_EQ(cache.Get("2.0x + 1"), program);
+  EXPECT_NE(cache.Get("2x - 1"), program);
+
+  ProgramCache::Statistics statistics = cache.GetStatistics();
+  EXPECT_EQ(statistics.hits, 3);
+  EXPECT_EQ(statistics.misses, 2);
+  EXPECT_EQ(statistics.evictions, 0);
+  EXPECT_EQ(statistics.size, 2);
+  EXPECT_EQ(statistics.capacity, 8);
+
+  EXPECT_THROW(cache.Get("2x +"), std::logic_error);
+  EXPECT_EQ(cache.GetStatistics().size, 2);
+  Error error;
+  EXPECT_EQ(cache.Get("2x +", error), nullptr);
+  EXPECT_EQ(error.code, ErrorCode::kMissingOperand);
+  EXPECT_EQ(cache.Get("2x +1", error), program);
+  EXPECT_TRUE(error.IsOk());
+  EXPECT_EQ(cache.GetStatistics().size, 2);
+
+  cache.Clear();
+  statistics = cache.GetStatistics();
+  EXPECT_EQ(statistics.hits + statistics.misses + statistics.size, 0);
+}
+
+TEST(ProgramCacheTest, Eviction) {
+  ProgramCache cache(2);
+  auto first = cache.Get("x + 1");
+  cache.Get("x + 2");
+  cache.Get("x+1");
+  cache.Get("x + 3");
+
+  EXPECT_EQ(cache.GetStatistics().evictions, 1);
+  EXPECT_EQ(cache.Get("x + 1"), first);
+  EXPECT_EQ(cache.GetStatistics().misses, 3);
+  cache.Get("x + 2");
+  EXPECT_EQ(cache.GetStatistics().misses, 4);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(*first, 1.0), 2.0);
+
+  cache.SetCapacity(1);
+  EXPECT_EQ(cache.GetCapacity(), 1);
+  EXPECT_EQ(cache.GetStatistics().size, 1);
+  EXPECT_EQ(cache.GetStatistics().evictions, 3);
+
+  cache.SetCapacity(0);
+  EXPECT_NE(cache.Get("x + 1"), cache.Get("x + 1"));
+  EXPECT_EQ(cache.GetStatistics().size, 0);
+}
+
+TEST(ProgramCacheTest, Concurrent) {
+  ProgramCache cache(4);
+  std::vector<std::thread> threads;
+  std::atomic<int> errors{0};
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&cache, &errors, i] {
+      for (int j = 0; j < 500; ++j) {
+        int n = (i + j) % 6;
+        std::string expression = "x * " + std::to_string(n) + " + 1";
+        double result = MathCalc::Calculate(*cache.Get(expression), 2.0);
+        if (result != 2.0 * n + 1) {
+          ++errors;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(errors, 0);
+  ProgramCache::Statistics statistics = cache.GetStatistics();
+  EXPECT_EQ(statistics.hits + statistics.misses, 2000);
+  EXPECT_LE(statistics.size, 4);
+}
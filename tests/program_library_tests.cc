@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "program_library.h"
+#include "vector_evaluator.h"
+
+using namespace s21;
+
+namespace {
+std::string TempPath(const std::string& name) {
+  return testing::TempDir() + "program_library_" + name + ".bin";
+}
+
+std::vector<char> ReadFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file),
+          std::istreambuf_iterator<char>()};
+}
+
+void WriteFile(const std::string& path, const std::vector<char>& bytes) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+}  // namespace
+
+TEST(ProgramLibraryTest, WriteAndLoad) {
+  std::string path = TempPath("basic");
+  ProgramLibrary::Builder builder;
+  builder.Add("wave", "sin(x) * x + sin(x) ^ 2");
+  builder.Add("area", "w * h / 2", VariableTable{"w", "h"});
+  builder.Add("constant", MathCalc::Compile("2 ^ 10"));
+  EXPECT_EQ(builder.GetSize(), 3);
+  builder.Write(path);
+
+  ProgramLibrary library(path);
+  ASSERT_EQ(library.GetSize(), 3);
+  EXPECT_EQ(library.GetName(0), "area");
+  EXPECT_EQ(library.GetName(1), "constant");
+  EXPECT_EQ(library.GetName(2), "wave");
+  EXPECT_EQ(library.Find("wave"), 2);
+  EXPECT_EQ(library.Find("missing"), ProgramLibrary::kNotFound);
+  EXPECT_EQ(library.GetVariables(0),
+            (std::vector<std::string_view>{"w", "h"}));
+
+  Program wave = MathCalc::Compile("sin(x) * x + sin(x) ^ 2");
+  ProgramView view = library.GetProgram(library.Find("wave"));
+  for (double x : {-3.0, 0.0, 0.5, 10.0}) {
+    EXPECT_EQ(MathCalc::Calculate(view, x), MathCalc::Calculate(wave, x));
+  }
+  EXPECT_EQ(MathCalc::Calculate(library.GetProgram(0), {3.0, 4.0}), 6.0);
+  EXPECT_EQ(MathCalc::Calculate(library.GetProgram(1), 0.0), 1024.0);
+
+  auto [x, y] = MathCalc::Calculate(view, -5.0, 5.0, 1001, 2);
+  std::vector<double> vector_y(x.size());
+  VectorEvaluator::Evaluate(view, x.data(), vector_y.data(), x.size());
+  EXPECT_EQ(y, MathCalc::Calculate(wave, -5.0, 5.0, 1001).second);
+  EXPECT_EQ(vector_y, y);
+
+  Program loaded = library.Load(0);
+  EXPECT_EQ(loaded.variables, (std::vector<std::string>{"w", "h"}));
+  EXPECT_EQ(loaded.depth, library.GetProgram(0).depth);
+  EXPECT_EQ(MathCalc::Calculate(loaded, {1.0, 8.0}), 4.0);
+  EXPECT_THROW(library.GetProgram(3), std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST(ProgramLibraryTest, ManyPrograms) {
+  std::string path = TempPath("many");
+  ProgramLibrary::Builder builder;
+  for (int i = 0; i < 2000; ++i) {
+    builder.Add("f" + std::to_string(i),
+                std::to_string(i) + " * x + sqrt(x + " + std::to_string(i) +
+                    ")");
+  }
+  builder.Write(path);
+  std::vector<char> first = ReadFile(path);
+  builder.Write(path);
+  EXPECT_EQ(ReadFile(path), first);
+
+  ProgramLibrary library(path);
+  ASSERT_EQ(library.GetSize(), 2000);
+  for (int i = 0; i < 2000; i += 37) {
+    std::size_t index = library.Find("f" + std::to_string(i));
+    ASSERT_NE(index, ProgramLibrary::kNotFound);
+    EXPECT_DOUBLE_EQ(MathCalc::Calculate(library.GetProgram(index), 2.0),
+                     i * 2.0 + std::sqrt(2.0 + i));
+  }
+  std::remove(path.c_str());
+}
+
+TEST(ProgramLibraryTest, Invalid) {
+  std::string path = TempPath("invalid");
+  EXPECT_THROW(ProgramLibrary(path + ".missing"), std::runtime_error);
+
+  ProgramLibrary::Builder duplicate;
+  duplicate.Add("f", "x");
+  duplicate.Add("f", "2x");
+  EXPECT_THROW(duplicate.Write(path), std::invalid_argument);
+  EXPECT_THROW(duplicate.Add("g", "2 +"), std::logic_error);
+
+  ProgramLibrary::Builder builder;
+  builder.Add("f", "sin(x) + cos(x) * 2");
+  builder.Write(path);
+  std::vector<char> bytes = ReadFile(path);
+
+  std::vector<char> truncated(bytes.begin(), bytes.end() - 1);
+  WriteFile(path, truncated);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  std::vector<char> magic = bytes;
+  magic[0] ^= 1;
+  WriteFile(path, magic);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  std::vector<char> version = bytes;
+  version[4] = 2;
+  WriteFile(path, version);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  WriteFile(path, bytes);
+  EXPECT_NO_THROW(ProgramLibrary{path});
+  std::uint64_t code;
+  std::memcpy(&code, &bytes[48], sizeof(code));
+  ASSERT_EQ(static_cast<OpCode>(bytes[code]), OpCode::kVariable);
+
+  std::vector<char> opcode = bytes;
+  opcode[code] = 100;
+  WriteFile(path, opcode);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  std::vector<char> operand = bytes;
+  operand[code] = static_cast<char>(OpCode::kAdd);
+  WriteFile(path, operand);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  std::vector<char> slot = bytes;
+  double value = 3.0;
+  std::memcpy(&slot[code + 8], &value, sizeof(value));
+  WriteFile(path, slot);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  ProgramLibrary::Builder polynomial;
+  polynomial.Add("p", "x ^ 2 + x + 1");
+  polynomial.Write(path);
+  bytes = ReadFile(path);
+  EXPECT_NO_THROW(ProgramLibrary{path});
+  std::memcpy(&code, &bytes[48], sizeof(code));
+  ASSERT_EQ(static_cast<OpCode>(bytes[code + 16]), OpCode::kPolynomial);
+
+  std::vector<char> degree = bytes;
+  std::memcpy(&degree[code + 24], &value, sizeof(value));
+  WriteFile(path, degree);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+
+  std::vector<char> coefficient = bytes;
+  coefficient[code + 16] = static_cast<char>(OpCode::kCoefficient);
+  WriteFile(path, coefficient);
+  EXPECT_THROW(ProgramLibrary{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
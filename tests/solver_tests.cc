@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "math_calc.h"
+#include "solver.h"
+
+using namespace s21;
+
+namespace {
+Solver::Result Solve(const std::string& expression,
+                     Solver::Options options = {}) {
+  return Solver::Solve(MathCalc::Compile(expression), options);
+}
+}  // namespace
+
+TEST(SolverTest, Roots) {
+  Solver::Result result = Solve("sin(x)");
+  ASSERT_EQ(result.roots.size(), 7);
+  for (std::size_t i = 0; i < result.roots.size(); ++i) {
+    EXPECT_NEAR(result.roots[i], (static_cast<double>(i) - 3) * M_PI, 1e-14);
+  }
+
+  result = Solve("x ^ 3 - 2x - 5");
+  ASSERT_EQ(result.roots.size(), 1);
+  EXPECT_NEAR(result.roots[0], 2.0945514815423265, 1e-14);
+
+  result = Solve("2 ^ x - 3");
+  ASSERT_EQ(result.roots.size(), 1);
+  EXPECT_NEAR(result.roots[0], std::log2(3.0), 1e-14);
+}
+
+TEST(SolverTest, Extrema) {
+  Solver::Result result = Solve("x ^ 3 - 3x");
+  ASSERT_EQ(result.extrema.size(), 2);
+  EXPECT_NEAR(result.extrema[0].x, -1.0, 1e-14);
+  EXPECT_NEAR(result.extrema[0].y, 2.0, 1e-14);
+  EXPECT_TRUE(result.extrema[0].maximum);
+  EXPECT_NEAR(result.extrema[1].x, 1.0, 1e-14);
+  EXPECT_FALSE(result.extrema[1].maximum);
+
+  result = Solve("x ^ x", {0.05, 3.0});
+  ASSERT_EQ(result.extrema.size(), 1);
+  EXPECT_NEAR(result.extrema[0].x, std::exp(-1.0), 1e-14);
+
+  EXPECT_TRUE(Solve("sin(x) ^ 2 + cos(x) ^ 2").extrema.empty());
+}
+
+TEST(SolverTest, Multiplicity) {
+  Solver::Result result = Solve("cos(x) + 1");
+  ASSERT_EQ(result.roots.size(), 4);
+  EXPECT_NEAR(result.roots[2], M_PI, 1e-7);
+
+  result = Solve("((x - 0.5) ^ 2 - 1e-6) * ((x - 0.503) ^ 2 - 1e-6)");
+  ASSERT_EQ(result.roots.size(), 4);
+  EXPECT_NEAR(result.roots[0], 0.499, 1e-14);
+  EXPECT_NEAR(result.roots[1], 0.501, 1e-14);
+  EXPECT_NEAR(result.roots[2], 0.502, 1e-14);
+  EXPECT_NEAR(result.roots[3], 0.504, 1e-14);
+}
+
+TEST(SolverTest, Discontinuities) {
+  Solver::Result result = Solve("1 / x");
+  EXPECT_TRUE(result.roots.empty());
+  EXPECT_TRUE(result.extrema.empty());
+
+  result = Solve("tan(x)");
+  EXPECT_EQ(result.roots.size(), 7);
+  EXPECT_TRUE(result.extrema.empty());
+
+  result = Solve("x mod 3 - 1");
+  EXPECT_EQ(result.roots, std::vector<double>({1.0, 4.0, 7.0, 10.0}));
+
+  result = Solve("sqrt(x) - 1");
+  ASSERT_EQ(result.roots.size(), 1);
+  EXPECT_NEAR(result.roots[0], 1.0, 1e-14);
+
+  EXPECT_THROW(Solve("x", {1.0, -1.0}), std::logic_error);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "math_calc.h"
+#include "thread_pool.h"
+
+using namespace s21;
+
+TEST(ThreadPoolTest, EveryIterationOnce) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.Size(), 4);
+  for (std::size_t threads : {0, 1, 2, 3, 4, 16}) {
+    for (std::size_t count : {0, 1, 3, 4, 1000}) {
+      std::vector<std::atomic<int>> visits(count);
+      pool.ParallelFor(
+          count, [&](std::size_t i) { ++visits[i]; }, threads);
+      for (std::size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(visits[i], 1) << "threads = " << threads << ", i = " << i;
+      }
+    }
+  }
+}
+
+TEST(ThreadPoolTest, UnevenIterations) {
+  ThreadPool pool(3);
+  std::vector<double> result(64);
+  pool.ParallelFor(result.size(), [&](std::size_t i) {
+    double sum = 0.0;
+    for (std::size_t j = 0; j < (i < 8 ? 200000 : 10); ++j) {
+      sum += std::sqrt(static_cast<double>(j));
+    }
+    result[i] = sum;
+  });
+  for (std::size_t i = 0; i < result.size(); ++i) {
+    EXPECT_GT(result[i], 0.0);
+  }
+}
+
+TEST(ThreadPoolTest, ConcurrentLoops) {
+  ThreadPool pool(3);
+  std::atomic<int> total{0};
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&] {
+      for (int j = 0; j < 20; ++j) {
+        pool.ParallelFor(50, [&](std::size_t) { ++total; });
+      }
+    });
+  }
+  for (std::thread& caller : callers) {
+    caller.join();
+  }
+  EXPECT_EQ(total, 4 * 20 * 50);
+}
+
+TEST(ThreadPoolTest, Exception) {
+  ThreadPool pool(2);
+  std::atomic<int> visited{0};
+  EXPECT_THROW(pool.ParallelFor(100,
+                                [&](std::size_t i) {
+                                  ++visited;
+                                  if (i == 42) {
+                                    throw std::runtime_error("42");
+                                  }
+                                }),
+               std::runtime_error);
+  EXPECT_EQ(visited, 100);
+  pool.ParallelFor(10, [&](std::size_t) { ++visited; });
+  EXPECT_EQ(visited, 110);
+}
+
+TEST(ThreadPoolTest, ParallelRange) {
+  const std::string expression = "sin(x) * x ^ 2 - ln(x) mod 3 + atan(x)";
+  auto [x, y] = MathCalc::Calculate(expression, 0.5, 1000.0, 100003);
+  for (std::size_t threads : {0, 2, 3, 8}) {
+    auto [x_parallel, y_parallel] =
+        MathCalc::Calculate(expression, 0.5, 1000.0, 100003, threads);
+    ASSERT_EQ(x_parallel, x);
+    ASSERT_EQ(y_parallel.size(), y.size());
+    EXPECT_EQ(std::memcmp(y_parallel.data(), y.data(),
+                          y.size() * sizeof(double)),
+              0);
+  }
+}
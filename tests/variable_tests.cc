@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "math_calc.h"
+#include "program_cache.h"
+
+using namespace s21;
+
+TEST(VariableTableTest, Slots) {
+  VariableTable table;
+  EXPECT_EQ(table.GetSize(), 1);
+  EXPECT_EQ(table.Find("x"), 0);
+
+  VariableTable variables = {"rate", "t", "notional"};
+  EXPECT_EQ(variables.Find("rate"), 0);
+  EXPECT_EQ(variables.Find("notional"), 2);
+  EXPECT_EQ(variables.Find("x"), VariableTable::kNotFound);
+  EXPECT_EQ(variables.Add("spot_price"), 3);
+  EXPECT_EQ(variables.GetNames().back(), "spot_price");
+
+  EXPECT_THROW(variables.Add("t"), std::logic_error);
+  EXPECT_THROW(variables.Add(""), std::logic_error);
+  EXPECT_THROW(variables.Add("_a"), std::logic_error);
+  EXPECT_THROW(variables.Add("x1"), std::logic_error);
+}
+
+TEST(VariableTableTest, Compile) {
+  VariableTable variables = {"x", "y", "t"};
+  Program program = MathCalc::Compile("x * y + 2t - sin(y)", variables);
+  EXPECT_EQ(program.variables, variables.GetNames());
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(program, {1.5, -2.0, 4.0}),
+                   1.5 * -2.0 + 2 * 4.0 - std::sin(-2.0));
+
+  program = MathCalc::Compile("2xy(t mod x)", variables);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(program, {3.0, 5.0, 7.0}),
+                   2 * 3.0 * 5.0 * std::fmod(7.0, 3.0));
+
+  program = MathCalc::Compile("ycos(t)", variables);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(program, {0.0, 2.0, 0.5}),
+                   2.0 * std::cos(0.5));
+
+  EXPECT_THROW(MathCalc::Calculate(program, {1.0, 2.0}), std::logic_error);
+  EXPECT_THROW(MathCalc::Calculate(program, 1.0), std::logic_error);
+}
+
+TEST(VariableTableTest, LongestMatch) {
+  VariableTable variables = {"a", "ab", "b"};
+  Program program = MathCalc::Compile("ab + aab + ba", variables);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(program, {2.0, 10.0, 3.0}),
+                   10.0 + 2.0 * 10.0 + 3.0 * 2.0);
+}
+
+TEST(VariableTableTest, Errors) {
+  VariableTable variables = {"x", "y"};
+  EXPECT_THROW(MathCalc::Compile("x + z", variables), std::logic_error);
+  EXPECT_THROW(MathCalc::Compile("x + y"), std::logic_error);
+  EXPECT_THROW(MathCalc::Compile("x y", variables), std::logic_error);
+  EXPECT_THROW(MathCalc::Compile("2 y", variables), std::logic_error);
+  EXPECT_THROW(MathCalc::Compile("siny", variables), std::logic_error);
+  EXPECT_NO_THROW(MathCalc::Compile("x sin(y)", variables));
+  EXPECT_THROW(MathCalc::Compile("x", {"x", "sin"}), std::logic_error);
+  EXPECT_THROW(MathCalc::Compile("x", {"x", "mod"}), std::logic_error);
+}
+
+TEST(VariableTableTest, Columns) {
+  VariableTable variables = {"notional", "rate", "t"};
+  Program program = MathCalc::Compile(
+      "notional * (1 + rate) ^ t - notional * sqrt(t) mod 3", variables);
+
+  std::mt19937_64 generator(17);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+  std::size_t size = 10007;
+  std::vector<std::vector<double>> table(3, std::vector<double>(size));
+  for (std::vector<double>& column : table) {
+    for (double& value : column) {
+      value = distribution(generator);
+    }
+  }
+  const double* columns[] = {table[0].data(), table[1].data(),
+                             table[2].data()};
+
+  std::vector<double> y(size), parallel(size);
+  MathCalc::Calculate(program, columns, y.data(), size);
+  MathCalc::Calculate(program, columns, parallel.data(), size, 4);
+  for (std::size_t i = 0; i < size; ++i) {
+    double expected =
+        MathCalc::Calculate(program, {table[0][i], table[1][i], table[2][i]});
+    ASSERT_NEAR(y[i], expected, std::abs(expected) * 1e-14) << i;
+    ASSERT_EQ(y[i], parallel[i]) << i;
+  }
+}
+
+TEST(VariableTableTest, Cache) {
+  ProgramCache cache(8);
+  auto first = cache.Get("x + y", {"x", "y"});
+  auto second = cache.Get("x + y", {"y", "x"});
+  EXPECT_NE(first, second);
+  EXPECT_EQ(cache.Get("x+y", {"x", "y"}), first);
+  EXPECT_DOUBLE_EQ(MathCalc::Calculate(*first, {1.0, 10.0}), 11.0);
+  EXPECT_THROW(cache.Get("x + y"), std::logic_error);
+}
@@ -0,0 +1,348 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "math_calc.h"
+#include "vector_evaluator.h"
+
+using namespace s21;
+
+namespace {
+using Isa = VectorEvaluator::Isa;
+
+const Isa kIsas[] = {Isa::kSse2, Isa::kAvx2, Isa::kAvx512};
+
+Program MakeProgram(std::vector<Instruction> code, std::size_t depth) {
+  Program program;
+  program.code = std::move(code);
+  program.depth = depth;
+  return program;
+}
+
+std::int64_t OrderedBits(double value) {
+  std::int64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits < 0 ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+}
+
+std::uint64_t UlpDistance(double a, double b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b)
+               ? 0
+               : std::numeric_limits<std::uint64_t>::max();
+  }
+  std::int64_t x = OrderedBits(a);
+  std::int64_t y = OrderedBits(b);
+  return x > y ? static_cast<std::uint64_t>(x) - y
+               : static_cast<std::uint64_t>(y) - x;
+}
+
+std::vector<double> RandomValues(double min, double max, std::size_t size) {
+  static std::mt19937_64 generator(21);
+  std::uniform_real_distribution<double> distribution(min, max);
+  std::vector<double> values(size);
+  for (double& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+std::vector<double> SpecialValues() {
+  double inf = std::numeric_limits<double>::infinity();
+  return {0.0,    -0.0,    1.0,    -1.0,   0.5,    -0.5,     2.0,
+          1e-310, -1e-310, 1e300,  -1e300, 1e7,    -1e7,     inf,
+          -inf,   NAN,     1.0001, 0.9999, M_PI_2, -M_PI_2,  M_PI,
+          3.0,    -3.0,    100.0,  -100.0, 1e-20,  709.7827, -745.1};
+}
+
+void ExpectWithinUlp(const Program& program, const std::vector<double>& x,
+                     double (*expected)(double), std::uint64_t bound) {
+  std::vector<double> y(x.size());
+  for (Isa isa : kIsas) {
+    if (!VectorEvaluator::IsSupported(isa)) {
+      continue;
+    }
+    VectorEvaluator::Evaluate(program, x.data(), y.data(), x.size(), isa);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      ASSERT_LE(UlpDistance(y[i], expected(x[i])), bound)
+          << "x = " << x[i] << ", isa = " << static_cast<int>(isa);
+    }
+  }
+}
+
+std::int32_t OrderedBits(float value) {
+  std::int32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits < 0 ? std::numeric_limits<std::int32_t>::min() - bits : bits;
+}
+
+std::uint32_t UlpDistance(float a, float b) {
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b)
+               ? 0
+               : std::numeric_limits<std::uint32_t>::max();
+  }
+  std::int64_t x = OrderedBits(a);
+  std::int64_t y = OrderedBits(b);
+  return static_cast<std::uint32_t>(x > y ? x - y : y - x);
+}
+
+std::vector<float> SpecialFloats() {
+  float inf = std::numeric_limits<float>::infinity();
+  return {0.0f,    -0.0f,   1.0f,    -1.0f,   0.5f,    -0.5f,   2.0f,
+          1e-40f,  -1e-40f, 1e30f,   -1e30f,  1e7f,    -1e7f,   inf,
+          -inf,    NAN,     1.0001f, 0.9999f, 1.5708f, 3.0f,    -3.0f,
+          100.0f,  1e-20f,  88.7f,   -103.9f, 4096.0f, 5000.0f};
+}
+
+void ExpectFloatWithinUlp(const Program& program, const std::vector<float>& x,
+                          double (*expected)(double), std::uint32_t bound) {
+  std::vector<float> y(x.size());
+  for (Isa isa : kIsas) {
+    if (!VectorEvaluator::IsSupported(isa)) {
+      continue;
+    }
+    VectorEvaluator::Evaluate(program, x.data(), y.data(), x.size(), isa);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      float reference = static_cast<float>(expected(x[i]));
+      ASSERT_LE(UlpDistance(y[i], reference), bound)
+          << "x = " << x[i] << ", isa = " << static_cast<int>(isa);
+    }
+  }
+}
+
+void ExpectFloatFunction(OpCode op, double min, double max,
+                         double (*expected)(double), std::uint32_t bound) {
+  Program program = MakeProgram({{OpCode::kVariable, 0.0}, {op, 0.0}}, 1);
+  std::vector<double> values = RandomValues(min, max, 4099);
+  std::vector<float> x(values.begin(), values.end());
+  ExpectFloatWithinUlp(program, x, expected, bound);
+  ExpectFloatWithinUlp(program, SpecialFloats(), expected, bound);
+}
+
+void ExpectFunction(OpCode op, double min, double max,
+                    double (*expected)(double), std::uint64_t bound) {
+  Program program = MakeProgram({{OpCode::kVariable, 0.0}, {op, 0.0}}, 1);
+  ExpectWithinUlp(program, RandomValues(min, max, 4099), expected, bound);
+  ExpectWithinUlp(program, SpecialValues(), expected, bound);
+}
+}  // namespace
+
+TEST(VectorEvaluatorTest, Trigonometric) {
+  auto sin = [](double x) { return std::sin(x); };
+  auto cos = [](double x) { return std::cos(x); };
+  auto tan = [](double x) { return std::tan(x); };
+  ExpectFunction(OpCode::kSin, -10.0, 10.0, sin, 2);
+  ExpectFunction(OpCode::kSin, -1e6, 1e6, sin, 2);
+  ExpectFunction(OpCode::kCos, -10.0, 10.0, cos, 2);
+  ExpectFunction(OpCode::kCos, -1e6, 1e6, cos, 2);
+  ExpectFunction(OpCode::kTan, -3.0, 3.0, tan, 4);
+  ExpectFunction(OpCode::kTan, -1e6, 1e6, tan, 4);
+}
+
+TEST(VectorEvaluatorTest, InverseTrigonometric) {
+  auto asin = [](double x) { return std::asin(x); };
+  auto acos = [](double x) { return std::acos(x); };
+  auto atan = [](double x) { return std::atan(x); };
+  ExpectFunction(OpCode::kAsin, -1.0, 1.0, asin, 3);
+  ExpectFunction(OpCode::kAcos, -1.0, 1.0, acos, 3);
+  ExpectFunction(OpCode::kAtan, -1.0, 1.0, atan, 2);
+  ExpectFunction(OpCode::kAtan, -1e3, 1e3, atan, 2);
+}
+
+TEST(VectorEvaluatorTest, Logarithmic) {
+  auto sqrt = [](double x) { return std::sqrt(x); };
+  auto ln = [](double x) { return std::log(x); };
+  auto log = [](double x) { return std::log10(x); };
+  ExpectFunction(OpCode::kSqrt, 0.0, 1e6, sqrt, 0);
+  ExpectFunction(OpCode::kLn, 0.0, 1e6, ln, 1);
+  ExpectFunction(OpCode::kLn, 0.9, 1.1, ln, 1);
+  ExpectFunction(OpCode::kLog, 0.0, 1e6, log, 2);
+  ExpectFunction(OpCode::kLog, 0.9, 1.1, log, 2);
+}
+
+TEST(VectorEvaluatorTest, PowerAndModulus) {
+  std::vector<double> x = RandomValues(0.0, 20.0, 4099);
+  std::vector<double> special = SpecialValues();
+  x.insert(x.end(), special.begin(), special.end());
+  std::vector<double> y(x.size());
+
+  for (double c : {-3.7, -2.0, -0.5, 0.5, 2.5, 3.0, 7.3, 30.1}) {
+    Program power = MakeProgram(
+        {{OpCode::kVariable, 0.0}, {OpCode::kNumber, c}, {OpCode::kPow, 0.0}},
+        2);
+    Program exponential = MakeProgram(
+        {{OpCode::kNumber, c}, {OpCode::kVariable, 0.0}, {OpCode::kPow, 0.0}},
+        2);
+    Program modulus = MakeProgram(
+        {{OpCode::kVariable, 0.0}, {OpCode::kNumber, c}, {OpCode::kMod, 0.0}},
+        2);
+    for (Isa isa : kIsas) {
+      if (!VectorEvaluator::IsSupported(isa)) {
+        continue;
+      }
+      VectorEvaluator::Evaluate(power, x.data(), y.data(), x.size(), isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_LE(UlpDistance(y[i], std::pow(x[i], c)), 2) << x[i] << "^" << c;
+      }
+      VectorEvaluator::Evaluate(exponential, x.data(), y.data(), x.size(),
+                                isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_LE(UlpDistance(y[i], std::pow(c, x[i])), 2) << c << "^" << x[i];
+      }
+      VectorEvaluator::Evaluate(modulus, x.data(), y.data(), x.size(), isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(UlpDistance(y[i], std::fmod(x[i], c)), 0)
+            << x[i] << " mod " << c;
+      }
+    }
+  }
+}
+
+TEST(VectorEvaluatorTest, IdenticalAcrossIsas) {
+  std::vector<double> x = RandomValues(-50.0, 50.0, 1001);
+  Program program = MakeProgram({{OpCode::kVariable, 0.0},
+                                 {OpCode::kSin, 0.0},
+                                 {OpCode::kVariable, 0.0},
+                                 {OpCode::kPowInt, 3.0},
+                                 {OpCode::kMul, 0.0},
+                                 {OpCode::kVariable, 0.0},
+                                 {OpCode::kAtan, 0.0},
+                                 {OpCode::kNumber, 2.0},
+                                 {OpCode::kMod, 0.0},
+                                 {OpCode::kNegate, 0.0},
+                                 {OpCode::kSub, 0.0}},
+                                3);
+  std::vector<double> expected(x.size());
+  VectorEvaluator::Evaluate(program, x.data(), expected.data(), x.size(),
+                            Isa::kSse2);
+
+  for (Isa isa : kIsas) {
+    if (!VectorEvaluator::IsSupported(isa)) {
+      continue;
+    }
+    for (std::size_t size : {std::size_t{1}, std::size_t{7}, x.size()}) {
+      std::vector<double> y(x.size());
+      for (std::size_t i = 0; i < x.size(); i += size) {
+        std::size_t count = std::min(size, x.size() - i);
+        VectorEvaluator::Evaluate(program, x.data() + i, y.data() + i, count,
+                                  isa);
+      }
+      EXPECT_EQ(std::memcmp(y.data(), expected.data(),
+                            y.size() * sizeof(double)),
+                0);
+    }
+  }
+}
+
+TEST(VectorEvaluatorTest, Range) {
+  const std::string expression = "sin(x) * x ^ 2 - log(x) + sqrt(x) / tan(x)";
+  auto [x, y] = MathCalc::Calculate(expression, 0.5, 100.0, 1000);
+  MathCalc calc(expression);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(y[i], calc.Calculate(x[i]), 1e-12 * std::abs(y[i]));
+  }
+}
+
+TEST(VectorEvaluatorTest, SharedSubexpressions) {
+  Program program =
+      MathCalc::Compile("sin(x) * sin(x) + sin(x) / (1 + cos(x) ^ 2) - cos(x)");
+  std::vector<double> x = RandomValues(-10.0, 10.0, 1027);
+  std::vector<double> y(x.size());
+  for (Isa isa : kIsas) {
+    if (!VectorEvaluator::IsSupported(isa)) {
+      continue;
+    }
+    VectorEvaluator::Evaluate(program, x.data(), y.data(), x.size(), isa);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      double expected = MathCalc::Calculate(program, x[i]);
+      ASSERT_NEAR(y[i], expected, 1e-14 * std::max(1.0, std::abs(expected)))
+          << "x = " << x[i] << ", isa = " << static_cast<int>(isa);
+    }
+  }
+}
+
+TEST(VectorEvaluatorTest, Polynomials) {
+  std::vector<double> x = RandomValues(-3.0, 3.0, 1027);
+  std::vector<float> x_single(x.begin(), x.end());
+  for (const char* expression :
+       {"3x ^ 4 - 2x ^ 3 + x - 7", "(x ^ 2 + 1) / (x ^ 2 - 1)",
+        "(x ^ 16 - x) / (-x ^ 5 / 120 + x ^ 3 / 6 + x)"}) {
+    Program program = MathCalc::Compile(expression);
+    ASSERT_EQ(program.code[1].op, OpCode::kPolynomial) << expression;
+    std::vector<double> y(x.size());
+    std::vector<float> y_single(x.size());
+    for (Isa isa : kIsas) {
+      if (!VectorEvaluator::IsSupported(isa)) {
+        continue;
+      }
+      VectorEvaluator::Evaluate(program, x.data(), y.data(), x.size(), isa);
+      VectorEvaluator::Evaluate(program, x_single.data(), y_single.data(),
+                                x.size(), isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(y[i], MathCalc::Calculate(program, x[i]))
+            << expression << ", x = " << x[i];
+        ASSERT_EQ(y_single[i], MathCalc::Evaluate(program, x_single[i]))
+            << expression << ", x = " << x[i];
+      }
+    }
+  }
+}
+
+TEST(VectorEvaluatorTest, SinglePrecision) {
+  auto sin = [](double x) { return std::sin(x); };
+  auto cos = [](double x) { return std::cos(x); };
+  auto tan = [](double x) { return std::tan(x); };
+  auto asin = [](double x) { return std::asin(x); };
+  auto acos = [](double x) { return std::acos(x); };
+  auto atan = [](double x) { return std::atan(x); };
+  auto sqrt = [](double x) { return std::sqrt(x); };
+  auto ln = [](double x) { return std::log(x); };
+  auto log = [](double x) { return std::log10(x); };
+  ExpectFloatFunction(OpCode::kSin, -10.0, 10.0, sin, 2);
+  ExpectFloatFunction(OpCode::kSin, -4000.0, 4000.0, sin, 2);
+  ExpectFloatFunction(OpCode::kCos, -10.0, 10.0, cos, 2);
+  ExpectFloatFunction(OpCode::kTan, -3.0, 3.0, tan, 4);
+  ExpectFloatFunction(OpCode::kAsin, -1.0, 1.0, asin, 3);
+  ExpectFloatFunction(OpCode::kAcos, -1.0, 1.0, acos, 3);
+  ExpectFloatFunction(OpCode::kAtan, -1e3, 1e3, atan, 2);
+  ExpectFloatFunction(OpCode::kSqrt, 0.0, 1e6, sqrt, 0);
+  ExpectFloatFunction(OpCode::kLn, 0.0, 1e6, ln, 1);
+  ExpectFloatFunction(OpCode::kLn, 0.9, 1.1, ln, 1);
+  ExpectFloatFunction(OpCode::kLog, 0.0, 1e6, log, 2);
+}
+
+TEST(VectorEvaluatorTest, SinglePrecisionPowerAndModulus) {
+  std::vector<double> values = RandomValues(0.0, 20.0, 4099);
+  std::vector<float> x(values.begin(), values.end());
+  std::vector<float> special = SpecialFloats();
+  x.insert(x.end(), special.begin(), special.end());
+  std::vector<float> y(x.size());
+
+  for (float c : {-3.7f, -2.0f, -0.5f, 0.5f, 2.5f, 3.0f, 7.3f, 30.1f}) {
+    Program power = MakeProgram(
+        {{OpCode::kVariable, 0.0}, {OpCode::kNumber, c}, {OpCode::kPow, 0.0}},
+        2);
+    Program modulus = MakeProgram(
+        {{OpCode::kVariable, 0.0}, {OpCode::kNumber, c}, {OpCode::kMod, 0.0}},
+        2);
+    for (Isa isa : kIsas) {
+      if (!VectorEvaluator::IsSupported(isa)) {
+        continue;
+      }
+      VectorEvaluator::Evaluate(power, x.data(), y.data(), x.size(), isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        float expected = static_cast<float>(std::pow(double{x[i]}, c));
+        ASSERT_LE(UlpDistance(y[i], expected), 2u) << x[i] << "^" << c;
+      }
+      VectorEvaluator::Evaluate(modulus, x.data(), y.data(), x.size(), isa);
+      for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(UlpDistance(y[i], std::fmod(x[i], c)), 0u)
+            << x[i] << " mod " << c;
+      }
+    }
+  }
+}
@@ -33,6 +33,8 @@ void View::SetupUi() {
   connect(ui_->btn_plot, &QPushButton::clicked, this, [this]() { Plot(); });
   connect(ui_->btn_run_credit, &QPushButton::clicked, this,
           [this]() { RunCredit(); });
+  connect(ui_->x_value, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+          this, [this]() { Preview(); });
   connect(ui_->check_cap, &QCheckBox::stateChanged,
           [=](int state) { ui_->cb_cap->setEnabled(state == Qt::Checked); });
 }
@@ -57,6 +59,11 @@ void View::PressButton() {
     QString text = Validator::Validate(ui_->display->text(), button->text());
     ui_->display->setText(text);
     ui_->display_graph->setText(text);
+    if (text == "0") {
+      ResetUi();
+    } else {
+      Preview();
+    }
   }
 }
 
@@ -76,13 +83,7 @@ void View::PressEqual() {
     qreal result = Controller::Calculate(ui_->display->text().toStdString(),
                                          ui_->x_value->value());
 
-    if (fabs(result) < 1e-6 || fabs(result) > 1e10) {
-      std::stringstream ss;
-      ss << result << std::scientific;
-      ui_->display_res->setText("=" + QString::fromStdString(ss.str()));
-    } else {
-      ui_->display_res->setText("=" + QString::number(result, 'f', 6));
-    }
+    ui_->display_res->setText("=" + FormatResult(result));
     ui_->display_input->setText(ui_->display->text());
     style.replace("color: #ff4a50;", "color: #43eb99;");
     style.replace("font: 22px;", "font: 26px;");
@@ -99,6 +100,27 @@ void View::PressEqual() {
   }
 }
 
+void View::Preview() {
+  QString text = ui_->display->text();
+  if (text == "0") {
+    return;
+  }
+  Error error;
+  qreal result = Controller::Preview(parser_, text.toStdString(),
+                                     ui_->x_value->value(), error);
+  ui_->display_res->setText(error.IsOk() ? "=" + FormatResult(result)
+                                          : QString());
+}
+
+QString View::FormatResult(qreal result) {
+  if (fabs(result) < 1e-6 || fabs(result) > 1e10) {
+    std::stringstream ss;
+    ss << result << std::scientific;
+    return QString::fromStdString(ss.str());
+  }
+  return QString::number(result, 'f', 6);
+}
+
 void View::SetupChart() {
   chart_ = new Chart(SetupAxis("x"), SetupAxis("y"));
   ui_->chart_field->layout()->addWidget(chart_);
@@ -135,22 +157,28 @@ void View::Plot() {
   chart_->SetRangeX(ui_->x_min->value(), ui_->x_max->value());
   chart_->SetRangeY(ui_->y_min->value(), ui_->y_max->value());
 
-  QLineSeries *series = new QLineSeries();
-  QString style = ui_->display_graph->styleSheet();
+  AdaptiveSampler::Options options;
+  options.x_min = ui_->x_min->value();
+  options.x_max = ui_->x_max->value();
+  options.y_min = ui_->y_min->value();
+  options.y_max = ui_->y_max->value();
+  options.width = chart_->width();
+  options.height = chart_->height();
+  options.budget = kNumPoints;
 
   try {
-    auto [x, y] = Controller::Calculate(
-        ui_->display_graph->text().toStdString(), ui_->x_min->value(),
-        ui_->x_max->value(), kNumPoints);
-
-    for (qsizetype i = 0; i < kNumPoints; ++i) {
-      series->append(x[i], y[i]);
+    AdaptiveSampler::Result result = Controller::Sample(
+        ui_->display_graph->text().toStdString(), options);
+
+    for (const AdaptiveSampler::Series &part : result.series) {
+      QLineSeries *series = new QLineSeries();
+      for (std::size_t i = 0; i < part.x.size(); ++i) {
+        series->append(part.x[i], part.y[i]);
+      }
+      series->setPen(QPen(QColor(61, 222, 183, 255), kLineWidth,
+                          Qt::SolidLine, Qt::RoundCap));
+      chart_->AddSeries(series);
     }
-
-    series->setPen(QPen(QColor(61, 222, 183, 255), kLineWidth, Qt::SolidLine,
-                        Qt::RoundCap));
-
-    chart_->AddSeries(series);
     ui_->display_res_graph->setText("");
   } catch (const std::exception &err) {
     ui_->display_res_graph->setText(err.what());
@@ -175,7 +203,9 @@ void View::RunCredit() {
 
   for (std::size_t i = 0; i < plan.dates.size(); ++i) {
     ui_->table_credit->setItem(
-        i, 0, new QTableWidgetItem(QString::fromStdString(plan.dates[i])));
+        i, 0,
+        new QTableWidgetItem(
+            QString::fromStdString(plan.dates[i].Format("%B %Y"))));
     ui_->table_credit->setItem(
         i, 1, new QTableWidgetItem(QString::number(plan.payments[i], 'f', 2)));
     ui_->table_credit->setItem(
@@ -188,29 +218,22 @@ void View::RunCredit() {
   }
   ui_->table_credit->resizeColumnToContents(0);
 
-  double total_interest =
-      std::accumulate(plan.interests.begin(), plan.interests.end(), 0.0);
-  double total_payment =
-      std::accumulate(plan.payments.begin(), plan.payments.end(), 0.0);
+  CreditCalc::Summary summary = Controller::Summarize(info);
 
   if (info.type == CreditCalc::CreditType::kAnnuity) {
-    double monthly_payment = plan.payments[0];
-
     ui_->lbl_monthly_payment->setText(
-        QString("Monthly payment: %1").arg(monthly_payment, 0, 'f', 2));
+        QString("Monthly payment: %1").arg(summary.first_payment, 0, 'f', 2));
   } else if (info.type == CreditCalc::CreditType::kDifferentiated) {
-    double first_payment = plan.payments.front();
-    double last_payment = plan.payments.back();
-
-    ui_->lbl_monthly_payment->setText(QString("Monthly payment:\n%1 ... %2")
-                                          .arg(first_payment, 0, 'f', 2)
-                                          .arg(last_payment, 0, 'f', 2));
+    ui_->lbl_monthly_payment->setText(
+        QString("Monthly payment:\n%1 ... %2")
+            .arg(summary.first_payment, 0, 'f', 2)
+            .arg(summary.last_payment, 0, 'f', 2));
   }
 
   ui_->lbl_total_interest->setText(
-      QString("Overpayment: %1").arg(total_interest, 0, 'f', 2));
+      QString("Overpayment: %1").arg(summary.total_interest, 0, 'f', 2));
   ui_->lbl_total_payment->setText(
-      QString("Total payment: %1").arg(total_payment, 0, 'f', 2));
+      QString("Total payment: %1").arg(summary.total_payment, 0, 'f', 2));
 }
 
 }  // namespace s21
@@ -28,6 +28,7 @@ class View : public QMainWindow {
 
   Ui::View* ui_;
   Chart* chart_;
+  IncrementalParser parser_;
 
   void SetupUi();
   void SetupChart();
@@ -35,6 +36,8 @@ class View : public QMainWindow {
   void PressButton();
   void PressClear();
   void PressEqual();
+  void Preview();
+  static QString FormatResult(qreal result);
 
   void Plot();
   QValueAxis* SetupAxis(const QString& name);